@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Back buffers for double-buffered chrome painting, kept alive between paints.
+//
+// Each painted control owns a slot. A slot's surface is allocated at a size
+// rounded up to BUCKET pixels, so it survives repaints and small resizes; it
+// is replaced only when the control outgrows it, shrinks far below it, or
+// moves to a different DPI. The surface type is left to the caller: the
+// browser stores a memory DC with a compatible bitmap selected.
+
+struct BackBufferStats {
+	uint64_t allocations = 0;
+	uint64_t reuses = 0;
+};
+
+template <typename Surface>
+class BackBufferPool {
+public:
+	static constexpr int BUCKET = 64;
+
+	BackBufferPool() = default;
+	BackBufferPool(const BackBufferPool&) = delete;
+	BackBufferPool& operator=(const BackBufferPool&) = delete;
+
+	static int BucketSize(int pixels) {
+		if (pixels < 1) pixels = 1;
+		return (pixels + BUCKET - 1) / BUCKET * BUCKET;
+	}
+
+	// Returns the slot's surface if it still fits width x height at dpi,
+	// else replaces it with create(bucketWidth, bucketHeight).
+	template <typename Create>
+	Surface& Acquire(size_t slot, int width, int height, uint32_t dpi, Create&& create) {
+		if (slot >= m_entries.size()) {
+			m_entries.resize(slot + 1);
+		}
+
+		Entry& entry = m_entries[slot];
+		int bucketWidth = BucketSize(width);
+		int bucketHeight = BucketSize(height);
+		bool fits = entry.valid && entry.dpi == dpi &&
+			entry.width >= bucketWidth && entry.height >= bucketHeight &&
+			// Let go of surfaces more than four times the area needed
+			static_cast<int64_t>(entry.width) * entry.height <= 4 * static_cast<int64_t>(bucketWidth) * bucketHeight;
+		if (fits) {
+			m_stats.reuses++;
+			return entry.surface;
+		}
+
+		entry.surface = Surface();  // Free the old surface before allocating
+		entry.surface = create(bucketWidth, bucketHeight);
+		entry.width = bucketWidth;
+		entry.height = bucketHeight;
+		entry.dpi = dpi;
+		entry.valid = true;
+		m_stats.allocations++;
+		return entry.surface;
+	}
+
+	void Release(size_t slot) {
+		if (slot < m_entries.size()) {
+			m_entries[slot] = Entry();
+		}
+	}
+
+	void Clear() { m_entries.clear(); }
+
+	const BackBufferStats& Stats() const { return m_stats; }
+
+private:
+	struct Entry {
+		Surface surface = Surface();
+		int width = 0;
+		int height = 0;
+		uint32_t dpi = 0;
+		bool valid = false;
+	};
+
+	std::vector<Entry> m_entries;
+	BackBufferStats m_stats;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Drawing surface for the browser chrome (toolbar, tab strip, URL bar).
+//
+// ChromePaint draws through this interface only, so the same painting code
+// runs against GDI on a window and against SoftwareCanvas in memory.
+// Colors use the COLORREF layout (0x00BBGGRR).
+
+struct ChromeRect {
+	int left = 0, top = 0, right = 0, bottom = 0;
+
+	int Width() const { return right - left; }
+	int Height() const { return bottom - top; }
+};
+
+class ChromeCanvas {
+public:
+	virtual ~ChromeCanvas() = default;
+
+	virtual void FillRect(const ChromeRect& rect, uint32_t color) = 0;
+
+	// One pixel outline with rounded corners, drawn inside rect
+	virtual void FrameRoundRect(const ChromeRect& rect, int radius, uint32_t color) = 0;
+
+	// Single line of text, vertically centered and clipped to rect
+	virtual void DrawTextLine(std::wstring_view text, const ChromeRect& rect, uint32_t color) = 0;
+
+	// Pixel size of toolbar icons on this canvas
+	virtual int IconSize() const = 0;
+
+	// Draws an icon (by command ID) with its top-left corner at x, y
+	virtual void DrawIcon(int iconId, int x, int y, uint32_t color) = 0;
+};
@@ -0,0 +1,45 @@
+#include "ChromeLayout.h"
+
+namespace ChromeLayout {
+
+	void Solve(const Band* bands, int count, int width, int height, ChromeRect* out) {
+		// Height taken by margins and fixed bands decides what the fill bands get
+		int used = 0;
+		int fillCount = 0;
+		for (int i = 0; i < count; i++) {
+			used += bands[i].marginTop + bands[i].marginBottom;
+			if (bands[i].height == FILL) {
+				fillCount++;
+			}
+			else {
+				used += bands[i].height;
+			}
+		}
+
+		int leftover = height > used ? height - used : 0;
+		int fillIndex = 0;
+		int y = 0;
+		for (int i = 0; i < count; i++) {
+			const Band& band = bands[i];
+			int bandHeight = band.height;
+			if (bandHeight == FILL) {
+				// Spread the remainder over the first fill bands
+				bandHeight = leftover / fillCount + (fillIndex < leftover % fillCount ? 1 : 0);
+				fillIndex++;
+			}
+
+			ChromeRect& rect = out[i];
+			rect.left = band.marginLeft;
+			rect.right = width - band.marginRight;
+			rect.top = y + band.marginTop;
+			rect.bottom = rect.top + bandHeight;
+
+			if (rect.right < rect.left) rect.right = rect.left;
+			if (rect.top > height) rect.top = height;
+			if (rect.bottom > height) rect.bottom = height;
+			if (rect.bottom < rect.top) rect.bottom = rect.top;
+
+			y += band.marginTop + bandHeight + band.marginBottom;
+		}
+	}
+}
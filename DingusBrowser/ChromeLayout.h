@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ChromeCanvas.h"
+
+// Window layout for the browser chrome.
+//
+// The chrome is described as a top-to-bottom stack of bands (toolbar, tabs,
+// URL bar, content), each with a height and margins. Solve turns that
+// description into every rect at once, so the caller can move all the
+// windows in a single batch instead of positioning them one by one.
+namespace ChromeLayout {
+
+	// Band height meaning "whatever is left over"
+	constexpr int FILL = -1;
+
+	struct Band {
+		int height = 0;
+		int marginLeft = 0, marginTop = 0, marginRight = 0, marginBottom = 0;
+	};
+
+	// Stacks count bands in a width x height client area and writes one rect
+	// per band to out. FILL bands share the leftover height evenly. Rects that
+	// don't fit are clamped to empty rather than inverted.
+	void Solve(const Band* bands, int count, int width, int height, ChromeRect* out);
+}
@@ -0,0 +1,53 @@
+#include "ChromePaint.h"
+
+namespace ChromePaint {
+
+	void UrlBar(ChromeCanvas& canvas, const ChromeRect& bounds, std::wstring_view text, const Theme& theme, const UiMetrics& metrics) {
+		canvas.FillRect(bounds, theme.background);
+		canvas.FrameRoundRect(bounds, metrics.urlBarRadius, theme.border);
+
+		ChromeRect textRect = bounds;
+		textRect.left += metrics.urlBarTextPadding;
+		textRect.right -= metrics.urlBarTextPadding;
+		canvas.DrawTextLine(text, textRect, theme.text);
+	}
+
+	void Tab(ChromeCanvas& canvas, const ChromeRect& rect, std::wstring_view label, bool selected, const Theme& theme, const UiMetrics& metrics) {
+		canvas.FillRect(rect, selected ? theme.activeTab : theme.inactiveTab);
+
+		if (selected) {
+			// Accent underline
+			ChromeRect underline = rect;
+			underline.top = underline.bottom - metrics.tabUnderline;
+			canvas.FillRect(underline, theme.accent);
+		}
+		else {
+			// Separator on the right edge
+			ChromeRect separator = { rect.right - 1, rect.top + metrics.tabSeparatorInset, rect.right, rect.bottom - metrics.tabSeparatorInset };
+			canvas.FillRect(separator, theme.border);
+		}
+
+		ChromeRect textRect = rect;
+		textRect.left += metrics.tabTextPadding;
+		textRect.right -= metrics.tabTextPadding;
+		canvas.DrawTextLine(label, textRect, theme.text);
+	}
+
+	void Toolbar(ChromeCanvas& canvas, const ToolbarModel& model, const ChromeRect& clip, const Theme& theme) {
+		canvas.FillRect(clip, theme.background);
+
+		ToolbarRect clipRect = { clip.left, clip.top, clip.right, clip.bottom };
+		int iconSize = canvas.IconSize();
+		for (int i = 0; i < model.Count(); i++) {
+			const ToolbarButton& button = model.At(i);
+			if (!button.rect.Intersects(clipRect)) {
+				continue;
+			}
+
+			const ToolbarRect& rect = button.rect;
+			int x = rect.left + (rect.right - rect.left - iconSize) / 2;
+			int y = rect.top + (rect.bottom - rect.top - iconSize) / 2;
+			canvas.DrawIcon(button.commandId, x, y, i == model.Hovered() ? theme.iconHover : theme.icon);
+		}
+	}
+}
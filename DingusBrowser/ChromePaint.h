@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "ChromeCanvas.h"
+#include "ToolbarModel.h"
+#include "UiMetrics.h"
+
+// Chrome painting, independent of the drawing backend.
+namespace ChromePaint {
+
+	struct Theme {
+		uint32_t background = 0xFFFFFF;
+		uint32_t accent = 0;
+		uint32_t text = 0;
+		uint32_t border = 0;
+		uint32_t activeTab = 0;
+		uint32_t inactiveTab = 0;
+		uint32_t icon = 0;
+		uint32_t iconHover = 0;
+	};
+
+	void UrlBar(ChromeCanvas& canvas, const ChromeRect& bounds, std::wstring_view text, const Theme& theme, const UiMetrics& metrics);
+
+	// One tab of the strip, with its label cut to fit
+	void Tab(ChromeCanvas& canvas, const ChromeRect& rect, std::wstring_view label, bool selected, const Theme& theme, const UiMetrics& metrics);
+
+	// Draws the toolbar buttons that overlap clip, after filling clip
+	void Toolbar(ChromeCanvas& canvas, const ToolbarModel& model, const ChromeRect& clip, const Theme& theme);
+}
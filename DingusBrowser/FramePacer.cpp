@@ -0,0 +1,45 @@
+#include "FramePacer.h"
+
+#include <utility>
+
+FramePacer::FramePacer(Clock clock, uint64_t frameInterval)
+	: m_clock(std::move(clock)), m_frameInterval(frameInterval) {
+}
+
+void FramePacer::Request(uint32_t work) {
+	m_pending |= work;
+	m_stats.requests++;
+}
+
+uint64_t FramePacer::TimeUntilDue() const {
+	if (!m_pending) {
+		return NOT_PENDING;
+	}
+	if (!m_hasFrame) {
+		return 0;
+	}
+	uint64_t elapsed = m_clock() - m_lastFrame;
+	return elapsed >= m_frameInterval ? 0 : m_frameInterval - elapsed;
+}
+
+uint32_t FramePacer::TakeDue() {
+	if (TimeUntilDue() != 0) {
+		return 0;
+	}
+	return StartFrame();
+}
+
+uint32_t FramePacer::Flush() {
+	m_stats.flushes++;
+	return StartFrame();
+}
+
+uint32_t FramePacer::StartFrame() {
+	uint32_t work = std::exchange(m_pending, 0);
+	if (work) {
+		m_lastFrame = m_clock();
+		m_hasFrame = true;
+		m_stats.frames++;
+	}
+	return work;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+// Coalesces repeated work to at most one run per display frame.
+//
+// Callers Request work bits as events arrive (every WM_SIZE of a drag, say)
+// and ask the pacer when the next frame is due. All work requested up to
+// then comes back together from TakeDue. Work that arrives after an idle
+// period is due immediately, so a single event is not delayed. Flush hands
+// back the pending work right away, for when the final state has to be
+// applied exactly. Time comes from an injected microsecond clock, so the
+// schedule can be driven by hand.
+
+struct FramePacerStats {
+	uint64_t requests = 0;
+	uint64_t frames = 0;
+	uint64_t flushes = 0;
+};
+
+class FramePacer {
+public:
+	using Clock = std::function<uint64_t()>;
+
+	static constexpr uint64_t NOT_PENDING = UINT64_MAX;
+
+	FramePacer(Clock clock, uint64_t frameInterval);
+
+	void SetFrameInterval(uint64_t frameInterval) { m_frameInterval = frameInterval; }
+	uint64_t FrameInterval() const { return m_frameInterval; }
+
+	void Request(uint32_t work);
+	uint32_t Pending() const { return m_pending; }
+
+	// Microseconds until the pending work may run; 0 if it is due now and
+	// NOT_PENDING if there is none
+	uint64_t TimeUntilDue() const;
+
+	// The pending work if it is due, otherwise 0. Taking work starts a frame.
+	uint32_t TakeDue();
+
+	// The pending work, due or not. Also starts a frame.
+	uint32_t Flush();
+
+	const FramePacerStats& Stats() const { return m_stats; }
+
+private:
+	uint32_t StartFrame();
+
+	Clock m_clock;
+	uint64_t m_frameInterval;
+	uint64_t m_lastFrame = 0;
+	bool m_hasFrame = false;
+	uint32_t m_pending = 0;
+	FramePacerStats m_stats;
+};
@@ -0,0 +1,78 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+	constexpr int GLYPH_PADDING = 1;  // Keeps neighbours from bleeding into each other
+}
+
+GlyphAtlas::GlyphAtlas(GlyphSource& source, int width, int height)
+	: m_source(source), m_width(width), m_height(height),
+	m_pixels(static_cast<size_t>(width) * height, 0) {}
+
+const AtlasGlyph* GlyphAtlas::Get(uint32_t codePoint) {
+	auto it = m_glyphs.find(codePoint);
+	if (it != m_glyphs.end()) {
+		m_stats.hits++;
+		return it->second.valid ? &it->second : nullptr;
+	}
+	m_stats.misses++;
+
+	AtlasGlyph glyph;
+	m_scratch.clear();
+	if (m_source.RenderGlyph(codePoint, glyph.metrics, m_scratch) &&
+		m_scratch.size() >= static_cast<size_t>(glyph.metrics.width) * glyph.metrics.height) {
+		glyph.valid = true;
+
+		if (glyph.metrics.width > 0 && glyph.metrics.height > 0) {
+			if (!Allocate(glyph.metrics.width, glyph.metrics.height, glyph.x, glyph.y)) {
+				// Full: start over. Glyphs handed out before are invalidated.
+				Reset();
+				if (!Allocate(glyph.metrics.width, glyph.metrics.height, glyph.x, glyph.y)) {
+					glyph.valid = false;  // Larger than the whole atlas
+				}
+			}
+			if (glyph.valid) {
+				for (int row = 0; row < glyph.metrics.height; row++) {
+					memcpy(&m_pixels[static_cast<size_t>(glyph.y + row) * m_width + glyph.x],
+						&m_scratch[static_cast<size_t>(row) * glyph.metrics.width], glyph.metrics.width);
+				}
+			}
+		}
+	}
+
+	AtlasGlyph& stored = m_glyphs[codePoint];
+	stored = glyph;
+	return stored.valid ? &stored : nullptr;
+}
+
+bool GlyphAtlas::Allocate(int width, int height, int& x, int& y) {
+	if (width + GLYPH_PADDING > m_width || height + GLYPH_PADDING > m_height) {
+		return false;
+	}
+	if (m_shelfX + width + GLYPH_PADDING > m_width) {
+		m_shelfY += m_shelfHeight;
+		m_shelfX = 0;
+		m_shelfHeight = 0;
+	}
+	if (m_shelfY + height + GLYPH_PADDING > m_height) {
+		return false;
+	}
+
+	x = m_shelfX;
+	y = m_shelfY;
+	m_shelfX += width + GLYPH_PADDING;
+	if (height + GLYPH_PADDING > m_shelfHeight) {
+		m_shelfHeight = height + GLYPH_PADDING;
+	}
+	return true;
+}
+
+void GlyphAtlas::Reset() {
+	m_glyphs.clear();
+	std::fill(m_pixels.begin(), m_pixels.end(), uint8_t(0));
+	m_shelfX = m_shelfY = m_shelfHeight = 0;
+	m_generation++;
+	m_stats.resets++;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Glyph cache for chrome text.
+//
+// Glyphs are rasterized once by a GlyphSource (GDI in the browser) and packed
+// into a single 8-bit coverage atlas with a shelf packer. Drawing a string
+// then only copies coverage out of the atlas. When the atlas fills up it is
+// cleared and refilled with the glyphs still in use, which for chrome text
+// (URLs, tab titles) is rare.
+
+struct GlyphMetrics {
+	int left = 0;     // Bitmap offset from the pen position
+	int top = 0;      // Bitmap top above the baseline
+	int width = 0;
+	int height = 0;
+	int advance = 0;
+};
+
+class GlyphSource {
+public:
+	virtual ~GlyphSource() = default;
+
+	virtual int Ascent() const = 0;
+	virtual int LineHeight() const = 0;
+
+	// Rasterizes a code point into width * height coverage bytes.
+	// Returns false if the font cannot draw it.
+	virtual bool RenderGlyph(uint32_t codePoint, GlyphMetrics& metrics, std::vector<uint8_t>& coverage) = 0;
+};
+
+struct AtlasGlyph {
+	GlyphMetrics metrics;
+	int x = 0;   // Position of the bitmap in the atlas
+	int y = 0;
+	bool valid = false;
+};
+
+struct GlyphAtlasStats {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t resets = 0;
+};
+
+class GlyphAtlas {
+public:
+	explicit GlyphAtlas(GlyphSource& source, int width = 512, int height = 512);
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+	// Returns the glyph, rasterizing it on first use, or null if the font
+	// cannot draw it. Pointers stay valid until the atlas is reset.
+	const AtlasGlyph* Get(uint32_t codePoint);
+
+	const GlyphSource& Source() const { return m_source; }
+	const uint8_t* Pixels() const { return m_pixels.data(); }
+	int Width() const { return m_width; }
+	int Height() const { return m_height; }
+
+	// Incremented whenever the atlas is cleared
+	uint32_t Generation() const { return m_generation; }
+
+	const GlyphAtlasStats& Stats() const { return m_stats; }
+
+private:
+	bool Allocate(int width, int height, int& x, int& y);
+	void Reset();
+
+	GlyphSource& m_source;
+	int m_width;
+	int m_height;
+	std::vector<uint8_t> m_pixels;
+	std::unordered_map<uint32_t, AtlasGlyph> m_glyphs;
+	std::vector<uint8_t> m_scratch;
+
+	// Shelf packer: glyphs fill rows left to right, a new shelf opens below
+	int m_shelfX = 0;
+	int m_shelfY = 0;
+	int m_shelfHeight = 0;
+
+	uint32_t m_generation = 0;
+	GlyphAtlasStats m_stats;
+};
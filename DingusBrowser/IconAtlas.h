@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// On-disk icon atlas produced by IconAtlasGen from Icons.svg.
+//
+// Layout: Header, then entryCount Entry records sorted by (name, dpi), then
+// 8-bit coverage masks (size * size bytes each, 4-byte aligned). The browser
+// maps the file read-only and blits straight out of the mapping.
+namespace IconAtlas {
+
+	constexpr uint32_t MAGIC = 0x31414944;  // "DIA1"
+	constexpr uint32_t VERSION = 1;
+	constexpr size_t NAME_LENGTH = 32;
+
+	// 100% to 300% display scaling
+	constexpr uint16_t DPI_SCALES[] = { 96, 120, 144, 168, 192, 240, 288 };
+
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t reserved;
+	};
+
+	struct Entry {
+		char name[NAME_LENGTH];  // Symbol id, NUL padded
+		uint16_t dpi;
+		uint16_t size;           // Width and height in pixels
+		uint32_t offset;         // Byte offset of the mask from the start of the file
+	};
+
+	static_assert(sizeof(Header) == 16, "Atlas header layout changed");
+	static_assert(sizeof(Entry) == 40, "Atlas entry layout changed");
+
+	inline int CompareEntry(const Entry& entry, const char* name, uint16_t dpi) {
+		int order = strncmp(entry.name, name, NAME_LENGTH);
+		if (order != 0) return order;
+		return static_cast<int>(entry.dpi) - static_cast<int>(dpi);
+	}
+
+	// Read-only view over a loaded or mapped atlas
+	class View {
+	public:
+		// Validates the header and entry table; returns false for a bad file
+		bool Attach(const uint8_t* data, size_t size) {
+			m_data = nullptr;
+			m_entries = nullptr;
+			m_count = 0;
+
+			if (!data || size < sizeof(Header)) return false;
+			Header header;
+			memcpy(&header, data, sizeof(header));
+			if (header.magic != MAGIC || header.version != VERSION) return false;
+			if (header.entryCount > (size - sizeof(Header)) / sizeof(Entry)) return false;
+
+			// Find binary searches, so the entries must be strictly increasing
+			const Entry* entries = reinterpret_cast<const Entry*>(data + sizeof(Header));
+			for (uint32_t i = 0; i < header.entryCount; i++) {
+				size_t bytes = static_cast<size_t>(entries[i].size) * entries[i].size;
+				if (entries[i].offset > size || bytes > size - entries[i].offset) return false;
+				if (i > 0 && CompareEntry(entries[i - 1], entries[i].name, entries[i].dpi) >= 0) return false;
+			}
+
+			m_data = data;
+			m_entries = entries;
+			m_count = header.entryCount;
+			return true;
+		}
+
+		bool IsValid() const { return m_data != nullptr; }
+
+		const Entry* Find(const char* name, uint16_t dpi) const {
+			size_t lo = 0, hi = m_count;
+			while (lo < hi) {
+				size_t mid = lo + (hi - lo) / 2;
+				int order = CompareEntry(m_entries[mid], name, dpi);
+				if (order == 0) return &m_entries[mid];
+				if (order < 0) lo = mid + 1;
+				else hi = mid;
+			}
+			return nullptr;
+		}
+
+		const uint8_t* Pixels(const Entry& entry) const { return m_data + entry.offset; }
+
+		size_t Count() const { return m_count; }
+		const Entry& At(size_t index) const { return m_entries[index]; }
+
+	private:
+		const uint8_t* m_data = nullptr;
+		const Entry* m_entries = nullptr;
+		size_t m_count = 0;
+	};
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// Bounded LRU cache of rasterized icons.
+//
+// Keyed by everything that changes the pixels of an icon, so a hover change
+// or repaint is a lookup plus a blit. The value type is left to the caller:
+// the browser stores premultiplied BGRA DIB sections, other code can store
+// plain pixel buffers.
+
+struct IconCacheKey {
+	int iconId = 0;
+	uint16_t size = 0;   // Pixel width and height
+	uint16_t dpi = 0;
+	uint32_t color = 0;  // COLORREF layout (0x00BBGGRR)
+
+	bool operator==(const IconCacheKey& other) const {
+		return iconId == other.iconId && size == other.size && dpi == other.dpi && color == other.color;
+	}
+};
+
+struct IconCacheKeyHash {
+	size_t operator()(const IconCacheKey& key) const {
+		uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(key.iconId)) << 32) ^
+			(static_cast<uint64_t>(key.size) << 48) ^ (static_cast<uint64_t>(key.dpi) << 16) ^ key.color;
+		// 64-bit finalizer from MurmurHash3
+		packed ^= packed >> 33;
+		packed *= 0xff51afd7ed558ccdULL;
+		packed ^= packed >> 33;
+		return static_cast<size_t>(packed);
+	}
+};
+
+struct IconCacheStats {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t evictions = 0;
+};
+
+template <typename Value>
+class IconCache {
+public:
+	explicit IconCache(size_t capacity) : m_capacity(capacity ? capacity : 1) {}
+
+	IconCache(const IconCache&) = delete;
+	IconCache& operator=(const IconCache&) = delete;
+
+	// Returns the cached value and marks it most recently used, or null
+	Value* Find(const IconCacheKey& key) {
+		auto it = m_index.find(key);
+		if (it == m_index.end()) {
+			m_stats.misses++;
+			return nullptr;
+		}
+		m_stats.hits++;
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		return &it->second->second;
+	}
+
+	// Inserts or replaces a value, evicting the least recently used entry
+	// when full. The returned reference stays valid until that entry is evicted.
+	Value& Insert(const IconCacheKey& key, Value value) {
+		auto it = m_index.find(key);
+		if (it != m_index.end()) {
+			it->second->second = std::move(value);
+			m_entries.splice(m_entries.begin(), m_entries, it->second);
+			return it->second->second;
+		}
+
+		if (m_entries.size() >= m_capacity) {
+			m_index.erase(m_entries.back().first);
+			m_entries.pop_back();
+			m_stats.evictions++;
+		}
+
+		m_entries.emplace_front(key, std::move(value));
+		m_index.emplace(key, m_entries.begin());
+		return m_entries.front().second;
+	}
+
+	void Clear() {
+		m_index.clear();
+		m_entries.clear();
+	}
+
+	size_t Size() const { return m_entries.size(); }
+	size_t Capacity() const { return m_capacity; }
+	const IconCacheStats& Stats() const { return m_stats; }
+
+private:
+	using Entry = std::pair<IconCacheKey, Value>;
+
+	size_t m_capacity;
+	std::list<Entry> m_entries;  // Most recently used first
+	std::unordered_map<IconCacheKey, typename std::list<Entry>::iterator, IconCacheKeyHash> m_index;
+	IconCacheStats m_stats;
+};
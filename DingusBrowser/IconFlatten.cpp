@@ -0,0 +1,65 @@
+#include "IconFlatten.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ICON_FLATTEN_SSE2 1
+#endif
+
+namespace IconFlatten {
+
+	int CubicSegmentCount(Svg::Point p0, Svg::Point p1, Svg::Point p2, Svg::Point p3, float tolerance) {
+		// Wang's formula: n = sqrt(3 * 2 / 8 * max|second difference| / tolerance)
+		float ax = p0.x - 2 * p1.x + p2.x, ay = p0.y - 2 * p1.y + p2.y;
+		float bx = p1.x - 2 * p2.x + p3.x, by = p1.y - 2 * p2.y + p3.y;
+		float a = ax * ax + ay * ay;
+		float b = bx * bx + by * by;
+		float m = std::sqrt(a > b ? a : b);
+
+		if (tolerance <= 0) tolerance = DEFAULT_TOLERANCE;
+		float n = std::ceil(std::sqrt(0.75f * m / tolerance));
+		if (!(n >= 1)) return 1;  // Also catches NaN
+		if (n > MAX_SEGMENTS) return MAX_SEGMENTS;
+		return static_cast<int>(n);
+	}
+
+	void EvaluateCubic(Svg::Point p0, Svg::Point p1, Svg::Point p2, Svg::Point p3,
+		int segments, float* xs, float* ys) {
+		// Power basis: B(t) = ((a * t + b) * t + c) * t + p0
+		float ax = p3.x - p0.x + 3 * (p1.x - p2.x), ay = p3.y - p0.y + 3 * (p1.y - p2.y);
+		float bx = 3 * (p0.x - 2 * p1.x + p2.x), by = 3 * (p0.y - 2 * p1.y + p2.y);
+		float cx = 3 * (p1.x - p0.x), cy = 3 * (p1.y - p0.y);
+		float step = 1.0f / segments;
+		int i = 0;
+
+#ifdef ICON_FLATTEN_SSE2
+		// Four parameter values per iteration
+		const __m128 vax = _mm_set1_ps(ax), vay = _mm_set1_ps(ay);
+		const __m128 vbx = _mm_set1_ps(bx), vby = _mm_set1_ps(by);
+		const __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy);
+		const __m128 vdx = _mm_set1_ps(p0.x), vdy = _mm_set1_ps(p0.y);
+		const __m128 vstep = _mm_set1_ps(step);
+		__m128 index = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+		const __m128 four = _mm_set1_ps(4.0f);
+		for (; i + 4 <= segments; i += 4) {
+			__m128 t = _mm_mul_ps(index, vstep);
+			__m128 x = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(vax, t), vbx), t), vcx), t), vdx);
+			__m128 y = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(vay, t), vby), t), vcy), t), vdy);
+			_mm_storeu_ps(xs + i, x);
+			_mm_storeu_ps(ys + i, y);
+			index = _mm_add_ps(index, four);
+		}
+#endif
+
+		for (; i < segments; i++) {
+			float t = (i + 1) * step;
+			xs[i] = ((ax * t + bx) * t + cx) * t + p0.x;
+			ys[i] = ((ay * t + by) * t + cy) * t + p0.y;
+		}
+
+		// Land exactly on the endpoint so adjacent segments join without gaps
+		xs[segments - 1] = p3.x;
+		ys[segments - 1] = p3.y;
+	}
+}
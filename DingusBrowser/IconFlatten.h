@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+#include "SvgPath.h"
+
+// Curve flattening for icon paths.
+//
+// The parser already reduces quadratics and arcs to cubics of at most 90
+// degrees, so the flattener works on cubics. Segment counts come from Wang's
+// formula on device-space control points, which bounds the distance between
+// the curve and its polyline by the tolerance: a 20px toolbar icon gets a
+// handful of segments per curve, a 300% DPI icon gets proportionally more.
+namespace IconFlatten {
+
+	// Maximum distance in device pixels between curve and polyline
+	constexpr float DEFAULT_TOLERANCE = 0.125f;
+
+	// Upper bound on segments per curve, reached only by degenerate input
+	constexpr int MAX_SEGMENTS = 256;
+
+	// Segments needed so a cubic with device-space control points p0..p3
+	// stays within tolerance; always at least 1.
+	int CubicSegmentCount(Svg::Point p0, Svg::Point p1, Svg::Point p2, Svg::Point p3, float tolerance);
+
+	// Writes the points at t = 1/n, 2/n, ..., 1 into xs/ys (n entries each).
+	// The curve start p0 is not written.
+	void EvaluateCubic(Svg::Point p0, Svg::Point p1, Svg::Point p2, Svg::Point p3,
+		int segments, float* xs, float* ys);
+}
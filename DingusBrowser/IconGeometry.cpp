@@ -0,0 +1,71 @@
+#include "IconGeometry.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ICON_GEOMETRY_SSE2 1
+#endif
+
+namespace IconGeometry {
+
+	namespace {
+		// Saturates like the vector path: NaN and anything above the range give 32767
+		int16_t ToFixed(float v) {
+			float scaled = std::nearbyint(v * FIXED_ONE);
+			if (!(scaled <= 32767.0f)) return 32767;
+			if (scaled < -32768.0f) return -32768;
+			return static_cast<int16_t>(scaled);
+		}
+
+#ifdef ICON_GEOMETRY_SSE2
+		// Clamps to the int16_t range before converting. _mm_cvtps_epi32 turns NaN
+		// and values past 2^31 into INT_MIN, which would saturate to -32768.
+		// minps returns its second operand for NaN, so NaN clamps to the top.
+		inline __m128i ToFixed(__m128 v) {
+			v = _mm_min_ps(_mm_mul_ps(v, _mm_set1_ps(FIXED_ONE)), _mm_set1_ps(32767.0f));
+			v = _mm_max_ps(v, _mm_set1_ps(-32768.0f));
+			return _mm_cvtps_epi32(v);
+		}
+
+		// Applies the transform to four x and four y lanes and stores fixed point
+		inline void TransformStore(__m128 x, __m128 y, const Transform& m, int16_t* outX, int16_t* outY) {
+			__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m.a)), _mm_mul_ps(y, _mm_set1_ps(m.c))), _mm_set1_ps(m.tx));
+			__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m.b)), _mm_mul_ps(y, _mm_set1_ps(m.d))), _mm_set1_ps(m.ty));
+			__m128i ix = ToFixed(rx);
+			__m128i iy = ToFixed(ry);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(outX), _mm_packs_epi32(ix, ix));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(outY), _mm_packs_epi32(iy, iy));
+		}
+#endif
+	}
+
+	void TransformPoints(const Svg::Point* points, int count, const Transform& m, int16_t* xs, int16_t* ys) {
+		int i = 0;
+
+#ifdef ICON_GEOMETRY_SSE2
+		const float* p = reinterpret_cast<const float*>(points);
+		for (; i + 4 <= count; i += 4) {
+			// Deinterleave x0 y0 x1 y1 | x2 y2 x3 y3 into x and y lanes
+			__m128 v0 = _mm_loadu_ps(p + i * 2);
+			__m128 v1 = _mm_loadu_ps(p + i * 2 + 4);
+			__m128 x = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 y = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+			TransformStore(x, y, m, xs + i, ys + i);
+		}
+#endif
+
+		for (; i < count; i++) {
+			float x = points[i].x, y = points[i].y;
+			xs[i] = ToFixed(m.a * x + m.c * y + m.tx);
+			ys[i] = ToFixed(m.b * x + m.d * y + m.ty);
+		}
+	}
+
+	void BuildScaledPath(const IconPath& path, const Transform& m, ScaledIconPath& out) {
+		out.xs.resize(path.count);
+		out.ys.resize(path.count);
+		out.types.assign(path.types, path.types + path.count);
+		TransformPoints(path.points, path.count, m, out.xs.data(), out.ys.data());
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "IconRaster.h"
+
+// Device-space icon geometry.
+//
+// Icon paths are stored once in the 24x24 icon space as float points. For
+// drawing they are transformed to the target pixel size into separate x/y
+// arrays of int16 fixed point (1/64 px). That is half the size of the float
+// points and lets the transform run four points per SSE2 step. A DPI change
+// re-runs the transform for the new size.
+namespace IconGeometry {
+
+	constexpr int FIXED_SHIFT = 6;
+	constexpr float FIXED_ONE = static_cast<float>(1 << FIXED_SHIFT);
+
+	// x' = a * x + c * y + tx, y' = b * x + d * y + ty
+	struct Transform {
+		float a = 1, b = 0, c = 0, d = 1;
+		float tx = 0, ty = 0;
+
+		static Transform Scale(float scale, float offsetX = 0, float offsetY = 0) {
+			return { scale, 0, 0, scale, offsetX, offsetY };
+		}
+	};
+
+	struct ScaledIconPath {
+		std::vector<int16_t> xs;
+		std::vector<int16_t> ys;
+		std::vector<uint8_t> types;
+
+		int Count() const { return static_cast<int>(types.size()); }
+	};
+
+	// Transforms float points to fixed point; results saturate to int16
+	void TransformPoints(const Svg::Point* points, int count, const Transform& m, int16_t* xs, int16_t* ys);
+
+	// Builds the device-space copy of an icon path
+	void BuildScaledPath(const IconPath& path, const Transform& m, ScaledIconPath& out);
+}
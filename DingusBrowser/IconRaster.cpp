@@ -0,0 +1,336 @@
+#include "IconRaster.h"
+
+#include "IconFlatten.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ICON_RASTER_SSE2 1
+#endif
+
+namespace IconRaster {
+
+	namespace {
+		float Clamp(float v, float lo, float hi) {
+			return v < lo ? lo : (v > hi ? hi : v);
+		}
+
+		// Exact x / 255 for x in [0, 255 * 255]
+		inline uint32_t Div255(uint32_t x) {
+			x += 128;
+			return (x + (x >> 8)) >> 8;
+		}
+
+#ifdef ICON_RASTER_SSE2
+		inline __m128i Div255(__m128i x) {
+			x = _mm_add_epi16(x, _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+		}
+
+		// Expands 4 coverage bytes to 16-bit lanes, each repeated for B, G, R and A
+		inline void ExpandCoverage(const uint8_t* mask, __m128i& lo, __m128i& hi) {
+			uint32_t packed;
+			memcpy(&packed, mask, sizeof(packed));
+			__m128i a = _mm_cvtsi32_si128(static_cast<int>(packed));
+			a = _mm_unpacklo_epi8(a, a);   // a0 a0 a1 a1 a2 a2 a3 a3
+			a = _mm_unpacklo_epi16(a, a);  // a0 x4, a1 x4, a2 x4, a3 x4
+			__m128i zero = _mm_setzero_si128();
+			lo = _mm_unpacklo_epi8(a, zero);
+			hi = _mm_unpackhi_epi8(a, zero);
+		}
+#endif
+	}
+
+	void CoverageRasterizer::Reset(int width, int height) {
+		m_width = width;
+		m_height = height;
+		// Two spare columns absorb the area spilled past the last pixel; rounded
+		// up so the vector resolve can always load whole groups of four
+		m_rowStride = (width + 2 + 3) & ~3;
+		m_accumulation.assign(static_cast<size_t>(m_rowStride) * height, 0.0f);
+	}
+
+	void CoverageRasterizer::AddLine(float x0, float y0, float x1, float y1) {
+		if (!std::isfinite(x0) || !std::isfinite(y0) || !std::isfinite(x1) || !std::isfinite(y1) || y0 == y1) {
+			return;
+		}
+
+		float direction = 1.0f;
+		if (y0 > y1) {
+			direction = -1.0f;
+			float t = x0; x0 = x1; x1 = t;
+			t = y0; y0 = y1; y1 = t;
+		}
+
+		// Clip to the rows of the mask. Doubles keep the slope and the clipped
+		// points finite for any float input.
+		double dxdy = (static_cast<double>(x1) - x0) / (static_cast<double>(y1) - y0);
+		double top = y0 > 0.0f ? y0 : 0.0;
+		double bottom = y1 < m_height ? y1 : static_cast<double>(m_height);
+		if (top >= bottom) {
+			return;
+		}
+		double xTop = x0 + (top - y0) * dxdy;
+		double xBottom = x0 + (bottom - y0) * dxdy;
+
+		// Split where the segment crosses the left and right edges. A piece left
+		// of the mask still covers every pixel to its right, so it becomes a
+		// vertical line at x = 0; a piece right of the mask covers nothing.
+		double ys[4] = { top, 0.0, 0.0, bottom };
+		int splits = 1;
+		for (double edge : { 0.0, static_cast<double>(m_width) }) {
+			if ((xTop - edge) * (xBottom - edge) < 0.0) {
+				ys[splits++] = top + (edge - xTop) / (xBottom - xTop) * (bottom - top);
+			}
+		}
+		if (splits == 3 && ys[1] > ys[2]) {
+			double t = ys[1]; ys[1] = ys[2]; ys[2] = t;
+		}
+		ys[splits] = bottom;
+
+		for (int i = 0; i < splits; i++) {
+			double ya = ys[i];
+			double yb = ys[i + 1];
+			double xa = xTop + (ya - top) * dxdy;
+			double xb = xTop + (yb - top) * dxdy;
+			double mid = 0.5 * (xa + xb);
+			if (mid >= m_width) {
+				continue;
+			}
+			if (mid <= 0.0) {
+				xa = xb = 0.0;
+			}
+			AddClippedLine(static_cast<float>(xa), static_cast<float>(ya),
+				static_cast<float>(xb), static_cast<float>(yb), direction);
+		}
+	}
+
+	// Accumulates a segment with y0 <= y1 that lies inside the mask
+	void CoverageRasterizer::AddClippedLine(float x0, float y0, float x1, float y1, float direction) {
+		if (y0 >= y1) {
+			return;
+		}
+		float maxX = static_cast<float>(m_width);
+		x0 = Clamp(x0, 0.0f, maxX);
+		x1 = Clamp(x1, 0.0f, maxX);
+		float dxdy = (x1 - x0) / (y1 - y0);
+		float x = x0;
+
+		int yStart = static_cast<int>(std::floor(y0));
+		int yEnd = static_cast<int>(std::ceil(y1));
+		for (int y = yStart; y < yEnd; y++) {
+			float* row = &m_accumulation[static_cast<size_t>(y) * m_rowStride];
+			float top = y0 > y ? y0 : static_cast<float>(y);
+			float bottom = y1 < y + 1 ? y1 : static_cast<float>(y + 1);
+			float dy = bottom - top;
+			// Clamped so rounding in the slope never steps outside the row
+			float xNext = Clamp(x + dxdy * dy, 0.0f, maxX);
+			float d = dy * direction;
+
+			float left = x < xNext ? x : xNext;
+			float right = x < xNext ? xNext : x;
+			float leftFloor = std::floor(left);
+			int leftIndex = static_cast<int>(leftFloor);
+			float rightCeil = std::ceil(right);
+			int rightIndex = static_cast<int>(rightCeil);
+
+			if (rightIndex <= leftIndex + 1) {
+				// Segment stays within one pixel column
+				float mid = 0.5f * (x + xNext) - leftFloor;
+				row[leftIndex] += d - d * mid;
+				row[leftIndex + 1] += d * mid;
+			}
+			else {
+				float inverse = 1.0f / (right - left);
+				float leftFrac = left - leftFloor;
+				float a0 = 0.5f * inverse * (1.0f - leftFrac) * (1.0f - leftFrac);
+				float rightFrac = right - rightCeil + 1.0f;
+				float am = 0.5f * inverse * rightFrac * rightFrac;
+
+				row[leftIndex] += d * a0;
+				if (rightIndex == leftIndex + 2) {
+					row[leftIndex + 1] += d * (1.0f - a0 - am);
+				}
+				else {
+					float a1 = inverse * (1.5f - leftFrac);
+					row[leftIndex + 1] += d * (a1 - a0);
+					for (int xi = leftIndex + 2; xi < rightIndex - 1; xi++) {
+						row[xi] += d * inverse;
+					}
+					float a2 = a1 + (rightIndex - leftIndex - 3) * inverse;
+					row[rightIndex - 1] += d * (1.0f - a2 - am);
+				}
+				row[rightIndex] += d * am;
+			}
+			x = xNext;
+		}
+	}
+
+	// Walks a point/type list; pointAt(i) returns the device-space point i
+	template <typename PointAt>
+	void CoverageRasterizer::AddPoints(const uint8_t* types, int count, PointAt pointAt) {
+		float startX = 0, startY = 0;
+		float lastX = 0, lastY = 0;
+		bool open = false;
+
+		for (int i = 0; i < count; i++) {
+			Svg::Point point = pointAt(i);
+			float x = point.x;
+			float y = point.y;
+			uint8_t type = types[i] & Svg::PointTypeMask;
+
+			if (type == Svg::PointTypeStart) {
+				if (open) {
+					AddLine(lastX, lastY, startX, startY);
+				}
+				startX = lastX = x;
+				startY = lastY = y;
+				open = true;
+			}
+			else if (type == Svg::PointTypeBezier && i + 2 < count) {
+				// Flatten in device space so the segment count tracks the output size
+				Svg::Point p0 = { lastX, lastY };
+				Svg::Point p1 = { x, y };
+				Svg::Point p2 = pointAt(i + 1);
+				Svg::Point p3 = pointAt(i + 2);
+
+				float xs[IconFlatten::MAX_SEGMENTS];
+				float ys[IconFlatten::MAX_SEGMENTS];
+				int segments = IconFlatten::CubicSegmentCount(p0, p1, p2, p3, m_tolerance);
+				IconFlatten::EvaluateCubic(p0, p1, p2, p3, segments, xs, ys);
+				for (int s = 0; s < segments; s++) {
+					AddLine(lastX, lastY, xs[s], ys[s]);
+					lastX = xs[s];
+					lastY = ys[s];
+				}
+				i += 2;
+			}
+			else {
+				AddLine(lastX, lastY, x, y);
+				lastX = x;
+				lastY = y;
+			}
+
+			if (types[i] & Svg::PointTypeCloseSubpath) {
+				AddLine(lastX, lastY, startX, startY);
+				lastX = startX;
+				lastY = startY;
+				open = false;
+			}
+		}
+
+		if (open) {
+			AddLine(lastX, lastY, startX, startY);
+		}
+	}
+
+	void CoverageRasterizer::AddPath(const Svg::Point* points, const uint8_t* types, int count,
+		float scale, float offsetX, float offsetY) {
+		AddPoints(types, count, [&](int i) {
+			return Svg::Point{ points[i].x * scale + offsetX, points[i].y * scale + offsetY };
+		});
+	}
+
+	void CoverageRasterizer::AddFixedPath(const int16_t* xs, const int16_t* ys, const uint8_t* types,
+		int count, int fractionBits) {
+		float unit = 1.0f / static_cast<float>(1 << fractionBits);
+		AddPoints(types, count, [&](int i) {
+			return Svg::Point{ xs[i] * unit, ys[i] * unit };
+		});
+	}
+
+	void CoverageRasterizer::Resolve(uint8_t* mask, int stride) const {
+		for (int y = 0; y < m_height; y++) {
+			const float* row = &m_accumulation[static_cast<size_t>(y) * m_rowStride];
+			uint8_t* out = mask + static_cast<size_t>(y) * stride;
+			int x = 0;
+
+#ifdef ICON_RASTER_SSE2
+			// Running prefix sum four lanes at a time, carrying the last lane
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 scale = _mm_set1_ps(255.0f);
+			__m128 carry = _mm_setzero_ps();
+			for (; x < m_width; x += 4) {
+				__m128 v = _mm_loadu_ps(row + x);
+				v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)));
+				v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+				v = _mm_add_ps(v, carry);
+				carry = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+
+				__m128 coverage = _mm_min_ps(_mm_andnot_ps(signMask, v), one);
+				__m128i values = _mm_cvtps_epi32(_mm_mul_ps(coverage, scale));
+				values = _mm_packs_epi32(values, values);
+				values = _mm_packus_epi16(values, values);
+
+				uint32_t packed = static_cast<uint32_t>(_mm_cvtsi128_si32(values));
+				int remaining = m_width - x;
+				memcpy(out + x, &packed, remaining < 4 ? remaining : 4);
+			}
+#else
+			float sum = 0.0f;
+			for (; x < m_width; x++) {
+				sum += row[x];
+				float coverage = sum < 0 ? -sum : sum;
+				if (coverage > 1.0f) coverage = 1.0f;
+				out[x] = static_cast<uint8_t>(coverage * 255.0f + 0.5f);
+			}
+#endif
+		}
+	}
+
+	void TintCoverage(const uint8_t* mask, uint32_t* pixels, int count,
+		uint8_t r, uint8_t g, uint8_t b) {
+		int i = 0;
+
+#ifdef ICON_RASTER_SSE2
+		const __m128i color = _mm_setr_epi16(b, g, r, 255, b, g, r, 255);
+		for (; i + 4 <= count; i += 4) {
+			__m128i lo, hi;
+			ExpandCoverage(mask + i, lo, hi);
+			lo = Div255(_mm_mullo_epi16(lo, color));
+			hi = Div255(_mm_mullo_epi16(hi, color));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_packus_epi16(lo, hi));
+		}
+#endif
+
+		for (; i < count; i++) {
+			uint32_t a = mask[i];
+			pixels[i] = (a << 24) | (Div255(r * a) << 16) | (Div255(g * a) << 8) | Div255(b * a);
+		}
+	}
+
+	void BlendCoverage(const uint8_t* mask, uint32_t* pixels, int count,
+		uint8_t r, uint8_t g, uint8_t b) {
+		int i = 0;
+
+#ifdef ICON_RASTER_SSE2
+		const __m128i color = _mm_setr_epi16(b, g, r, 255, b, g, r, 255);
+		const __m128i full = _mm_set1_epi16(255);
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 4 <= count; i += 4) {
+			__m128i lo, hi;
+			ExpandCoverage(mask + i, lo, hi);
+			__m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+			__m128i dstLo = _mm_unpacklo_epi8(dst, zero);
+			__m128i dstHi = _mm_unpackhi_epi8(dst, zero);
+
+			// dst + (color - dst) * a, written as color * a + dst * (255 - a)
+			lo = Div255(_mm_add_epi16(_mm_mullo_epi16(color, lo), _mm_mullo_epi16(dstLo, _mm_sub_epi16(full, lo))));
+			hi = Div255(_mm_add_epi16(_mm_mullo_epi16(color, hi), _mm_mullo_epi16(dstHi, _mm_sub_epi16(full, hi))));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_packus_epi16(lo, hi));
+		}
+#endif
+
+		for (; i < count; i++) {
+			uint32_t a = mask[i];
+			uint32_t inv = 255 - a;
+			uint32_t dst = pixels[i];
+			uint32_t db = dst & 0xFF, dg = (dst >> 8) & 0xFF, dr = (dst >> 16) & 0xFF, da = dst >> 24;
+			pixels[i] = (Div255(255 * a + da * inv) << 24) | (Div255(r * a + dr * inv) << 16) |
+				(Div255(g * a + dg * inv) << 8) | Div255(b * a + db * inv);
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "IconFlatten.h"
+#include "SvgPath.h"
+
+// Non-owning view over icon geometry in the 24x24 icon space
+struct IconPath {
+	const Svg::Point* points = nullptr;
+	const uint8_t* types = nullptr;
+	int count = 0;
+};
+
+// Anti-aliased coverage rasterizer for icon paths.
+//
+// Edges are accumulated as signed area into a float buffer; a prefix sum
+// along each row then yields nonzero-winding coverage. Used both by the
+// atlas generator and at runtime, so it has no platform dependencies.
+// The resolve and compositing kernels use SSE2 where available.
+namespace IconRaster {
+
+	class CoverageRasterizer {
+	public:
+		// Clears the accumulation buffer for a width x height mask
+		void Reset(int width, int height);
+
+		// Adds an edge in mask pixels. Parts outside the mask are clipped
+		// exactly; edges with a non-finite coordinate are ignored.
+		void AddLine(float x0, float y0, float x1, float y1);
+
+		// Maximum curve flattening error in pixels
+		void SetTolerance(float tolerance) { m_tolerance = tolerance; }
+
+		// Adds a parsed path, mapping icon space through scale and offset.
+		// Open subpaths are closed implicitly, as fills require.
+		void AddPath(const Svg::Point* points, const uint8_t* types, int count,
+			float scale, float offsetX, float offsetY);
+
+		void AddPath(const IconPath& path, float scale, float offsetX, float offsetY) {
+			AddPath(path.points, path.types, path.count, scale, offsetX, offsetY);
+		}
+
+		// Adds device-space geometry stored as separate fixed-point x/y arrays
+		void AddFixedPath(const int16_t* xs, const int16_t* ys, const uint8_t* types,
+			int count, int fractionBits);
+
+		// Writes 8-bit coverage, one byte per pixel
+		void Resolve(uint8_t* mask, int stride) const;
+
+		int Width() const { return m_width; }
+		int Height() const { return m_height; }
+
+	private:
+		void AddClippedLine(float x0, float y0, float x1, float y1, float direction);
+
+		template <typename PointAt>
+		void AddPoints(const uint8_t* types, int count, PointAt pointAt);
+
+		int m_width = 0;
+		int m_height = 0;
+		int m_rowStride = 0;
+		float m_tolerance = IconFlatten::DEFAULT_TOLERANCE;
+		std::vector<float> m_accumulation;
+	};
+
+	// Converts coverage to premultiplied BGRA pixels of a solid color
+	void TintCoverage(const uint8_t* mask, uint32_t* pixels, int count,
+		uint8_t r, uint8_t g, uint8_t b);
+
+	// Composites a solid color through coverage onto opaque BGRA pixels
+	void BlendCoverage(const uint8_t* mask, uint32_t* pixels, int count,
+		uint8_t r, uint8_t g, uint8_t b);
+}
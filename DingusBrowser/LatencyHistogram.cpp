@@ -0,0 +1,95 @@
+#include "LatencyHistogram.h"
+
+#include <bit>
+
+int LatencyHistogram::BucketIndex(uint64_t value) {
+	if (value < SUB_BUCKET_COUNT) {
+		return static_cast<int>(value);
+	}
+	// Keep the top SUB_BUCKET_BITS bits; the shift picks the power of two
+	int shift = std::bit_width(value) - SUB_BUCKET_BITS;
+	return static_cast<int>(shift * SUB_BUCKET_HALF + (value >> shift));
+}
+
+uint64_t LatencyHistogram::BucketLowest(int index) {
+	if (index < static_cast<int>(SUB_BUCKET_COUNT)) {
+		return static_cast<uint64_t>(index);
+	}
+	int shift = index / static_cast<int>(SUB_BUCKET_HALF) - 1;
+	uint64_t sub = static_cast<uint64_t>(index) - shift * SUB_BUCKET_HALF;
+	return sub << shift;
+}
+
+uint64_t LatencyHistogram::BucketHighest(int index) {
+	if (index < static_cast<int>(SUB_BUCKET_COUNT)) {
+		return static_cast<uint64_t>(index);
+	}
+	int shift = index / static_cast<int>(SUB_BUCKET_HALF) - 1;
+	return BucketLowest(index) + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t value) {
+	if (value > MAX_VALUE) {
+		value = MAX_VALUE;
+	}
+	m_counts[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(value, std::memory_order_relaxed);
+
+	uint64_t current = m_min.load(std::memory_order_relaxed);
+	while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+	current = m_max.load(std::memory_order_relaxed);
+	while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) const {
+	uint64_t total = 0;
+	for (const auto& count : m_counts) {
+		total += count.load(std::memory_order_relaxed);
+	}
+	if (total == 0) {
+		return 0;
+	}
+
+	if (percentile < 0) percentile = 0;
+	if (percentile > 100) percentile = 100;
+	uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5);
+	if (rank < 1) rank = 1;
+
+	uint64_t seen = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++) {
+		seen += m_counts[i].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			// Never report past the largest value actually seen
+			uint64_t highest = BucketHighest(i);
+			uint64_t max = m_max.load(std::memory_order_relaxed);
+			return highest < max ? highest : max;
+		}
+	}
+	return m_max.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram::Summary LatencyHistogram::Summarize() const {
+	Summary summary;
+	summary.count = Count();
+	if (summary.count == 0) {
+		return summary;
+	}
+	summary.min = m_min.load(std::memory_order_relaxed);
+	summary.max = m_max.load(std::memory_order_relaxed);
+	summary.mean = static_cast<double>(m_sum.load(std::memory_order_relaxed)) / static_cast<double>(summary.count);
+	summary.p50 = Percentile(50);
+	summary.p90 = Percentile(90);
+	summary.p99 = Percentile(99);
+	return summary;
+}
+
+void LatencyHistogram::Reset() {
+	for (auto& count : m_counts) {
+		count.store(0, std::memory_order_relaxed);
+	}
+	m_count.store(0, std::memory_order_relaxed);
+	m_sum.store(0, std::memory_order_relaxed);
+	m_min.store(UINT64_MAX, std::memory_order_relaxed);
+	m_max.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Fixed-size HDR-style latency histogram.
+//
+// Values (nanoseconds) land in log-linear buckets: exact below 128, then 64
+// linear sub-buckets per power of two, so every recorded value is kept to
+// within 1/64 (about 1.6%) of its true size from 1 ns up to MAX_VALUE.
+// Recording is a few integer operations plus relaxed atomic increments, so
+// it can run on any thread without locks. Reads may see a recording in
+// progress, which is fine for statistics.
+class LatencyHistogram {
+public:
+	static constexpr int SUB_BUCKET_BITS = 7;
+	static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;
+	static constexpr uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+	static constexpr int MAX_VALUE_BITS = 40;
+	static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_VALUE_BITS) - 1;  // About 18 minutes
+	static constexpr int BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+
+	struct Summary {
+		uint64_t count = 0;
+		uint64_t min = 0;
+		uint64_t max = 0;
+		double mean = 0;
+		uint64_t p50 = 0;
+		uint64_t p90 = 0;
+		uint64_t p99 = 0;
+	};
+
+	LatencyHistogram() { Reset(); }
+
+	LatencyHistogram(const LatencyHistogram&) = delete;
+	LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+	// Values above MAX_VALUE are clamped to it
+	void Record(uint64_t value);
+
+	// Smallest value v such that at least percentile% of recordings are <= v,
+	// reported as the upper end of its bucket. 0 if nothing was recorded.
+	uint64_t Percentile(double percentile) const;
+
+	Summary Summarize() const;
+
+	uint64_t Count() const { return m_count.load(std::memory_order_relaxed); }
+
+	// Not safe against concurrent Record calls
+	void Reset();
+
+	static int BucketIndex(uint64_t value);
+	static uint64_t BucketLowest(int index);
+	static uint64_t BucketHighest(int index);
+
+private:
+	std::atomic<uint64_t> m_counts[BUCKET_COUNT];
+	std::atomic<uint64_t> m_count;
+	std::atomic<uint64_t> m_sum;
+	std::atomic<uint64_t> m_min;
+	std::atomic<uint64_t> m_max;
+};
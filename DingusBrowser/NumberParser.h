@@ -0,0 +1,462 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// Locale-independent decimal to float conversion.
+//
+// Accepts the JSON/SVG number grammar: [+-] digits [. digits] [e [+-] digits],
+// where either the integer or the fraction part may be empty. Parsing stops at
+// the first character that does not continue the number, so compact forms such
+// as ".5.5" and "-1.41-1.41" split into two numbers. An 'e' is only taken as an
+// exponent when digits follow it. No whitespace, "inf" or "nan" is accepted.
+//
+// Results are correctly rounded (round to nearest, ties to even):
+// - small exact inputs take the Clinger fast path (one float multiply/divide)
+// - everything else uses the Eisel-Lemire algorithm against a table of
+//   128-bit truncated powers of five
+// - inputs with more than 19 significant digits that land next to a rounding
+//   boundary are settled by an exact big-integer comparison
+//
+// Works on char (UTF-8), wchar_t and char16_t (UTF-16) input and is constexpr.
+
+namespace NumberParser {
+
+	namespace Detail {
+		constexpr int MANTISSA_BITS = 23;
+		constexpr int MIN_EXPONENT = -127;
+		constexpr int INFINITE_POWER = 0xFF;
+		constexpr int SMALLEST_POWER_OF_TEN = -65;   // Below this everything rounds to zero
+		constexpr int LARGEST_POWER_OF_TEN = 38;     // Above this everything overflows
+		constexpr int MAX_DIGITS = 19;               // Significant digits that fit a uint64_t
+		constexpr int MAX_EXACT_DIGITS = 114;        // Digits needed to decide any float halfway case
+		constexpr int MAX_EXPONENT_VALUE = 100000;
+
+		// 5^q for q in [-65, 38], normalized so the top bit is set and truncated
+		// (negative powers rounded up) to 128 bits.
+		inline constexpr uint64_t POWERS_OF_FIVE[][2] = {
+		{ 0x86ccbb52ea94baea, 0x98e947129fc2b4e9 },  // 5^-65
+		{ 0xa87fea27a539e9a5, 0x3f2398d747b36224 },  // 5^-64
+		{ 0xd29fe4b18e88640e, 0x8eec7f0d19a03aad },  // 5^-63
+		{ 0x83a3eeeef9153e89, 0x1953cf68300424ac },  // 5^-62
+		{ 0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7 },  // 5^-61
+		{ 0xcdb02555653131b6, 0x3792f412cb06794d },  // 5^-60
+		{ 0x808e17555f3ebf11, 0xe2bbd88bbee40bd0 },  // 5^-59
+		{ 0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4 },  // 5^-58
+		{ 0xc8de047564d20a8b, 0xf245825a5a445275 },  // 5^-57
+		{ 0xfb158592be068d2e, 0xeed6e2f0f0d56712 },  // 5^-56
+		{ 0x9ced737bb6c4183d, 0x55464dd69685606b },  // 5^-55
+		{ 0xc428d05aa4751e4c, 0xaa97e14c3c26b886 },  // 5^-54
+		{ 0xf53304714d9265df, 0xd53dd99f4b3066a8 },  // 5^-53
+		{ 0x993fe2c6d07b7fab, 0xe546a8038efe4029 },  // 5^-52
+		{ 0xbf8fdb78849a5f96, 0xde98520472bdd033 },  // 5^-51
+		{ 0xef73d256a5c0f77c, 0x963e66858f6d4440 },  // 5^-50
+		{ 0x95a8637627989aad, 0xdde7001379a44aa8 },  // 5^-49
+		{ 0xbb127c53b17ec159, 0x5560c018580d5d52 },  // 5^-48
+		{ 0xe9d71b689dde71af, 0xaab8f01e6e10b4a6 },  // 5^-47
+		{ 0x9226712162ab070d, 0xcab3961304ca70e8 },  // 5^-46
+		{ 0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22 },  // 5^-45
+		{ 0xe45c10c42a2b3b05, 0x8cb89a7db77c506a },  // 5^-44
+		{ 0x8eb98a7a9a5b04e3, 0x77f3608e92adb242 },  // 5^-43
+		{ 0xb267ed1940f1c61c, 0x55f038b237591ed3 },  // 5^-42
+		{ 0xdf01e85f912e37a3, 0x6b6c46dec52f6688 },  // 5^-41
+		{ 0x8b61313bbabce2c6, 0x2323ac4b3b3da015 },  // 5^-40
+		{ 0xae397d8aa96c1b77, 0xabec975e0a0d081a },  // 5^-39
+		{ 0xd9c7dced53c72255, 0x96e7bd358c904a21 },  // 5^-38
+		{ 0x881cea14545c7575, 0x7e50d64177da2e54 },  // 5^-37
+		{ 0xaa242499697392d2, 0xdde50bd1d5d0b9e9 },  // 5^-36
+		{ 0xd4ad2dbfc3d07787, 0x955e4ec64b44e864 },  // 5^-35
+		{ 0x84ec3c97da624ab4, 0xbd5af13bef0b113e },  // 5^-34
+		{ 0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e },  // 5^-33
+		{ 0xcfb11ead453994ba, 0x67de18eda5814af2 },  // 5^-32
+		{ 0x81ceb32c4b43fcf4, 0x80eacf948770ced7 },  // 5^-31
+		{ 0xa2425ff75e14fc31, 0xa1258379a94d028d },  // 5^-30
+		{ 0xcad2f7f5359a3b3e, 0x096ee45813a04330 },  // 5^-29
+		{ 0xfd87b5f28300ca0d, 0x8bca9d6e188853fc },  // 5^-28
+		{ 0x9e74d1b791e07e48, 0x775ea264cf55347e },  // 5^-27
+		{ 0xc612062576589dda, 0x95364afe032a819e },  // 5^-26
+		{ 0xf79687aed3eec551, 0x3a83ddbd83f52205 },  // 5^-25
+		{ 0x9abe14cd44753b52, 0xc4926a9672793543 },  // 5^-24
+		{ 0xc16d9a0095928a27, 0x75b7053c0f178294 },  // 5^-23
+		{ 0xf1c90080baf72cb1, 0x5324c68b12dd6339 },  // 5^-22
+		{ 0x971da05074da7bee, 0xd3f6fc16ebca5e04 },  // 5^-21
+		{ 0xbce5086492111aea, 0x88f4bb1ca6bcf585 },  // 5^-20
+		{ 0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6 },  // 5^-19
+		{ 0x9392ee8e921d5d07, 0x3aff322e62439fd0 },  // 5^-18
+		{ 0xb877aa3236a4b449, 0x09befeb9fad487c3 },  // 5^-17
+		{ 0xe69594bec44de15b, 0x4c2ebe687989a9b4 },  // 5^-16
+		{ 0x901d7cf73ab0acd9, 0x0f9d37014bf60a11 },  // 5^-15
+		{ 0xb424dc35095cd80f, 0x538484c19ef38c95 },  // 5^-14
+		{ 0xe12e13424bb40e13, 0x2865a5f206b06fba },  // 5^-13
+		{ 0x8cbccc096f5088cb, 0xf93f87b7442e45d4 },  // 5^-12
+		{ 0xafebff0bcb24aafe, 0xf78f69a51539d749 },  // 5^-11
+		{ 0xdbe6fecebdedd5be, 0xb573440e5a884d1c },  // 5^-10
+		{ 0x89705f4136b4a597, 0x31680a88f8953031 },  // 5^-9
+		{ 0xabcc77118461cefc, 0xfdc20d2b36ba7c3e },  // 5^-8
+		{ 0xd6bf94d5e57a42bc, 0x3d32907604691b4d },  // 5^-7
+		{ 0x8637bd05af6c69b5, 0xa63f9a49c2c1b110 },  // 5^-6
+		{ 0xa7c5ac471b478423, 0x0fcf80dc33721d54 },  // 5^-5
+		{ 0xd1b71758e219652b, 0xd3c36113404ea4a9 },  // 5^-4
+		{ 0x83126e978d4fdf3b, 0x645a1cac083126ea },  // 5^-3
+		{ 0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4 },  // 5^-2
+		{ 0xcccccccccccccccc, 0xcccccccccccccccd },  // 5^-1
+		{ 0x8000000000000000, 0x0000000000000000 },  // 5^0
+		{ 0xa000000000000000, 0x0000000000000000 },  // 5^1
+		{ 0xc800000000000000, 0x0000000000000000 },  // 5^2
+		{ 0xfa00000000000000, 0x0000000000000000 },  // 5^3
+		{ 0x9c40000000000000, 0x0000000000000000 },  // 5^4
+		{ 0xc350000000000000, 0x0000000000000000 },  // 5^5
+		{ 0xf424000000000000, 0x0000000000000000 },  // 5^6
+		{ 0x9896800000000000, 0x0000000000000000 },  // 5^7
+		{ 0xbebc200000000000, 0x0000000000000000 },  // 5^8
+		{ 0xee6b280000000000, 0x0000000000000000 },  // 5^9
+		{ 0x9502f90000000000, 0x0000000000000000 },  // 5^10
+		{ 0xba43b74000000000, 0x0000000000000000 },  // 5^11
+		{ 0xe8d4a51000000000, 0x0000000000000000 },  // 5^12
+		{ 0x9184e72a00000000, 0x0000000000000000 },  // 5^13
+		{ 0xb5e620f480000000, 0x0000000000000000 },  // 5^14
+		{ 0xe35fa931a0000000, 0x0000000000000000 },  // 5^15
+		{ 0x8e1bc9bf04000000, 0x0000000000000000 },  // 5^16
+		{ 0xb1a2bc2ec5000000, 0x0000000000000000 },  // 5^17
+		{ 0xde0b6b3a76400000, 0x0000000000000000 },  // 5^18
+		{ 0x8ac7230489e80000, 0x0000000000000000 },  // 5^19
+		{ 0xad78ebc5ac620000, 0x0000000000000000 },  // 5^20
+		{ 0xd8d726b7177a8000, 0x0000000000000000 },  // 5^21
+		{ 0x878678326eac9000, 0x0000000000000000 },  // 5^22
+		{ 0xa968163f0a57b400, 0x0000000000000000 },  // 5^23
+		{ 0xd3c21bcecceda100, 0x0000000000000000 },  // 5^24
+		{ 0x84595161401484a0, 0x0000000000000000 },  // 5^25
+		{ 0xa56fa5b99019a5c8, 0x0000000000000000 },  // 5^26
+		{ 0xcecb8f27f4200f3a, 0x0000000000000000 },  // 5^27
+		{ 0x813f3978f8940984, 0x4000000000000000 },  // 5^28
+		{ 0xa18f07d736b90be5, 0x5000000000000000 },  // 5^29
+		{ 0xc9f2c9cd04674ede, 0xa400000000000000 },  // 5^30
+		{ 0xfc6f7c4045812296, 0x4d00000000000000 },  // 5^31
+		{ 0x9dc5ada82b70b59d, 0xf020000000000000 },  // 5^32
+		{ 0xc5371912364ce305, 0x6c28000000000000 },  // 5^33
+		{ 0xf684df56c3e01bc6, 0xc732000000000000 },  // 5^34
+		{ 0x9a130b963a6c115c, 0x3c7f400000000000 },  // 5^35
+		{ 0xc097ce7bc90715b3, 0x4b9f100000000000 },  // 5^36
+		{ 0xf0bdc21abb48db20, 0x1e86d40000000000 },  // 5^37
+		{ 0x96769950b50d88f4, 0x1314448000000000 },  // 5^38
+		};
+
+		struct Uint128 {
+			uint64_t high;
+			uint64_t low;
+		};
+
+		constexpr Uint128 Multiply(uint64_t a, uint64_t b) {
+#if defined(_M_X64)
+			if (!std::is_constant_evaluated()) {
+				uint64_t high = 0;
+				uint64_t low = _umul128(a, b, &high);
+				return { high, low };
+			}
+#endif
+			uint64_t aLo = static_cast<uint32_t>(a), aHi = a >> 32;
+			uint64_t bLo = static_cast<uint32_t>(b), bHi = b >> 32;
+			uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+			uint64_t mid = (ll >> 32) + static_cast<uint32_t>(lh) + static_cast<uint32_t>(hl);
+			return { hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | static_cast<uint32_t>(ll) };
+		}
+
+		// floor(log2(10^q)) + 63
+		constexpr int Power(int q) {
+			return (((152170 + 65536) * q) >> 16) + 63;
+		}
+
+		// Eisel-Lemire for binary32. Returns the float bits (without sign) of
+		// w * 10^q for a non-zero w of at most 19 digits.
+		constexpr uint32_t ComputeFloat(int q, uint64_t w) {
+			if (w == 0 || q < SMALLEST_POWER_OF_TEN) {
+				return 0;
+			}
+			if (q > LARGEST_POWER_OF_TEN) {
+				return static_cast<uint32_t>(INFINITE_POWER) << MANTISSA_BITS;
+			}
+
+			int lz = std::countl_zero(w);
+			w <<= lz;
+
+			// Only the top MANTISSA_BITS + 3 bits of the product matter. When
+			// the bits below them are all ones the truncated table entry may be
+			// off by one in that range, so refine with the low word.
+			const uint64_t* power = POWERS_OF_FIVE[q - SMALLEST_POWER_OF_TEN];
+			constexpr uint64_t precisionMask = ~uint64_t(0) >> (MANTISSA_BITS + 3);
+			Uint128 product = Multiply(w, power[0]);
+			if ((product.high & precisionMask) == precisionMask) {
+				Uint128 second = Multiply(w, power[1]);
+				product.low += second.high;
+				if (second.high > product.low) {
+					product.high++;
+				}
+			}
+
+			int upperBit = static_cast<int>(product.high >> 63);
+			int shift = upperBit + 64 - MANTISSA_BITS - 3;
+			uint64_t mantissa = product.high >> shift;
+			int power2 = Power(q) + upperBit - lz - MIN_EXPONENT;
+
+			if (power2 <= 0) {
+				// Subnormal: shift into place, then round half up
+				if (-power2 + 1 >= 64) {
+					return 0;
+				}
+				mantissa >>= -power2 + 1;
+				mantissa += (mantissa & 1);
+				mantissa >>= 1;
+				power2 = mantissa < (uint64_t(1) << MANTISSA_BITS) ? 0 : 1;
+				return static_cast<uint32_t>(mantissa) | (static_cast<uint32_t>(power2) << MANTISSA_BITS);
+			}
+
+			// An exact product with a trailing 1 is a tie, which rounds to even.
+			// Exact products only occur for small |q|.
+			if (product.low <= 1 && q >= -17 && q <= 10 && (mantissa & 3) == 1) {
+				if ((mantissa << shift) == product.high) {
+					mantissa &= ~uint64_t(1);
+				}
+			}
+
+			mantissa += (mantissa & 1);
+			mantissa >>= 1;
+			if (mantissa >= (uint64_t(2) << MANTISSA_BITS)) {
+				mantissa = uint64_t(1) << MANTISSA_BITS;
+				power2++;
+			}
+			mantissa &= ~(uint64_t(1) << MANTISSA_BITS);
+			if (power2 >= INFINITE_POWER) {
+				return static_cast<uint32_t>(INFINITE_POWER) << MANTISSA_BITS;
+			}
+			return static_cast<uint32_t>(mantissa) | (static_cast<uint32_t>(power2) << MANTISSA_BITS);
+		}
+
+		// Fixed-size unsigned integer for the exact halfway comparison. Large
+		// enough for 114 digits scaled by the widest float exponent range.
+		class BigInt {
+		public:
+			static constexpr int LIMBS = 40;
+
+			constexpr explicit BigInt(uint64_t value) {
+				m_limbs[0] = static_cast<uint32_t>(value);
+				m_limbs[1] = static_cast<uint32_t>(value >> 32);
+				m_count = m_limbs[1] ? 2 : (m_limbs[0] ? 1 : 0);
+			}
+
+			constexpr void MultiplyAdd(uint32_t factor, uint32_t addend) {
+				uint64_t carry = addend;
+				for (int i = 0; i < m_count; i++) {
+					uint64_t v = static_cast<uint64_t>(m_limbs[i]) * factor + carry;
+					m_limbs[i] = static_cast<uint32_t>(v);
+					carry = v >> 32;
+				}
+				if (carry && m_count < LIMBS) {
+					m_limbs[m_count++] = static_cast<uint32_t>(carry);
+				}
+			}
+
+			constexpr void MultiplyPow5(int exponent) {
+				for (; exponent >= 13; exponent -= 13) {
+					MultiplyAdd(1220703125, 0);  // 5^13
+				}
+				uint32_t rest = 1;
+				for (; exponent > 0; exponent--) rest *= 5;
+				MultiplyAdd(rest, 0);
+			}
+
+			constexpr void ShiftLeft(int bits) {
+				if (m_count == 0) {
+					return;
+				}
+				int words = bits / 32;
+				int rem = bits % 32;
+				int count = m_count + words + 1;
+				if (count > LIMBS) count = LIMBS;
+				for (int i = count - 1; i >= 0; i--) {
+					int src = i - words;
+					uint64_t hi = src >= 0 && src < m_count ? m_limbs[src] : 0;
+					uint64_t lo = src - 1 >= 0 && src - 1 < m_count ? m_limbs[src - 1] : 0;
+					m_limbs[i] = static_cast<uint32_t>(((hi << 32 | lo) << rem) >> 32);
+				}
+				m_count = count;
+				while (m_count > 0 && m_limbs[m_count - 1] == 0) m_count--;
+			}
+
+			constexpr int Compare(const BigInt& other) const {
+				if (m_count != other.m_count) {
+					return m_count < other.m_count ? -1 : 1;
+				}
+				for (int i = m_count - 1; i >= 0; i--) {
+					if (m_limbs[i] != other.m_limbs[i]) {
+						return m_limbs[i] < other.m_limbs[i] ? -1 : 1;
+					}
+				}
+				return 0;
+			}
+
+		private:
+			uint32_t m_limbs[LIMBS] = {};
+			int m_count = 0;
+		};
+
+		template <typename Char>
+		constexpr bool IsDigit(Char c) { return c >= '0' && c <= '9'; }
+
+		// Re-reads all digits and rounds the float with bits 'lower' or the
+		// next one up, by comparing the exact decimal value with the midpoint.
+		template <typename Char>
+		constexpr uint32_t ResolveHalfway(const Char* p, const Char* last, int explicitExponent, uint32_t lower) {
+			BigInt digits(0);
+			int kept = 0;
+			int scale = explicitExponent;
+			bool sticky = false;
+			bool fraction = false;
+			for (; p != last; p++) {
+				if (*p == '.') {
+					if (fraction) break;
+					fraction = true;
+					continue;
+				}
+				if (!IsDigit(*p)) break;
+				if (kept == 0 && *p == '0') {
+					if (fraction) scale--;
+				}
+				else if (kept < MAX_EXACT_DIGITS) {
+					digits.MultiplyAdd(10, static_cast<uint32_t>(*p - '0'));
+					kept++;
+					if (fraction) scale--;
+				}
+				else {
+					sticky = sticky || *p != '0';
+					if (!fraction) scale++;
+				}
+			}
+
+			// lower = m * 2^e, midpoint = (2m + 1) * 2^(e - 1)
+			uint32_t biased = lower >> MANTISSA_BITS;
+			uint64_t m = lower & ((uint32_t(1) << MANTISSA_BITS) - 1);
+			int e = -149;
+			if (biased != 0) {
+				m |= uint64_t(1) << MANTISSA_BITS;
+				e = static_cast<int>(biased) - 150;
+			}
+			BigInt midpoint(2 * m + 1);
+			int midpointExponent = e - 1;
+
+			// digits * 5^scale * 2^scale against midpoint * 2^midpointExponent
+			if (scale >= 0) digits.MultiplyPow5(scale);
+			else midpoint.MultiplyPow5(-scale);
+			if (scale >= midpointExponent) digits.ShiftLeft(scale - midpointExponent);
+			else midpoint.ShiftLeft(midpointExponent - scale);
+
+			int order = digits.Compare(midpoint);
+			if (order > 0 || (order == 0 && sticky) || (order == 0 && (m & 1))) {
+				return lower + 1;
+			}
+			return lower;
+		}
+	}
+
+	// Parses a number starting at first. Returns the position after it, or
+	// null if no number starts there. last may be null for NUL-terminated
+	// input, where the terminator ends the number.
+	template <typename Char>
+	constexpr const Char* ParseFloat(const Char* first, const Char* last, float& out) {
+		using Detail::IsDigit;
+
+		const Char* p = first;
+		bool negative = false;
+		if (p != last && (*p == '-' || *p == '+')) {
+			negative = (*p == '-');
+			p++;
+		}
+
+		const Char* digitsBegin = p;
+		uint64_t mantissa = 0;
+		int exponent = 0;
+		int significant = 0;
+		bool anyDigits = false;
+		bool truncated = false;
+
+		for (; p != last && IsDigit(*p); p++) {
+			anyDigits = true;
+			if (significant < Detail::MAX_DIGITS) {
+				if (mantissa != 0 || *p != '0') significant++;
+				mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+			}
+			else {
+				truncated = truncated || *p != '0';
+				exponent++;
+			}
+		}
+		if (p != last && *p == '.') {
+			p++;
+			for (; p != last && IsDigit(*p); p++) {
+				anyDigits = true;
+				if (significant < Detail::MAX_DIGITS) {
+					if (mantissa != 0 || *p != '0') significant++;
+					mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+					exponent--;
+				}
+				else {
+					truncated = truncated || *p != '0';
+				}
+			}
+		}
+		if (!anyDigits) {
+			return nullptr;
+		}
+
+		int explicitExponent = 0;
+		if (p != last && (*p == 'e' || *p == 'E')) {
+			const Char* e = p + 1;
+			bool expNegative = false;
+			if (e != last && (*e == '-' || *e == '+')) {
+				expNegative = (*e == '-');
+				e++;
+			}
+			if (e != last && IsDigit(*e)) {
+				for (; e != last && IsDigit(*e); e++) {
+					if (explicitExponent < Detail::MAX_EXPONENT_VALUE) {
+						explicitExponent = explicitExponent * 10 + static_cast<int>(*e - '0');
+					}
+				}
+				if (expNegative) explicitExponent = -explicitExponent;
+				exponent += explicitExponent;
+				p = e;
+			}
+		}
+
+		uint32_t bits = 0;
+		constexpr float exactPowers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+		if (!truncated && mantissa <= (uint64_t(1) << 24) && exponent >= -10 && exponent <= 10) {
+			// Clinger: both operands are exact floats, so one operation rounds correctly
+			float value = static_cast<float>(mantissa);
+			value = exponent < 0 ? value / exactPowers[-exponent] : value * exactPowers[exponent];
+			bits = std::bit_cast<uint32_t>(value);
+		}
+		else {
+			bits = Detail::ComputeFloat(exponent, mantissa);
+			if (truncated && bits != Detail::ComputeFloat(exponent, mantissa + 1)) {
+				bits = Detail::ResolveHalfway(digitsBegin, last, explicitExponent, bits);
+			}
+		}
+
+		if (negative) {
+			bits |= uint32_t(1) << 31;
+		}
+		out = std::bit_cast<float>(bits);
+		return p;
+	}
+
+	template <typename Char>
+	constexpr const Char* ParseFloat(const Char* first, float& out) {
+		return ParseFloat(first, static_cast<const Char*>(nullptr), out);
+	}
+}
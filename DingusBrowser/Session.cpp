@@ -0,0 +1,165 @@
+#include "Session.h"
+
+#include <cstring>
+
+namespace Session {
+
+	namespace {
+		constexpr char MAGIC[4] = { 'D', 'S', 'E', 'S' };
+		constexpr uint32_t VERSION = 1;
+
+		// Smallest encoded tab: scroll position and two empty strings
+		constexpr size_t MIN_TAB_SIZE = 12;
+	}
+
+	void Writer::U32(uint32_t value) {
+		char bytes[4] = {
+			static_cast<char>(value), static_cast<char>(value >> 8),
+			static_cast<char>(value >> 16), static_cast<char>(value >> 24)
+		};
+		m_out.append(bytes, 4);
+	}
+
+	void Writer::String(std::wstring_view text) {
+		// Count UTF-16 units first so the length can lead
+		uint32_t units = 0;
+		for (wchar_t c : text) {
+			units += static_cast<uint32_t>(c) > 0xFFFF ? 2 : 1;
+		}
+		U32(units);
+
+		for (wchar_t c : text) {
+			uint32_t code = static_cast<uint32_t>(c);
+			if (code > 0xFFFF) {
+				// Only reached where wchar_t holds whole code points
+				code -= 0x10000;
+				uint16_t pair[2] = { static_cast<uint16_t>(0xD800 + (code >> 10)), static_cast<uint16_t>(0xDC00 + (code & 0x3FF)) };
+				for (uint16_t unit : pair) {
+					char bytes[2] = { static_cast<char>(unit), static_cast<char>(unit >> 8) };
+					m_out.append(bytes, 2);
+				}
+			}
+			else {
+				char bytes[2] = { static_cast<char>(code), static_cast<char>(code >> 8) };
+				m_out.append(bytes, 2);
+			}
+		}
+	}
+
+	bool Reader::U32(uint32_t& value) {
+		if (Remaining() < 4) {
+			return false;
+		}
+		const auto* p = reinterpret_cast<const uint8_t*>(m_data.data() + m_position);
+		value = p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+		m_position += 4;
+		return true;
+	}
+
+	bool Reader::I32(int32_t& value) {
+		uint32_t bits;
+		if (!U32(bits)) {
+			return false;
+		}
+		value = static_cast<int32_t>(bits);
+		return true;
+	}
+
+	bool Reader::String(std::wstring& text) {
+		uint32_t units;
+		if (!U32(units) || units > Remaining() / 2) {
+			return false;
+		}
+
+		const auto* p = reinterpret_cast<const uint8_t*>(m_data.data() + m_position);
+		text.clear();
+		text.reserve(units);
+		for (uint32_t i = 0; i < units; i++) {
+			uint32_t unit = p[i * 2] | (p[i * 2 + 1] << 8);
+			if constexpr (sizeof(wchar_t) > 2) {
+				// Join surrogate pairs back into code points
+				if (unit >= 0xD800 && unit <= 0xDBFF && i + 1 < units) {
+					uint32_t low = p[i * 2 + 2] | (p[i * 2 + 3] << 8);
+					if (low >= 0xDC00 && low <= 0xDFFF) {
+						unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+						i++;
+					}
+				}
+			}
+			text.push_back(static_cast<wchar_t>(unit));
+		}
+		m_position += static_cast<size_t>(units) * 2;
+		return true;
+	}
+
+	bool Reader::Bytes(void* data, size_t size) {
+		if (Remaining() < size) {
+			return false;
+		}
+		std::memcpy(data, m_data.data() + m_position, size);
+		m_position += size;
+		return true;
+	}
+
+	std::string Encode(const State& state) {
+		std::string out;
+		Writer writer(out);
+		writer.Bytes(MAGIC, sizeof(MAGIC));
+		writer.U32(VERSION);
+		writer.U32(static_cast<uint32_t>(state.tabs.size()));
+		writer.I32(state.active);
+		for (const Tab& tab : state.tabs) {
+			writer.I32(tab.scrollY);
+			writer.String(tab.url);
+			writer.String(tab.title);
+		}
+		return out;
+	}
+
+	bool Decode(std::string_view data, State& out) {
+		Reader reader(data);
+		char magic[4];
+		uint32_t version, count;
+		State state;
+		if (!reader.Bytes(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+			!reader.U32(version) || version != VERSION ||
+			!reader.U32(count) || count > reader.Remaining() / MIN_TAB_SIZE ||
+			!reader.I32(state.active)) {
+			return false;
+		}
+
+		state.tabs.resize(count);
+		for (Tab& tab : state.tabs) {
+			if (!reader.I32(tab.scrollY) || !reader.String(tab.url) || !reader.String(tab.title)) {
+				return false;
+			}
+		}
+		if (reader.Remaining() != 0) {
+			return false;
+		}
+
+		if (state.active < 0 || state.active >= static_cast<int32_t>(count)) {
+			state.active = count ? 0 : -1;
+		}
+		out = std::move(state);
+		return true;
+	}
+
+	std::vector<int> PrefetchOrder(int tabCount, int active, int budget) {
+		std::vector<int> order;
+		for (int distance = 1; static_cast<int>(order.size()) < budget; distance++) {
+			bool right = active + distance < tabCount;
+			bool left = active - distance >= 0;
+			if (!right && !left) {
+				break;
+			}
+			if (right) {
+				order.push_back(active + distance);
+			}
+			if (left && static_cast<int>(order.size()) < budget) {
+				order.push_back(active - distance);
+			}
+		}
+		return order;
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Saved browsing session.
+//
+// The tab strip as it was when the session was saved: each tab's URL, title
+// and scroll position, plus which tab was showing. Encode and Decode turn it
+// into a small little-endian binary blob with strings stored as UTF-16 code
+// units, whatever the size of wchar_t. Kept free of Win32 so it can be
+// exercised outside the browser.
+namespace Session {
+
+	struct Tab {
+		std::wstring url;
+		std::wstring title;
+		int32_t scrollY = 0;
+	};
+
+	struct State {
+		std::vector<Tab> tabs;
+		int32_t active = -1;
+	};
+
+	std::string Encode(const State& state);
+
+	// False for anything that is not a complete, well-formed session; out is
+	// only written on success
+	bool Decode(std::string_view data, State& out);
+
+	// Tabs to load ahead of use after restoring: the ones next to the active
+	// tab, nearest first, alternating right and left, at most budget of them
+	std::vector<int> PrefetchOrder(int tabCount, int active, int budget);
+
+	// Little-endian field writer and reader shared by the session formats
+	class Writer {
+	public:
+		explicit Writer(std::string& out) : m_out(out) {}
+
+		void U32(uint32_t value);
+		void I32(int32_t value) { U32(static_cast<uint32_t>(value)); }
+		void String(std::wstring_view text);
+		void Bytes(const void* data, size_t size) { m_out.append(static_cast<const char*>(data), size); }
+
+	private:
+		std::string& m_out;
+	};
+
+	class Reader {
+	public:
+		explicit Reader(std::string_view data) : m_data(data) {}
+
+		bool U32(uint32_t& value);
+		bool I32(int32_t& value);
+		bool String(std::wstring& text);
+		bool Bytes(void* data, size_t size);
+
+		size_t Remaining() const { return m_data.size() - m_position; }
+
+	private:
+		std::string_view m_data;
+		size_t m_position = 0;
+	};
+}
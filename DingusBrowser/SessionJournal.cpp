@@ -0,0 +1,335 @@
+#include "SessionJournal.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace SessionJournal {
+
+	namespace {
+		constexpr size_t FRAME_HEADER_SIZE = 8;  // Payload length, then its CRC
+
+		// Longer than any real record; a bigger length is a corrupt header
+		constexpr uint32_t MAX_PAYLOAD = 256 * 1024 * 1024;
+
+		// Slicing-by-8: table k gives the CRC of a byte followed by k zero
+		// bytes, so eight bytes are folded in with eight lookups
+		using CrcTables = std::array<std::array<uint32_t, 256>, 8>;
+
+		constexpr CrcTables MakeCrcTables() {
+			CrcTables tables{};
+			for (uint32_t i = 0; i < 256; i++) {
+				uint32_t crc = i;
+				for (int bit = 0; bit < 8; bit++) {
+					crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0);
+				}
+				tables[0][i] = crc;
+			}
+			for (size_t k = 1; k < tables.size(); k++) {
+				for (uint32_t i = 0; i < 256; i++) {
+					uint32_t previous = tables[k - 1][i];
+					tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+				}
+			}
+			return tables;
+		}
+
+		constexpr CrcTables CRC_TABLES = MakeCrcTables();
+
+		std::string EncodePayload(const Record& record) {
+			std::string payload;
+			Session::Writer writer(payload);
+			uint8_t type = static_cast<uint8_t>(record.type);
+			writer.Bytes(&type, 1);
+
+			switch (record.type) {
+			case RecordType::Snapshot:
+				writer.U32(static_cast<uint32_t>(record.snapshotIds.size()));
+				for (uint32_t id : record.snapshotIds) {
+					writer.U32(id);
+				}
+				payload += Session::Encode(record.snapshot);
+				break;
+			case RecordType::Navigated:
+			case RecordType::TitleChanged:
+				writer.U32(record.tab);
+				writer.String(record.text);
+				break;
+			case RecordType::Opened:
+			case RecordType::Scrolled:
+			case RecordType::Moved:
+				writer.U32(record.tab);
+				writer.I32(record.value);
+				break;
+			case RecordType::Closed:
+			case RecordType::Activated:
+				writer.U32(record.tab);
+				break;
+			}
+			return payload;
+		}
+
+		bool DecodePayload(std::string_view payload, Record& record) {
+			Session::Reader reader(payload);
+			uint8_t type;
+			if (!reader.Bytes(&type, 1)) {
+				return false;
+			}
+			record.type = static_cast<RecordType>(type);
+
+			switch (record.type) {
+			case RecordType::Snapshot: {
+				uint32_t count;
+				if (!reader.U32(count) || count > reader.Remaining() / 4) {
+					return false;
+				}
+				record.snapshotIds.resize(count);
+				for (uint32_t& id : record.snapshotIds) {
+					reader.U32(id);
+				}
+				return Session::Decode(payload.substr(payload.size() - reader.Remaining()), record.snapshot) &&
+					record.snapshot.tabs.size() == count;
+			}
+			case RecordType::Navigated:
+			case RecordType::TitleChanged:
+				return reader.U32(record.tab) && reader.String(record.text) && reader.Remaining() == 0;
+			case RecordType::Opened:
+			case RecordType::Scrolled:
+			case RecordType::Moved:
+				return reader.U32(record.tab) && reader.I32(record.value) && reader.Remaining() == 0;
+			case RecordType::Closed:
+			case RecordType::Activated:
+				return reader.U32(record.tab) && reader.Remaining() == 0;
+			}
+			return false;
+		}
+
+		int ClampPosition(int32_t position, size_t count) {
+			return std::clamp(position, 0, static_cast<int32_t>(count));
+		}
+	}
+
+	uint32_t Crc32(const void* data, size_t size) {
+		const auto* p = static_cast<const uint8_t*>(data);
+		const CrcTables& t = CRC_TABLES;
+		uint32_t crc = 0xFFFFFFFF;
+		for (; size >= 8; size -= 8, p += 8) {
+			uint32_t low = crc ^ (p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24);
+			crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+				t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+		}
+		for (; size > 0; size--, p++) {
+			crc = t[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+	int Model::Find(uint32_t tab) const {
+		auto it = std::find(ids.begin(), ids.end(), tab);
+		return it == ids.end() ? -1 : static_cast<int>(it - ids.begin());
+	}
+
+	uint32_t Model::NextId() const {
+		return ids.empty() ? 1 : *std::max_element(ids.begin(), ids.end()) + 1;
+	}
+
+	void Model::Apply(Record&& record) {
+		if (record.type == RecordType::Snapshot) {
+			state = std::move(record.snapshot);
+			ids = std::move(record.snapshotIds);
+			return;
+		}
+		Apply(static_cast<const Record&>(record));
+	}
+
+	void Model::Apply(const Record& record) {
+		if (record.type == RecordType::Snapshot) {
+			state = record.snapshot;
+			ids = record.snapshotIds;
+			return;
+		}
+
+		int index = Find(record.tab);
+		if (record.type == RecordType::Opened) {
+			if (index < 0) {
+				int position = ClampPosition(record.value, ids.size());
+				ids.insert(ids.begin() + position, record.tab);
+				state.tabs.insert(state.tabs.begin() + position, Session::Tab());
+				if (state.active >= position) {
+					state.active++;
+				}
+			}
+			return;
+		}
+		if (index < 0) {
+			return;
+		}
+
+		Session::Tab& tab = state.tabs[index];
+		switch (record.type) {
+		case RecordType::Navigated:
+			tab.url = record.text;
+			tab.scrollY = 0;
+			break;
+		case RecordType::TitleChanged:
+			tab.title = record.text;
+			break;
+		case RecordType::Scrolled:
+			tab.scrollY = record.value;
+			break;
+		case RecordType::Closed:
+			ids.erase(ids.begin() + index);
+			state.tabs.erase(state.tabs.begin() + index);
+			if (state.active > index || state.active >= static_cast<int32_t>(ids.size())) {
+				state.active--;
+			}
+			break;
+		case RecordType::Moved: {
+			bool wasActive = state.active == index;
+			Session::Tab moved = std::move(tab);
+			ids.erase(ids.begin() + index);
+			state.tabs.erase(state.tabs.begin() + index);
+			if (state.active > index) {
+				state.active--;
+			}
+
+			int position = ClampPosition(record.value, ids.size());
+			ids.insert(ids.begin() + position, record.tab);
+			state.tabs.insert(state.tabs.begin() + position, std::move(moved));
+			if (wasActive) {
+				state.active = position;
+			}
+			else if (state.active >= position) {
+				state.active++;
+			}
+			break;
+		}
+		case RecordType::Activated:
+			state.active = index;
+			break;
+		default:
+			break;
+		}
+	}
+
+	void AppendFrame(std::string& out, const Record& record) {
+		std::string payload = EncodePayload(record);
+		Session::Writer writer(out);
+		writer.U32(static_cast<uint32_t>(payload.size()));
+		writer.U32(Crc32(payload.data(), payload.size()));
+		out += payload;
+	}
+
+	size_t Replay(std::string_view data, Model& model) {
+		size_t position = 0;
+		while (data.size() - position >= FRAME_HEADER_SIZE) {
+			Session::Reader reader(data.substr(position));
+			uint32_t length, crc;
+			reader.U32(length);
+			reader.U32(crc);
+			if (length > MAX_PAYLOAD || length > reader.Remaining()) {
+				break;
+			}
+
+			std::string_view payload = data.substr(position + FRAME_HEADER_SIZE, length);
+			Record record;
+			if (Crc32(payload.data(), payload.size()) != crc || !DecodePayload(payload, record)) {
+				break;
+			}
+			model.Apply(std::move(record));
+			position += FRAME_HEADER_SIZE + length;
+		}
+		return position;
+	}
+
+	Writer::Writer(Storage& storage, Model model, size_t compactAfter)
+		: m_storage(storage), m_model(std::move(model)), m_compactAfter(compactAfter), m_thread([this] { Run(); }) {}
+
+	Writer::~Writer() {
+		{
+			std::lock_guard lock(m_mutex);
+			m_stopping = true;
+		}
+		m_wake.notify_one();
+		m_thread.join();
+	}
+
+	void Writer::Write(Record record) {
+		{
+			std::lock_guard lock(m_mutex);
+			m_queue.push_back(std::move(record));
+		}
+		m_wake.notify_one();
+	}
+
+	WriterStats Writer::Stats() const {
+		std::lock_guard lock(m_mutex);
+		return m_stats;
+	}
+
+	void Writer::Run() {
+		bool healthy = Compact();
+
+		std::vector<Record> batch;
+		std::string frames;
+		for (;;) {
+			{
+				std::unique_lock lock(m_mutex);
+				m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+				if (m_queue.empty()) {
+					break;
+				}
+				batch.swap(m_queue);
+			}
+
+			frames.clear();
+			for (const Record& record : batch) {
+				m_model.Apply(record);
+				AppendFrame(frames, record);
+			}
+
+			// After a failed write the file may end in a partial frame that would
+			// hide everything appended behind it, so rewrite it whole instead
+			bool appended = healthy && m_storage.Append(frames);
+			if (appended) {
+				m_journalSize += frames.size();
+			}
+			{
+				std::lock_guard lock(m_mutex);
+				m_stats.records += batch.size();
+				m_stats.batches++;
+				m_stats.failures += healthy && !appended;
+			}
+			batch.clear();
+
+			if (!appended || m_journalSize - m_snapshotSize > std::max(m_compactAfter, m_snapshotSize)) {
+				healthy = Compact();
+			}
+		}
+
+		// A failure on the last batch leaves the journal behind the model;
+		// try once more rather than exit with the tail lost
+		if (!healthy) {
+			Compact();
+		}
+	}
+
+	bool Writer::Compact() {
+		Record snapshot;
+		snapshot.type = RecordType::Snapshot;
+		snapshot.snapshot = m_model.state;
+		snapshot.snapshotIds = m_model.ids;
+
+		std::string frame;
+		AppendFrame(frame, snapshot);
+		bool replaced = m_storage.Replace(frame);
+		if (replaced) {
+			m_journalSize = m_snapshotSize = frame.size();
+		}
+
+		std::lock_guard lock(m_mutex);
+		m_stats.compactions += replaced;
+		m_stats.failures += !replaced;
+		return replaced;
+	}
+}
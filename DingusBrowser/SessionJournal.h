@@ -0,0 +1,125 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Session.h"
+
+// Append-only session journal.
+//
+// Instead of rewriting the whole session on exit, every change to the tab
+// strip is appended as a small record. Each record is framed as
+// [length][CRC-32][payload], so a write torn by a crash or power loss only
+// loses that last record: replay stops at the first frame that is short or
+// fails its checksum. A journal starts with a snapshot record and is
+// periodically compacted back into a single snapshot. JournalWriter does all
+// encoding and file work on its own thread; the UI thread only queues records.
+namespace SessionJournal {
+
+	enum class RecordType : uint8_t {
+		Snapshot = 1,  // Whole session; replaces everything before it
+		Opened,        // New empty tab at position
+		Navigated,     // text is the URL
+		TitleChanged,  // text is the title
+		Scrolled,      // value is the scroll position
+		Closed,
+		Moved,         // value is the new position
+		Activated
+	};
+
+	struct Record {
+		RecordType type = RecordType::Opened;
+		uint32_t tab = 0;
+		int32_t value = 0;
+		std::wstring text;
+
+		// Snapshot only
+		Session::State snapshot;
+		std::vector<uint32_t> snapshotIds;
+	};
+
+	// The session being journaled, with each tab's journal id
+	struct Model {
+		Session::State state;
+		std::vector<uint32_t> ids;  // Parallel to state.tabs
+
+		// Records that name a tab the model doesn't have are ignored
+		void Apply(const Record& record);
+		// Takes a snapshot's tabs instead of copying them
+		void Apply(Record&& record);
+
+		int Find(uint32_t tab) const;
+		uint32_t NextId() const;
+	};
+
+	uint32_t Crc32(const void* data, size_t size);
+
+	// Appends record to out as one framed, checksummed frame
+	void AppendFrame(std::string& out, const Record& record);
+
+	// Applies every intact frame from the start of data to model and returns
+	// the length of that intact prefix
+	size_t Replay(std::string_view data, Model& model);
+
+	// Where the journal lives. Only ever called from the writer thread.
+	class Storage {
+	public:
+		virtual ~Storage() = default;
+
+		virtual bool Append(std::string_view data) = 0;
+
+		// Swaps in data as the whole journal, so a crash leaves either the old
+		// journal or the new one
+		virtual bool Replace(std::string_view data) = 0;
+	};
+
+	struct WriterStats {
+		uint64_t records = 0;
+		uint64_t batches = 0;
+		uint64_t compactions = 0;
+		uint64_t failures = 0;
+	};
+
+	class Writer {
+	public:
+		// Starts by compacting model into a fresh snapshot, which also drops
+		// any torn tail left by the last run
+		Writer(Storage& storage, Model model, size_t compactAfter = 64 * 1024);
+
+		// Writes everything still queued, with one more try if the last write
+		// failed, then stops the thread
+		~Writer();
+
+		Writer(const Writer&) = delete;
+		Writer& operator=(const Writer&) = delete;
+
+		// Queues a record; never waits on the storage
+		void Write(Record record);
+
+		WriterStats Stats() const;
+
+	private:
+		void Run();
+		bool Compact();
+
+		Storage& m_storage;
+		Model m_model;             // Writer thread only
+		size_t m_compactAfter;
+		size_t m_journalSize = 0;  // Writer thread only
+		size_t m_snapshotSize = 0; // Writer thread only
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::vector<Record> m_queue;
+		bool m_stopping = false;
+		WriterStats m_stats;
+
+		std::thread m_thread;
+	};
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Generational slot map.
+//
+// Values live packed in a dense array; a handle names a slot, and the slot
+// says where its value currently is. Insert, Erase and Get are O(1). Every
+// erase bumps the slot's generation, so a handle kept by an async callback
+// after its value was erased is rejected rather than pointing at whatever
+// reuses the slot. Pointers from Get are only good until the next Insert or
+// Erase; keep the handle instead.
+
+struct SlotHandle {
+	uint32_t index = 0;
+	uint32_t generation = 0;  // 0 is never live, so a default handle is null
+
+	bool IsNull() const { return generation == 0; }
+
+	bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+template <typename Value>
+class SlotMap {
+public:
+	SlotHandle Insert(Value value) {
+		uint32_t slotIndex;
+		if (m_freeHead != NO_SLOT) {
+			slotIndex = m_freeHead;
+			m_freeHead = m_slots[slotIndex].position;
+		}
+		else {
+			slotIndex = static_cast<uint32_t>(m_slots.size());
+			m_slots.push_back({ 1, 0 });
+		}
+
+		Slot& slot = m_slots[slotIndex];
+		slot.position = static_cast<uint32_t>(m_values.size());
+		m_values.push_back(std::move(value));
+		m_owners.push_back(slotIndex);
+		return { slotIndex, slot.generation };
+	}
+
+	// Returns false if the handle was already stale
+	bool Erase(SlotHandle handle) {
+		if (!Contains(handle)) {
+			return false;
+		}
+
+		// Move the last value into the hole so the values stay packed
+		Slot& slot = m_slots[handle.index];
+		uint32_t position = slot.position;
+		uint32_t last = static_cast<uint32_t>(m_values.size()) - 1;
+		if (position != last) {
+			m_values[position] = std::move(m_values[last]);
+			m_owners[position] = m_owners[last];
+			m_slots[m_owners[position]].position = position;
+		}
+		m_values.pop_back();
+		m_owners.pop_back();
+
+		// Skip 0 on wrap so the slot can never hand out a null handle
+		slot.generation = slot.generation + 1 ? slot.generation + 1 : 1;
+		slot.position = m_freeHead;
+		m_freeHead = handle.index;
+		return true;
+	}
+
+	bool Contains(SlotHandle handle) const {
+		return handle.index < m_slots.size() && !handle.IsNull() && m_slots[handle.index].generation == handle.generation &&
+			IsLive(handle.index);
+	}
+
+	// Null for stale handles
+	Value* Get(SlotHandle handle) { return Contains(handle) ? &m_values[m_slots[handle.index].position] : nullptr; }
+	const Value* Get(SlotHandle handle) const { return Contains(handle) ? &m_values[m_slots[handle.index].position] : nullptr; }
+
+	size_t Size() const { return m_values.size(); }
+	bool Empty() const { return m_values.empty(); }
+
+	// Live values in no particular order, with their handles
+	Value& ValueAt(size_t position) { return m_values[position]; }
+	const Value& ValueAt(size_t position) const { return m_values[position]; }
+	SlotHandle HandleAt(size_t position) const {
+		uint32_t slotIndex = m_owners[position];
+		return { slotIndex, m_slots[slotIndex].generation };
+	}
+
+	auto begin() { return m_values.begin(); }
+	auto end() { return m_values.end(); }
+	auto begin() const { return m_values.begin(); }
+	auto end() const { return m_values.end(); }
+
+private:
+	static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+	struct Slot {
+		uint32_t generation;
+		uint32_t position;  // Index into m_values while live, next free slot otherwise
+	};
+
+	// The generation check already rejects every handle this map handed out
+	// for a freed slot; this also rejects made-up handles that match one
+	bool IsLive(uint32_t slotIndex) const {
+		uint32_t position = m_slots[slotIndex].position;
+		return position < m_owners.size() && m_owners[position] == slotIndex;
+	}
+
+	std::vector<Slot> m_slots;
+	std::vector<Value> m_values;
+	std::vector<uint32_t> m_owners;  // Slot of each value
+	uint32_t m_freeHead = NO_SLOT;
+};
@@ -0,0 +1,143 @@
+#include "SoftwareCanvas.h"
+
+#include <cmath>
+#include <utility>
+
+namespace {
+	constexpr int CORNER_SEGMENTS = 8;
+
+	uint8_t Red(uint32_t color) { return static_cast<uint8_t>(color); }
+	uint8_t Green(uint32_t color) { return static_cast<uint8_t>(color >> 8); }
+	uint8_t Blue(uint32_t color) { return static_cast<uint8_t>(color >> 16); }
+
+	// Adds a rounded rectangle outline as a closed polygon. Clockwise when
+	// reverse is false; the reversed ring cancels the inside of an outer one.
+	void AddRoundRect(IconRaster::CoverageRasterizer& rasterizer,
+		float left, float top, float right, float bottom, float radius, bool reverse) {
+		const float halfPi = 1.57079632679f;
+		float cx[4] = { right - radius, right - radius, left + radius, left + radius };
+		float cy[4] = { top + radius, bottom - radius, bottom - radius, top + radius };
+
+		Svg::Point points[4 * (CORNER_SEGMENTS + 1)];
+		int count = 0;
+		for (int corner = 0; corner < 4; corner++) {
+			// Corners in clockwise order, starting at the top right
+			float start = (corner - 1) * halfPi;
+			for (int i = 0; i <= CORNER_SEGMENTS; i++) {
+				float angle = start + halfPi * i / CORNER_SEGMENTS;
+				points[count++] = { cx[corner] + radius * std::cos(angle), cy[corner] + radius * std::sin(angle) };
+			}
+		}
+
+		for (int i = 0; i < count; i++) {
+			Svg::Point a = points[i];
+			Svg::Point b = points[(i + 1) % count];
+			if (reverse) std::swap(a, b);
+			rasterizer.AddLine(a.x, a.y, b.x, b.y);
+		}
+	}
+}
+
+SoftwareCanvas::SoftwareCanvas(int width, int height, int iconSize, IconMaskSource icons)
+	: m_width(width), m_height(height), m_iconSize(iconSize), m_icons(std::move(icons)),
+	m_pixels(static_cast<size_t>(width) * height, 0) {}
+
+void SoftwareCanvas::FillRect(const ChromeRect& rect, uint32_t color) {
+	int left = rect.left < 0 ? 0 : rect.left;
+	int top = rect.top < 0 ? 0 : rect.top;
+	int right = rect.right > m_width ? m_width : rect.right;
+	int bottom = rect.bottom > m_height ? m_height : rect.bottom;
+
+	uint32_t pixel = 0xFF000000u | (static_cast<uint32_t>(Red(color)) << 16) |
+		(static_cast<uint32_t>(Green(color)) << 8) | Blue(color);
+	for (int y = top; y < bottom; y++) {
+		uint32_t* row = &m_pixels[static_cast<size_t>(y) * m_width];
+		for (int x = left; x < right; x++) {
+			row[x] = pixel;
+		}
+	}
+}
+
+void SoftwareCanvas::FrameRoundRect(const ChromeRect& rect, int radius, uint32_t color) {
+	int width = rect.Width();
+	int height = rect.Height();
+	if (width <= 0 || height <= 0) {
+		return;
+	}
+
+	float r = static_cast<float>(radius);
+	float w = static_cast<float>(width);
+	float h = static_cast<float>(height);
+	m_rasterizer.Reset(width, height);
+	AddRoundRect(m_rasterizer, 0, 0, w, h, r, false);
+	if (width > 2 && height > 2) {
+		AddRoundRect(m_rasterizer, 1, 1, w - 1, h - 1, r > 1 ? r - 1 : 0, true);
+	}
+
+	m_mask.resize(static_cast<size_t>(width) * height);
+	m_rasterizer.Resolve(m_mask.data(), width);
+	BlendMask(m_mask.data(), width, height, width, rect.left, rect.top, color);
+}
+
+void SoftwareCanvas::DrawTextLine(std::wstring_view text, const ChromeRect& rect, uint32_t color) {
+	if (!m_text) {
+		return;
+	}
+
+	GlyphAtlas& atlas = m_text->Atlas();
+	const TextRun& run = m_text->Layout(text);
+	int count = run.FitCount(rect.Width(), m_text->EllipsisWidth());
+	int baseline = rect.top + (rect.Height() - atlas.Source().LineHeight()) / 2 + atlas.Source().Ascent();
+
+	// Clip glyphs to rect the way DrawText does
+	ChromeRect clip = rect;
+	if (clip.left < 0) clip.left = 0;
+	if (clip.right > m_width) clip.right = m_width;
+
+	auto drawGlyph = [&](uint32_t codePoint, int pen) {
+		const AtlasGlyph* glyph = atlas.Get(codePoint);
+		if (!glyph || glyph->metrics.width == 0) {
+			return;
+		}
+		const GlyphMetrics& m = glyph->metrics;
+		int x = rect.left + pen + m.left;
+		int y = baseline - m.top;
+		int skip = x < clip.left ? clip.left - x : 0;
+		int width = x + m.width > clip.right ? clip.right - x : m.width;
+		if (skip >= width) {
+			return;
+		}
+		BlendMask(atlas.Pixels() + static_cast<size_t>(glyph->y) * atlas.Width() + glyph->x + skip,
+			width - skip, m.height, atlas.Width(), x + skip, y, color);
+	};
+
+	for (int i = 0; i < count; i++) {
+		drawGlyph(run.codePoints[i], run.offsets[i]);
+	}
+	if (count < run.Count()) {
+		drawGlyph(TextRunCache::ELLIPSIS, run.offsets[count]);
+	}
+}
+
+void SoftwareCanvas::DrawIcon(int iconId, int x, int y, uint32_t color) {
+	const uint8_t* mask = m_icons ? m_icons(iconId) : nullptr;
+	if (mask) {
+		BlendMask(mask, m_iconSize, m_iconSize, m_iconSize, x, y, color);
+	}
+}
+
+void SoftwareCanvas::BlendMask(const uint8_t* mask, int maskWidth, int maskHeight, int maskStride, int x, int y, uint32_t color) {
+	int left = x < 0 ? -x : 0;
+	int top = y < 0 ? -y : 0;
+	int right = x + maskWidth > m_width ? m_width - x : maskWidth;
+	int bottom = y + maskHeight > m_height ? m_height - y : maskHeight;
+	if (left >= right) {
+		return;
+	}
+
+	for (int row = top; row < bottom; row++) {
+		IconRaster::BlendCoverage(mask + static_cast<size_t>(row) * maskStride + left,
+			&m_pixels[static_cast<size_t>(y + row) * m_width + x + left], right - left,
+			Red(color), Green(color), Blue(color));
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "ChromeCanvas.h"
+#include "IconRaster.h"
+#include "TextRunCache.h"
+
+// In-memory chrome canvas.
+//
+// Renders into an opaque 32-bit pixel buffer in the same BGRA layout as a
+// GDI DIB section, using the coverage rasterizer for anti-aliased shapes.
+// Needs no window or display, so chrome painting can be reproduced and
+// timed off-screen. Icons come from a caller-supplied mask source; text is
+// drawn only when a text run cache is attached. The browser itself paints
+// with GdiCanvas; this is built by the CMake project for SoftwareCanvasTests
+// and ChromePaintBench.
+class SoftwareCanvas : public ChromeCanvas {
+public:
+	// Returns an IconSize() x IconSize() coverage mask, or null
+	using IconMaskSource = std::function<const uint8_t*(int iconId)>;
+
+	SoftwareCanvas(int width, int height, int iconSize, IconMaskSource icons);
+
+	int Width() const { return m_width; }
+	int Height() const { return m_height; }
+	// Text is skipped while no cache is attached. Runs that are not simple
+	// are drawn glyph by glyph anyway.
+	void SetText(TextRunCache* text) { m_text = text; }
+
+	const uint32_t* Pixels() const { return m_pixels.data(); }
+	uint32_t Pixel(int x, int y) const { return m_pixels[static_cast<size_t>(y) * m_width + x]; }
+
+	void FillRect(const ChromeRect& rect, uint32_t color) override;
+	void FrameRoundRect(const ChromeRect& rect, int radius, uint32_t color) override;
+	void DrawTextLine(std::wstring_view text, const ChromeRect& rect, uint32_t color) override;
+	int IconSize() const override { return m_iconSize; }
+	void DrawIcon(int iconId, int x, int y, uint32_t color) override;
+
+private:
+	// Composites a coverage mask with its top-left corner at x, y
+	void BlendMask(const uint8_t* mask, int maskWidth, int maskHeight, int maskStride, int x, int y, uint32_t color);
+
+	int m_width;
+	int m_height;
+	int m_iconSize;
+	IconMaskSource m_icons;
+	TextRunCache* m_text = nullptr;
+	std::vector<uint32_t> m_pixels;
+	std::vector<uint8_t> m_mask;
+	IconRaster::CoverageRasterizer m_rasterizer;
+};
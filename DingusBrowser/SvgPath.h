@@ -0,0 +1,569 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "NumberParser.h"
+
+// SVG path data parser (https://www.w3.org/TR/SVG11/paths.html#PathDataBNF)
+//
+// Handles the complete grammar: M/L/H/V/C/S/Q/T/A/Z in absolute and relative
+// form, implicit command repetition and the compact number forms used by
+// icon exporters ("0012" arc flags, ".5.5", "-1.41-1.41").
+//
+// Output is written into caller-provided point/type arrays and never
+// allocates. Quadratic curves are elevated to cubics and arcs are converted
+// to cubic segments, so the result is a plain list of points whose types
+// match Gdiplus::PathPointType. Everything is constexpr so the same code can
+// run at compile time.
+
+namespace Svg {
+
+	struct Point {
+		float x;
+		float y;
+	};
+
+	// Values intentionally match Gdiplus::PathPointType
+	enum PointType : uint8_t {
+		PointTypeStart = 0,
+		PointTypeLine = 1,
+		PointTypeBezier = 3,
+		PointTypeMask = 0x07,
+		PointTypeCloseSubpath = 0x80
+	};
+
+	struct ParseResult {
+		size_t count = 0;        // Points produced, or required when truncated
+		size_t errorOffset = 0;  // Character offset of the first syntax error
+		bool ok = true;          // False when the path data is malformed
+		bool truncated = false;  // True when capacity was too small for all points
+	};
+
+	namespace Math {
+		constexpr double Pi = 3.14159265358979323846;
+
+		constexpr double Abs(double v) {
+			return v < 0 ? -v : v;
+		}
+
+		// False for infinities and NaN, without <cmath> so it stays constexpr
+		constexpr bool IsFinite(float v) {
+			return v >= -3.40282347e+38f && v <= 3.40282347e+38f;
+		}
+
+		constexpr double Sqrt(double v) {
+			if (!std::is_constant_evaluated()) {
+				return std::sqrt(v);
+			}
+			if (v <= 0) {
+				return 0;
+			}
+			double x = v > 1 ? v : 1;
+			for (int i = 0; i < 64; i++) {
+				double next = 0.5 * (x + v / x);
+				if (next == x) break;
+				x = next;
+			}
+			return x;
+		}
+
+		constexpr double Sin(double v) {
+			if (!std::is_constant_evaluated()) {
+				return std::sin(v);
+			}
+			while (v > Pi) v -= 2 * Pi;
+			while (v < -Pi) v += 2 * Pi;
+			double term = v, sum = v;
+			for (int n = 1; n < 12; n++) {
+				term *= -v * v / ((2 * n) * (2 * n + 1));
+				sum += term;
+			}
+			return sum;
+		}
+
+		constexpr double Cos(double v) {
+			if (!std::is_constant_evaluated()) {
+				return std::cos(v);
+			}
+			return Sin(v + Pi / 2);
+		}
+
+		constexpr double Atan(double v) {
+			if (!std::is_constant_evaluated()) {
+				return std::atan(v);
+			}
+			if (v < 0) return -Atan(-v);
+			if (v > 1) return Pi / 2 - Atan(1 / v);
+			// Halve the argument twice so the series converges quickly
+			for (int i = 0; i < 2; i++) {
+				v = v / (1 + Sqrt(1 + v * v));
+			}
+			double term = v, sum = v;
+			for (int n = 1; n < 16; n++) {
+				term *= -v * v;
+				sum += term / (2 * n + 1);
+			}
+			return sum * 4;
+		}
+
+		constexpr double Atan2(double y, double x) {
+			if (!std::is_constant_evaluated()) {
+				return std::atan2(y, x);
+			}
+			if (x > 0) return Atan(y / x);
+			if (x < 0) return y >= 0 ? Atan(y / x) + Pi : Atan(y / x) - Pi;
+			if (y > 0) return Pi / 2;
+			if (y < 0) return -Pi / 2;
+			return 0;
+		}
+	}
+
+	// Splits path data into commands, numbers and flags. Separators (whitespace
+	// and a single optional comma) are consumed before each token.
+	template <typename Char>
+	class PathTokenizer {
+	public:
+		constexpr explicit PathTokenizer(const Char* data) : m_begin(data), m_pos(data) {}
+
+		constexpr size_t Offset() const { return static_cast<size_t>(m_pos - m_begin); }
+
+		constexpr bool AtEnd() {
+			SkipWhitespace();
+			return *m_pos == 0;
+		}
+
+		// Returns the next command letter without consuming it, or 0 if the
+		// next token is not a command.
+		constexpr Char PeekCommand() {
+			SkipWhitespace();
+			return IsCommand(*m_pos) ? *m_pos : Char(0);
+		}
+
+		constexpr void SkipCommand() { m_pos++; }
+
+		// True if the next token starts a number (implicit command repetition)
+		constexpr bool PeekNumber() {
+			SkipSeparators();
+			Char c = *m_pos;
+			return IsDigit(c) || c == '.' || c == '-' || c == '+';
+		}
+
+		// Numbers that overflow a float ("1e39") are rejected as a syntax error
+		constexpr bool ReadNumber(float& out) {
+			SkipSeparators();
+			const Char* end = NumberParser::ParseFloat(m_pos, out);
+			if (!end || !(out >= -FLOAT_MAX && out <= FLOAT_MAX)) {
+				return false;
+			}
+			m_pos = end;
+			return true;
+		}
+
+		// Arc flags are single characters and need no separator ("a1 1 0 0012 4")
+		constexpr bool ReadFlag(bool& out) {
+			SkipSeparators();
+			if (*m_pos != '0' && *m_pos != '1') {
+				return false;
+			}
+			out = (*m_pos == '1');
+			m_pos++;
+			return true;
+		}
+
+	private:
+		static constexpr float FLOAT_MAX = 3.40282347e+38f;
+
+		static constexpr bool IsDigit(Char c) { return c >= '0' && c <= '9'; }
+
+		static constexpr bool IsWhitespace(Char c) {
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+		}
+
+		static constexpr bool IsCommand(Char c) {
+			switch (c) {
+			case 'M': case 'm': case 'L': case 'l': case 'H': case 'h':
+			case 'V': case 'v': case 'C': case 'c': case 'S': case 's':
+			case 'Q': case 'q': case 'T': case 't': case 'A': case 'a':
+			case 'Z': case 'z':
+				return true;
+			}
+			return false;
+		}
+
+		constexpr void SkipWhitespace() {
+			while (IsWhitespace(*m_pos)) m_pos++;
+		}
+
+		constexpr void SkipSeparators() {
+			SkipWhitespace();
+			if (*m_pos == ',') {
+				m_pos++;
+				SkipWhitespace();
+			}
+		}
+
+		const Char* m_begin;
+		const Char* m_pos;
+	};
+
+	// Appends points to caller storage. Keeps counting past capacity so a
+	// first pass with no storage reports the exact size needed. Notes when
+	// a point overflowed, e.g. from relative coordinates adding up past
+	// FLT_MAX, so the parser can reject the command that produced it.
+	class PathWriter {
+	public:
+		constexpr PathWriter(Point* points, uint8_t* types, size_t capacity)
+			: m_points(points), m_types(types), m_capacity(capacity) {}
+
+		constexpr void Add(float x, float y, uint8_t type) {
+			if (!Math::IsFinite(x) || !Math::IsFinite(y)) {
+				m_overflowed = true;
+			}
+			if (m_count < m_capacity) {
+				m_points[m_count] = Point{ x, y };
+				m_types[m_count] = type;
+			}
+			m_count++;
+		}
+
+		constexpr void CloseSubpath() {
+			if (m_count > 0 && m_count <= m_capacity) {
+				m_types[m_count - 1] |= PointTypeCloseSubpath;
+			}
+		}
+
+		// Drops points added since Count() returned count
+		constexpr void Rewind(size_t count) { m_count = count; }
+
+		constexpr size_t Count() const { return m_count; }
+		constexpr bool Truncated() const { return m_count > m_capacity; }
+		constexpr bool Overflowed() const { return m_overflowed; }
+
+	private:
+		Point* m_points;
+		uint8_t* m_types;
+		size_t m_capacity;
+		size_t m_count = 0;
+		bool m_overflowed = false;
+	};
+
+	namespace Detail {
+		// Converts an SVG endpoint arc to cubic Beziers of at most 90 degrees each
+		// (SVG 1.1 implementation notes F.6.5 and F.6.6)
+		constexpr void ArcToBeziers(PathWriter& out, double x0, double y0, double rx, double ry,
+			double rotation, bool largeArc, bool sweep, double x, double y) {
+			if (x0 == x && y0 == y) {
+				return;
+			}
+			rx = Math::Abs(rx);
+			ry = Math::Abs(ry);
+			if (rx == 0 || ry == 0) {
+				out.Add(static_cast<float>(x), static_cast<float>(y), PointTypeLine);
+				return;
+			}
+
+			double phi = rotation * Math::Pi / 180.0;
+			double cosPhi = Math::Cos(phi);
+			double sinPhi = Math::Sin(phi);
+
+			double dx = (x0 - x) / 2;
+			double dy = (y0 - y) / 2;
+			double x1p = cosPhi * dx + sinPhi * dy;
+			double y1p = -sinPhi * dx + cosPhi * dy;
+
+			// Scale up radii that are too small to span the endpoints
+			double lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+			if (lambda > 1) {
+				double s = Math::Sqrt(lambda);
+				rx *= s;
+				ry *= s;
+			}
+
+			double num = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p;
+			double den = rx * rx * y1p * y1p + ry * ry * x1p * x1p;
+			double coef = (num > 0 && den > 0) ? Math::Sqrt(num / den) : 0;
+			if (largeArc == sweep) {
+				coef = -coef;
+			}
+			double cxp = coef * rx * y1p / ry;
+			double cyp = -coef * ry * x1p / rx;
+			double cx = cosPhi * cxp - sinPhi * cyp + (x0 + x) / 2;
+			double cy = sinPhi * cxp + cosPhi * cyp + (y0 + y) / 2;
+
+			double ux = (x1p - cxp) / rx, uy = (y1p - cyp) / ry;
+			double vx = (-x1p - cxp) / rx, vy = (-y1p - cyp) / ry;
+			double theta = Math::Atan2(uy, ux);
+			double delta = Math::Atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+			if (!sweep && delta > 0) {
+				delta -= 2 * Math::Pi;
+			}
+			else if (sweep && delta < 0) {
+				delta += 2 * Math::Pi;
+			}
+
+			int segments = 1;
+			while (Math::Abs(delta) / segments > Math::Pi / 2 + 1e-6) {
+				segments++;
+			}
+			double step = delta / segments;
+			double k = 4.0 / 3.0 * Math::Sin(step / 4) / Math::Cos(step / 4);
+
+			double cosT = Math::Cos(theta), sinT = Math::Sin(theta);
+			for (int i = 0; i < segments; i++) {
+				double next = theta + step * (i + 1);
+				double cosN = Math::Cos(next), sinN = Math::Sin(next);
+
+				// Control points on the unit circle, then mapped onto the ellipse
+				double p1x = cosT - k * sinT, p1y = sinT + k * cosT;
+				double p2x = cosN + k * sinN, p2y = sinN - k * cosN;
+
+				double pts[3][2] = { { p1x, p1y }, { p2x, p2y }, { cosN, sinN } };
+				for (auto& pt : pts) {
+					double ex = pt[0] * rx, ey = pt[1] * ry;
+					double px = cosPhi * ex - sinPhi * ey + cx;
+					double py = sinPhi * ex + cosPhi * ey + cy;
+					out.Add(static_cast<float>(px), static_cast<float>(py), PointTypeBezier);
+				}
+				cosT = cosN;
+				sinT = sinN;
+			}
+		}
+	}
+
+	// Parses SVG path data into absolute points. Pass null storage with zero
+	// capacity to measure; a second call with exactly result.count entries fills.
+	// On a syntax error everything before the error is kept, as SVG requires.
+	template <typename Char>
+	constexpr ParseResult ParsePath(const Char* data, Point* points, uint8_t* types, size_t capacity) {
+		ParseResult result;
+		PathWriter out(points, types, capacity);
+		PathTokenizer<Char> tokens(data);
+
+		float curX = 0, curY = 0;      // Current point
+		float startX = 0, startY = 0;  // Start of the current subpath
+		float ctrlX = 0, ctrlY = 0;    // Last control point for S/T reflection
+		Char prevCmd = 0;
+		bool haveSubpath = false;      // A moveto has been seen
+		bool needStart = true;         // Next drawing command must open a figure
+
+		auto fail = [&]() {
+			result.ok = false;
+			result.errorOffset = tokens.Offset();
+		};
+
+		// Opens a figure at the current point when drawing follows a closepath
+		auto ensureStart = [&]() {
+			if (needStart) {
+				out.Add(curX, curY, PointTypeStart);
+				startX = curX;
+				startY = curY;
+				needStart = false;
+			}
+		};
+
+		auto cubicTo = [&](float x1, float y1, float x2, float y2, float x, float y) {
+			ensureStart();
+			out.Add(x1, y1, PointTypeBezier);
+			out.Add(x2, y2, PointTypeBezier);
+			out.Add(x, y, PointTypeBezier);
+			ctrlX = x2;
+			ctrlY = y2;
+			curX = x;
+			curY = y;
+		};
+
+		auto quadTo = [&](float qx, float qy, float x, float y) {
+			cubicTo(curX + 2.0f / 3.0f * (qx - curX), curY + 2.0f / 3.0f * (qy - curY),
+				x + 2.0f / 3.0f * (qx - x), y + 2.0f / 3.0f * (qy - y), x, y);
+			ctrlX = qx;
+			ctrlY = qy;
+		};
+
+		while (!tokens.AtEnd()) {
+			size_t commandCount = out.Count();
+			Char cmd = tokens.PeekCommand();
+			size_t commandOffset = tokens.Offset();
+			if (cmd != 0) {
+				tokens.SkipCommand();
+			}
+			else if (prevCmd != 0 && prevCmd != 'Z' && prevCmd != 'z' && tokens.PeekNumber()) {
+				// Implicit repetition; a repeated moveto becomes a lineto
+				cmd = prevCmd == 'M' ? Char('L') : prevCmd == 'm' ? Char('l') : prevCmd;
+			}
+			else {
+				fail();
+				break;
+			}
+
+			// Path data must begin with a moveto
+			if (!haveSubpath && cmd != 'M' && cmd != 'm') {
+				fail();
+				break;
+			}
+
+			bool relative = (cmd >= 'a' && cmd <= 'z');
+			float baseX = relative ? curX : 0.0f;
+			float baseY = relative ? curY : 0.0f;
+			bool smoothCubic = (prevCmd == 'C' || prevCmd == 'c' || prevCmd == 'S' || prevCmd == 's');
+			bool smoothQuad = (prevCmd == 'Q' || prevCmd == 'q' || prevCmd == 'T' || prevCmd == 't');
+			float a[6] = {};
+			bool flags[2] = {};
+			bool read = true;
+
+			switch (cmd) {
+			case 'M': case 'm':
+				read = tokens.ReadNumber(a[0]) && tokens.ReadNumber(a[1]);
+				if (read) {
+					curX = baseX + a[0];
+					curY = baseY + a[1];
+					needStart = true;
+					haveSubpath = true;
+					ensureStart();
+				}
+				break;
+
+			case 'L': case 'l':
+				read = tokens.ReadNumber(a[0]) && tokens.ReadNumber(a[1]);
+				if (read) {
+					ensureStart();
+					curX = baseX + a[0];
+					curY = baseY + a[1];
+					out.Add(curX, curY, PointTypeLine);
+				}
+				break;
+
+			case 'H': case 'h':
+				read = tokens.ReadNumber(a[0]);
+				if (read) {
+					ensureStart();
+					curX = baseX + a[0];
+					out.Add(curX, curY, PointTypeLine);
+				}
+				break;
+
+			case 'V': case 'v':
+				read = tokens.ReadNumber(a[0]);
+				if (read) {
+					ensureStart();
+					curY = baseY + a[0];
+					out.Add(curX, curY, PointTypeLine);
+				}
+				break;
+
+			case 'C': case 'c':
+				for (int i = 0; i < 6 && read; i++) read = tokens.ReadNumber(a[i]);
+				if (read) {
+					cubicTo(baseX + a[0], baseY + a[1], baseX + a[2], baseY + a[3], baseX + a[4], baseY + a[5]);
+				}
+				break;
+
+			case 'S': case 's':
+				for (int i = 0; i < 4 && read; i++) read = tokens.ReadNumber(a[i]);
+				if (read) {
+					float x1 = smoothCubic ? 2 * curX - ctrlX : curX;
+					float y1 = smoothCubic ? 2 * curY - ctrlY : curY;
+					cubicTo(x1, y1, baseX + a[0], baseY + a[1], baseX + a[2], baseY + a[3]);
+				}
+				break;
+
+			case 'Q': case 'q':
+				for (int i = 0; i < 4 && read; i++) read = tokens.ReadNumber(a[i]);
+				if (read) {
+					quadTo(baseX + a[0], baseY + a[1], baseX + a[2], baseY + a[3]);
+				}
+				break;
+
+			case 'T': case 't':
+				read = tokens.ReadNumber(a[0]) && tokens.ReadNumber(a[1]);
+				if (read) {
+					float qx = smoothQuad ? 2 * curX - ctrlX : curX;
+					float qy = smoothQuad ? 2 * curY - ctrlY : curY;
+					quadTo(qx, qy, baseX + a[0], baseY + a[1]);
+				}
+				break;
+
+			case 'A': case 'a':
+				read = tokens.ReadNumber(a[0]) && tokens.ReadNumber(a[1]) && tokens.ReadNumber(a[2]) &&
+					tokens.ReadFlag(flags[0]) && tokens.ReadFlag(flags[1]) &&
+					tokens.ReadNumber(a[3]) && tokens.ReadNumber(a[4]);
+				if (read) {
+					ensureStart();
+					float x = baseX + a[3];
+					float y = baseY + a[4];
+					Detail::ArcToBeziers(out, curX, curY, a[0], a[1], a[2], flags[0], flags[1], x, y);
+					curX = x;
+					curY = y;
+				}
+				break;
+
+			case 'Z': case 'z':
+				if (!needStart) {
+					out.CloseSubpath();
+				}
+				curX = startX;
+				curY = startY;
+				needStart = true;
+				break;
+			}
+
+			if (!read) {
+				fail();
+				break;
+			}
+			if (out.Overflowed()) {
+				// Every number was finite but the geometry is not; drop the
+				// whole command so all returned points are usable
+				out.Rewind(commandCount);
+				result.ok = false;
+				result.errorOffset = commandOffset;
+				break;
+			}
+			prevCmd = cmd;
+		}
+
+		result.count = out.Count();
+		result.truncated = out.Truncated();
+		return result;
+	}
+
+	template <typename Char>
+	constexpr size_t CountPathPoints(const Char* data) {
+		return ParsePath<Char>(data, nullptr, nullptr, 0).count;
+	}
+
+	// String literal usable as a template argument, so a path can be
+	// compiled once per distinct source string
+	template <size_t N>
+	struct PathLiteral {
+		char data[N] = {};
+
+		constexpr PathLiteral(const char (&source)[N]) {
+			for (size_t i = 0; i < N; i++) data[i] = source[i];
+		}
+	};
+
+	// Path data parsed at compile time into static point/type arrays
+	template <PathLiteral Source>
+	struct CompiledPath {
+		static constexpr size_t Count = CountPathPoints(Source.data);
+
+		struct Storage {
+			Point points[Count];
+			uint8_t types[Count];
+		};
+
+		static constexpr Storage Build() {
+			Storage storage{};
+			ParseResult parsed = ParsePath(Source.data, storage.points, storage.types, Count);
+			if (!parsed.ok) {
+				throw "Malformed SVG path data";  // Not a constant expression: fails the build
+			}
+			return storage;
+		}
+
+		static constexpr Storage Data = Build();
+	};
+}
@@ -0,0 +1,211 @@
+#include "SymbolSheet.h"
+
+#include <cfloat>
+#include <cstring>
+#include <string>
+
+#include "NumberParser.h"
+
+namespace {
+	bool IsSpace(char c) {
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	bool IsNameChar(char c) {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+			c == '-' || c == '_' || c == ':' || c == '.';
+	}
+
+	// Returns the position of the first occurrence of needle, or end
+	const char* FindText(const char* p, const char* end, std::string_view needle) {
+		std::string_view haystack(p, static_cast<size_t>(end - p));
+		size_t pos = haystack.find(needle);
+		return pos == std::string_view::npos ? end : p + pos;
+	}
+
+	// Finds the '>' closing a tag, skipping over quoted attribute values
+	const char* FindTagEnd(const char* p, const char* end) {
+		char quote = 0;
+		for (; p < end; p++) {
+			if (quote) {
+				if (*p == quote) quote = 0;
+			}
+			else if (*p == '"' || *p == '\'') {
+				quote = *p;
+			}
+			else if (*p == '>') {
+				return p;
+			}
+		}
+		return end;
+	}
+
+	// Looks up an attribute value in the raw text between a tag name and '>'
+	std::string_view FindAttribute(std::string_view attributes, std::string_view name) {
+		const char* p = attributes.data();
+		const char* end = p + attributes.size();
+		while (p < end) {
+			while (p < end && (IsSpace(*p) || *p == '/')) p++;
+			const char* nameStart = p;
+			while (p < end && IsNameChar(*p)) p++;
+			std::string_view attrName(nameStart, static_cast<size_t>(p - nameStart));
+			if (attrName.empty()) {
+				break;
+			}
+
+			while (p < end && IsSpace(*p)) p++;
+			if (p >= end || *p != '=') continue;
+			p++;
+			while (p < end && IsSpace(*p)) p++;
+			if (p >= end || (*p != '"' && *p != '\'')) break;
+
+			char quote = *p++;
+			const char* valueStart = p;
+			while (p < end && *p != quote) p++;
+			if (attrName == name) {
+				return std::string_view(valueStart, static_cast<size_t>(p - valueStart));
+			}
+			if (p < end) p++;
+		}
+		return std::string_view();
+	}
+
+	// Reads the four finite numbers of a viewBox value. The value is not NUL
+	// terminated, so every read is bounded by its end.
+	bool ParseViewBox(std::string_view value, float (&out)[4]) {
+		const char* p = value.data();
+		const char* end = p + value.size();
+		for (float& v : out) {
+			while (p < end && (IsSpace(*p) || *p == ',')) p++;
+			p = p < end ? NumberParser::ParseFloat(p, end, v) : nullptr;
+			if (!p || !(v >= -FLT_MAX && v <= FLT_MAX)) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+size_t SymbolSheet::Index(const char* data, size_t size) {
+	m_data = data;
+	m_symbols.clear();
+	m_pathData.clear();
+	m_parsed.clear();
+	m_byId.clear();
+
+	const char* p = data;
+	const char* end = data + size;
+	int current = -1;  // Symbol whose body we are inside
+
+	while (p < end) {
+		p = static_cast<const char*>(memchr(p, '<', static_cast<size_t>(end - p)));
+		if (!p) break;
+		p++;
+
+		// Comments, declarations and processing instructions
+		if (end - p >= 3 && memcmp(p, "!--", 3) == 0) {
+			p = FindText(p + 3, end, "-->");
+			continue;
+		}
+		if (p < end && (*p == '!' || *p == '?')) {
+			p = FindTagEnd(p, end);
+			continue;
+		}
+
+		bool closing = (p < end && *p == '/');
+		if (closing) p++;
+		const char* nameStart = p;
+		while (p < end && IsNameChar(*p)) p++;
+		std::string_view name(nameStart, static_cast<size_t>(p - nameStart));
+
+		const char* tagEnd = FindTagEnd(p, end);
+		bool selfClosing = (tagEnd > p && tagEnd < end && tagEnd[-1] == '/');
+		std::string_view attributes(p, static_cast<size_t>(tagEnd - p));
+		p = tagEnd;
+
+		if (name == "symbol") {
+			if (closing) {
+				current = -1;
+				continue;
+			}
+
+			SheetSymbol symbol;
+			symbol.id = FindAttribute(attributes, "id");
+			symbol.firstPath = static_cast<uint32_t>(m_pathData.size());
+
+			std::string_view viewBox = FindAttribute(attributes, "viewBox");
+			float values[4];
+			if (ParseViewBox(viewBox, values) && values[2] > 0 && values[3] > 0) {
+				memcpy(symbol.viewBox, values, sizeof(values));
+			}
+
+			int index = static_cast<int>(m_symbols.size());
+			m_symbols.push_back(symbol);
+			if (!symbol.id.empty()) {
+				m_byId.emplace(symbol.id, index);  // First definition wins
+			}
+			current = selfClosing ? -1 : index;
+		}
+		else if (name == "path" && !closing && current >= 0) {
+			std::string_view d = FindAttribute(attributes, "d");
+			if (!d.empty()) {
+				m_pathData.push_back(d);
+				m_symbols[current].pathCount++;
+			}
+		}
+	}
+
+	m_parsed.resize(m_symbols.size());
+	return m_symbols.size();
+}
+
+int SymbolSheet::Find(std::string_view id) const {
+	auto it = m_byId.find(id);
+	return it == m_byId.end() ? -1 : it->second;
+}
+
+const IconPath* SymbolSheet::GetPath(size_t index) {
+	if (index >= m_symbols.size()) {
+		return nullptr;
+	}
+
+	ParsedPath& parsed = m_parsed[index];
+	if (!parsed.loaded) {
+		parsed.loaded = true;
+		const SheetSymbol& symbol = m_symbols[index];
+
+		// Each <path> is parsed on its own, since every path starts from the
+		// origin (a leading relative "m" is absolute). Attribute values are not
+		// NUL terminated, so each is copied first.
+		std::string data;
+		for (uint32_t i = 0; i < symbol.pathCount; i++) {
+			data.assign(m_pathData[symbol.firstPath + i]);
+			size_t first = parsed.points.size();
+			Svg::ParseResult result = Svg::ParsePath(data.c_str(), nullptr, nullptr, 0);
+			parsed.points.resize(first + result.count);
+			parsed.types.resize(first + result.count);
+			Svg::ParsePath(data.c_str(), parsed.points.data() + first, parsed.types.data() + first, result.count);
+		}
+
+		// Fit the viewBox into the 24x24 icon space with one scale, centered
+		// along the shorter side (preserveAspectRatio="xMidYMid meet")
+		float width = symbol.viewBox[2];
+		float height = symbol.viewBox[3];
+		float scale = 24.0f / (width > height ? width : height);
+		float offsetX = (24.0f - width * scale) * 0.5f;
+		float offsetY = (24.0f - height * scale) * 0.5f;
+		for (Svg::Point& point : parsed.points) {
+			point.x = (point.x - symbol.viewBox[0]) * scale + offsetX;
+			point.y = (point.y - symbol.viewBox[1]) * scale + offsetY;
+		}
+
+		parsed.valid = !parsed.points.empty();
+		parsed.view = { parsed.points.data(), parsed.types.data(), static_cast<int>(parsed.points.size()) };
+	}
+	return parsed.valid ? &parsed.view : nullptr;
+}
+
+const IconPath* SymbolSheet::GetPath(std::string_view id) {
+	int index = Find(id);
+	return index < 0 ? nullptr : GetPath(static_cast<size_t>(index));
+}
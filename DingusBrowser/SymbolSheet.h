@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "IconRaster.h"
+#include "SvgPath.h"
+
+// Lazily loaded SVG symbol sheet (Icons.svg).
+//
+// Index() makes one streaming pass over the markup and records where each
+// <symbol id=... viewBox=...> and its <path d=...> attributes are, without
+// building a DOM or copying text. Path data is parsed the first time a
+// symbol is requested, so startup only pays for icons that get drawn.
+// The sheet text must outlive the SymbolSheet.
+
+struct SheetSymbol {
+	std::string_view id;
+	float viewBox[4] = { 0, 0, 24, 24 };
+	uint32_t firstPath = 0;  // Index into the sheet's path data ranges
+	uint32_t pathCount = 0;
+};
+
+class SymbolSheet {
+public:
+	// Indexes the sheet and returns the number of symbols found
+	size_t Index(const char* data, size_t size);
+
+	size_t Count() const { return m_symbols.size(); }
+	const SheetSymbol& At(size_t index) const { return m_symbols[index]; }
+
+	// Index of the symbol with this id, or -1
+	int Find(std::string_view id) const;
+
+	// Geometry normalized to the 24x24 icon space, parsed on first use.
+	// Null if the symbol has no path data or it does not parse.
+	const IconPath* GetPath(size_t index);
+	const IconPath* GetPath(std::string_view id);
+
+private:
+	struct ParsedPath {
+		bool loaded = false;
+		bool valid = false;
+		std::vector<Svg::Point> points;
+		std::vector<uint8_t> types;
+		IconPath view;
+	};
+
+	const char* m_data = nullptr;
+	std::vector<SheetSymbol> m_symbols;
+	std::vector<std::string_view> m_pathData;
+	std::vector<ParsedPath> m_parsed;
+	std::unordered_map<std::string_view, int> m_byId;
+};
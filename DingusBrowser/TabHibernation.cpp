@@ -0,0 +1,52 @@
+#include "TabHibernation.h"
+
+#include <algorithm>
+
+std::vector<HibernationAction> HibernationPolicy::Evaluate(const std::vector<TabActivity>& tabs, uint64_t now) const {
+	std::vector<HibernationAction> actions;
+
+	// What is alive now, and which tabs could be let go, oldest first
+	int liveTabs = 0;
+	uint64_t liveMemory = 0;
+	std::vector<int> candidates;
+	for (int i = 0; i < static_cast<int>(tabs.size()); i++) {
+		const TabActivity& tab = tabs[i];
+		if (tab.sleep == TabSleep::Discarded) {
+			continue;
+		}
+		liveTabs++;
+		liveMemory += tab.memory;
+		if (!tab.visible && !tab.keepAwake) {
+			candidates.push_back(i);
+		}
+	}
+	std::stable_sort(candidates.begin(), candidates.end(), [&tabs](int a, int b) {
+		return tabs[a].lastActive < tabs[b].lastActive;
+	});
+
+	// Discard until both budgets are met
+	std::vector<bool> discarded(tabs.size(), false);
+	for (int i : candidates) {
+		bool overCount = m_config.maxLiveTabs > 0 && liveTabs > m_config.maxLiveTabs;
+		bool overMemory = m_config.memoryBudget > 0 && liveMemory > m_config.memoryBudget;
+		if (!overCount && !overMemory) {
+			break;
+		}
+		actions.push_back({ HibernationAction::Discard, i });
+		discarded[i] = true;
+		liveTabs--;
+		liveMemory -= tabs[i].memory;
+	}
+
+	// Suspend what has been idle long enough
+	for (int i : candidates) {
+		const TabActivity& tab = tabs[i];
+		if (discarded[i] || tab.sleep != TabSleep::Awake) {
+			continue;
+		}
+		if (now >= tab.lastActive && now - tab.lastActive >= m_config.suspendAfter) {
+			actions.push_back({ HibernationAction::Suspend, i });
+		}
+	}
+	return actions;
+}
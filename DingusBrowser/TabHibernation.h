@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Decides which background tabs to put to sleep.
+//
+// A tab that has sat in the background for suspendAfter gets suspended: its
+// renderer stays but stops running. When there are more live (not discarded)
+// tabs than maxLiveTabs, or they are estimated to use more than memoryBudget,
+// the least recently used ones get discarded: the renderer is dropped and
+// only the URL, title and scroll position are kept. The policy only reads a
+// snapshot and returns actions; carrying them out is up to the caller.
+
+enum class TabSleep {
+	Awake,
+	Suspended,
+	Discarded
+};
+
+struct TabActivity {
+	TabSleep sleep = TabSleep::Awake;
+	uint64_t lastActive = 0;  // Milliseconds, same clock as Evaluate's now
+	uint64_t memory = 0;      // Estimated bytes while not discarded; 0 if unknown
+	bool visible = false;     // The tab being shown is never put to sleep
+	bool keepAwake = false;   // E.g. playing audio
+};
+
+struct HibernationAction {
+	enum Kind {
+		Suspend,
+		Discard
+	};
+
+	Kind kind = Suspend;
+	int tab = 0;  // Index into the snapshot given to Evaluate
+};
+
+struct HibernationConfig {
+	uint64_t suspendAfter = 5 * 60 * 1000;
+	int maxLiveTabs = 16;
+	uint64_t memoryBudget = 0;  // 0 for no memory limit
+};
+
+class HibernationPolicy {
+public:
+	explicit HibernationPolicy(const HibernationConfig& config = HibernationConfig()) : m_config(config) {}
+
+	const HibernationConfig& Config() const { return m_config; }
+	void SetConfig(const HibernationConfig& config) { m_config = config; }
+
+	// Discards come first, least recently used first, and a tab gets at most one action
+	std::vector<HibernationAction> Evaluate(const std::vector<TabActivity>& tabs, uint64_t now) const;
+
+private:
+	HibernationConfig m_config;
+};
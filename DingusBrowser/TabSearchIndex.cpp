@@ -0,0 +1,345 @@
+#include "TabSearchIndex.h"
+
+#include <algorithm>
+#include <cwctype>
+
+namespace {
+	constexpr size_t MIN_COMPACT_TEXT = 64 * 1024;
+
+	// Keys of the word prefix postings; trigram keys never set the top bit
+	constexpr uint64_t WORD_PREFIX = 1ull << 63;
+	constexpr uint64_t ONE_CHARACTER = 1ull << 62;
+
+	wchar_t Fold(wchar_t c) {
+		if (c < 0x80) {
+			return c >= L'A' && c <= L'Z' ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+		}
+		return static_cast<wchar_t>(std::towlower(static_cast<wint_t>(c)));
+	}
+
+	void AppendFolded(std::wstring& out, std::wstring_view text) {
+		size_t start = out.size();
+		out.resize(start + text.size());
+		std::transform(text.begin(), text.end(), out.begin() + start, Fold);
+	}
+
+	// 21 bits per character holds any code point, so keys never collide
+	uint64_t Bits(wchar_t c) {
+		return static_cast<uint64_t>(static_cast<uint32_t>(c) & 0x1FFFFF);
+	}
+
+	void AddTrigrams(std::wstring_view text, std::vector<uint64_t>& out) {
+		for (size_t i = 0; i + 3 <= text.size(); i++) {
+			out.push_back(Bits(text[i]) << 42 | Bits(text[i + 1]) << 21 | Bits(text[i + 2]));
+		}
+	}
+
+	// Key for text of one or two characters found at the start of a title word
+	uint64_t WordPrefixKey(std::wstring_view text) {
+		return text.size() == 1 ? WORD_PREFIX | ONE_CHARACTER | Bits(text[0]) : WORD_PREFIX | Bits(text[0]) << 21 | Bits(text[1]);
+	}
+
+	void SortUnique(std::vector<uint64_t>& keys) {
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	}
+
+	bool IsWordStart(std::wstring_view text, size_t position) {
+		if (position == 0) {
+			return true;
+		}
+		wchar_t c = text[position - 1];
+		if (c < 0x80) {
+			return !((c >= L'a' && c <= L'z') || (c >= L'0' && c <= L'9'));
+		}
+		return !std::iswalnum(static_cast<wint_t>(c));
+	}
+
+	void AddWordPrefixes(std::wstring_view text, std::vector<uint64_t>& out) {
+		for (size_t i = 0; i < text.size(); i++) {
+			if (IsWordStart(text, i)) {
+				out.push_back(WordPrefixKey(text.substr(i, 1)));
+				if (i + 1 < text.size()) {
+					out.push_back(WordPrefixKey(text.substr(i, 2)));
+				}
+			}
+		}
+	}
+
+	// Finds term at or after start. Skips ahead with the vectorized
+	// single-character search rather than comparing at every position.
+	size_t Find(std::wstring_view text, std::wstring_view term, size_t start) {
+		const wchar_t* end = text.data() + text.size();
+		for (const wchar_t* p = text.data() + start; end - p >= static_cast<ptrdiff_t>(term.size()); p++) {
+			p = std::char_traits<wchar_t>::find(p, (end - p) - term.size() + 1, term[0]);
+			if (!p) {
+				break;
+			}
+			if (std::char_traits<wchar_t>::compare(p + 1, term.data() + 1, term.size() - 1) == 0) {
+				return p - text.data();
+			}
+		}
+		return std::wstring_view::npos;
+	}
+
+	// 2 for a match at the start of a word, 1 inside one, 0 for none
+	int MatchQuality(std::wstring_view text, std::wstring_view term) {
+		int quality = 0;
+		for (size_t position = Find(text, term, 0); position != std::wstring_view::npos; position = Find(text, term, position + 1)) {
+			if (IsWordStart(text, position)) {
+				return 2;
+			}
+			quality = 1;
+		}
+		return quality;
+	}
+
+	// Keeps the candidates that are also in list. Both are sorted, so this is a
+	// forward merge; against a much longer list it binary searches ahead instead.
+	void IntersectInPlace(std::vector<uint32_t>& candidates, const std::vector<uint32_t>& list) {
+		bool search = list.size() > candidates.size() * 16;
+		auto it = list.begin();
+		size_t kept = 0;
+		for (uint32_t index : candidates) {
+			if (search) {
+				it = std::lower_bound(it, list.end(), index);
+			}
+			else {
+				while (it != list.end() && *it < index) {
+					++it;
+				}
+			}
+			if (it == list.end()) {
+				break;
+			}
+			if (*it == index) {
+				candidates[kept++] = index;
+			}
+		}
+		candidates.resize(kept);
+	}
+}
+
+void TabSearchIndex::Update(uint32_t tab, std::wstring_view title, std::wstring_view url) {
+	m_stats.updates++;
+	auto [slot, added] = m_slots.try_emplace(tab, static_cast<uint32_t>(m_entries.size()));
+	uint32_t index = slot->second;
+	if (added) {
+		m_entries.push_back({ tab, 0, 0, 0, {} });
+	}
+
+	// Append the new text; the old text stays behind until the next compaction
+	Entry& entry = m_entries[index];
+	m_liveText -= entry.titleLength + entry.urlLength;
+	entry.text = m_text.size();
+	entry.titleLength = static_cast<uint32_t>(title.size());
+	entry.urlLength = static_cast<uint32_t>(url.size());
+	AppendFolded(m_text, title);
+	AppendFolded(m_text, url);
+	m_liveText += title.size() + url.size();
+
+	// Title and URL are cut separately so no trigram spans the two
+	std::vector<uint64_t> keys;
+	keys.reserve(title.size() * 2 + url.size());
+	AddTrigrams(Title(entry), keys);
+	AddTrigrams(Url(entry), keys);
+	AddWordPrefixes(Title(entry), keys);
+	SortUnique(keys);
+
+	// Walk the old and new sorted sets together; only the differences touch postings
+	const std::vector<uint64_t>& old = entry.keys;
+	size_t i = 0, j = 0;
+	while (i < old.size() || j < keys.size()) {
+		if (j == keys.size() || (i < old.size() && old[i] < keys[j])) {
+			RemovePosting(old[i++], index);
+		}
+		else if (i == old.size() || keys[j] < old[i]) {
+			AddPosting(keys[j++], index);
+		}
+		else {
+			i++;
+			j++;
+		}
+	}
+	entry.keys = std::move(keys);
+
+	if (m_text.size() > MIN_COMPACT_TEXT && m_text.size() > m_liveText * 2) {
+		CompactText();
+	}
+}
+
+void TabSearchIndex::Remove(uint32_t tab) {
+	auto slot = m_slots.find(tab);
+	if (slot == m_slots.end()) {
+		return;
+	}
+	uint32_t index = slot->second;
+	m_slots.erase(slot);
+
+	Entry& entry = m_entries[index];
+	m_liveText -= entry.titleLength + entry.urlLength;
+	for (uint64_t key : entry.keys) {
+		RemovePosting(key, index);
+	}
+
+	// Move the last entry into the hole so the entries stay packed. It has the
+	// highest index, so it sits at the end of each of its posting lists.
+	uint32_t last = static_cast<uint32_t>(m_entries.size()) - 1;
+	if (index != last) {
+		Entry& moved = m_entries[last];
+		for (uint64_t key : moved.keys) {
+			std::vector<uint32_t>& list = m_postings[key];
+			list.pop_back();
+			list.insert(std::lower_bound(list.begin(), list.end(), index), index);
+		}
+		m_slots[moved.tab] = index;
+		entry = std::move(moved);
+	}
+	m_entries.pop_back();
+}
+
+std::vector<TabSearchResult> TabSearchIndex::Search(std::wstring_view query, size_t limit) const {
+	m_stats.queries++;
+	std::wstring folded;
+	AppendFolded(folded, query);
+	std::vector<std::wstring> terms;
+	for (size_t start = 0; start < folded.size();) {
+		size_t end = folded.find(L' ', start);
+		if (end == std::wstring::npos) {
+			end = folded.size();
+		}
+		if (end > start) {
+			terms.push_back(folded.substr(start, end - start));
+		}
+		start = end + 1;
+	}
+	if (terms.empty() || limit == 0) {
+		return {};
+	}
+
+	std::vector<uint64_t> keys;
+	for (const std::wstring& term : terms) {
+		AddTrigrams(term, keys);
+	}
+	SortUnique(keys);
+
+	std::vector<TabSearchResult> results;
+	std::vector<uint32_t> candidates;
+	if (!keys.empty()) {
+		if (Intersect(keys, candidates)) {
+			Collect(candidates, terms, results);
+		}
+	}
+	else {
+		// Every term is too short for a trigram. Tabs where each term starts a
+		// title word outrank all others, so if there are enough of them the
+		// rest need not be checked; otherwise check every tab.
+		for (const std::wstring& term : terms) {
+			keys.push_back(WordPrefixKey(term));
+		}
+		SortUnique(keys);
+		if (Intersect(keys, candidates)) {
+			Collect(candidates, terms, results);
+		}
+
+		if (results.size() < limit) {
+			results.clear();
+			candidates.resize(m_entries.size());
+			for (uint32_t i = 0; i < candidates.size(); i++) {
+				candidates[i] = i;
+			}
+			Collect(candidates, terms, results);
+		}
+	}
+
+	auto better = [](const TabSearchResult& a, const TabSearchResult& b) {
+		return a.score != b.score ? a.score > b.score : a.tab < b.tab;
+	};
+	if (results.size() > limit) {
+		std::partial_sort(results.begin(), results.begin() + limit, results.end(), better);
+		results.resize(limit);
+	}
+	else {
+		std::sort(results.begin(), results.end(), better);
+	}
+	return results;
+}
+
+size_t TabSearchIndex::PostingCount() const {
+	size_t count = 0;
+	for (const auto& [key, list] : m_postings) {
+		count += list.size();
+	}
+	return count;
+}
+
+void TabSearchIndex::RemovePosting(uint64_t key, uint32_t index) {
+	auto list = m_postings.find(key);
+	list->second.erase(std::lower_bound(list->second.begin(), list->second.end(), index));
+	if (list->second.empty()) {
+		m_postings.erase(list);
+	}
+}
+
+void TabSearchIndex::AddPosting(uint64_t key, uint32_t index) {
+	std::vector<uint32_t>& list = m_postings[key];
+	list.insert(std::lower_bound(list.begin(), list.end(), index), index);
+}
+
+void TabSearchIndex::CompactText() {
+	std::wstring text;
+	text.reserve(m_liveText);
+	for (Entry& entry : m_entries) {
+		size_t offset = text.size();
+		text.append(m_text, entry.text, static_cast<size_t>(entry.titleLength) + entry.urlLength);
+		entry.text = offset;
+	}
+	m_text = std::move(text);
+}
+
+// Intersects the posting lists, smallest first, so the candidates only
+// shrink. Returns false if some key has no postings at all.
+bool TabSearchIndex::Intersect(const std::vector<uint64_t>& keys, std::vector<uint32_t>& candidates) const {
+	std::vector<const std::vector<uint32_t>*> lists;
+	for (uint64_t key : keys) {
+		auto list = m_postings.find(key);
+		if (list == m_postings.end()) {
+			return false;
+		}
+		lists.push_back(&list->second);
+	}
+	std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+	candidates = *lists[0];
+	for (size_t i = 1; i < lists.size() && !candidates.empty(); i++) {
+		IntersectInPlace(candidates, *lists[i]);
+	}
+	return true;
+}
+
+// Keys can match out of order, so the terms themselves are checked while scoring
+void TabSearchIndex::Collect(const std::vector<uint32_t>& candidates, const std::vector<std::wstring>& terms,
+	std::vector<TabSearchResult>& results) const {
+	m_stats.candidates += candidates.size();
+	for (uint32_t index : candidates) {
+		const Entry& entry = m_entries[index];
+		int score = Score(entry, terms);
+		if (score > 0) {
+			results.push_back({ entry.tab, score });
+		}
+	}
+}
+
+// 0 unless every term matches. Shorter titles win ties, as they are closer matches.
+int TabSearchIndex::Score(const Entry& entry, const std::vector<std::wstring>& terms) const {
+	int score = 0;
+	for (const std::wstring& term : terms) {
+		int title = MatchQuality(Title(entry), term);
+		int url = title ? 0 : MatchQuality(Url(entry), term);
+		if (!title && !url) {
+			return 0;
+		}
+		score += title ? 100 + 100 * title : 20 * url;
+	}
+	return score * 16 - static_cast<int>(std::min<uint32_t>(entry.titleLength, 15));
+}
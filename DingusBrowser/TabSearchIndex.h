@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Trigram index over open tabs' titles and URLs.
+//
+// Each tab's text is folded to lower case and cut into overlapping three
+// character trigrams. Every trigram has a posting list: the sorted indices
+// of the entries that contain it, as a plain uint32_t array. Update only
+// touches the posting lists of keys that were added or dropped, so keeping
+// the index current from title and navigation events is cheap. A query
+// intersects the lists of its trigrams, smallest first, then checks and
+// ranks only the tabs that survive. Queries too short for a trigram go
+// through the one and two character prefixes of title words, which hold the
+// best matches, and only scan every tab when those are too few. Kept free of
+// Win32 so it can be exercised outside the browser.
+
+struct TabSearchResult {
+	uint32_t tab = 0;
+	int score = 0;  // Higher is better
+};
+
+struct TabSearchStats {
+	uint64_t updates = 0;
+	uint64_t queries = 0;
+	uint64_t candidates = 0;  // Tabs checked after the posting lists were intersected
+};
+
+class TabSearchIndex {
+public:
+	// Adds the tab or replaces its text
+	void Update(uint32_t tab, std::wstring_view title, std::wstring_view url);
+	void Remove(uint32_t tab);
+
+	// Tabs whose title or URL contains every space-separated term of query,
+	// best first, at most limit of them. Matches in the title rank above
+	// matches in the URL, and matches at the start of a word above matches
+	// inside one.
+	std::vector<TabSearchResult> Search(std::wstring_view query, size_t limit) const;
+
+	size_t Size() const { return m_entries.size(); }
+	size_t PostingCount() const;
+
+	const TabSearchStats& Stats() const { return m_stats; }
+
+private:
+	// Entries are packed, and posting lists refer to them by index, so a
+	// query walks one array and one text buffer rather than chasing a
+	// heap string per tab
+	struct Entry {
+		uint32_t tab;
+		size_t text;             // Offset of the folded title in m_text; the URL follows it
+		uint32_t titleLength;
+		uint32_t urlLength;
+		std::vector<uint64_t> keys;  // Trigrams and title word prefixes; sorted, unique
+	};
+
+	std::wstring_view Title(const Entry& entry) const { return std::wstring_view(m_text).substr(entry.text, entry.titleLength); }
+	std::wstring_view Url(const Entry& entry) const { return std::wstring_view(m_text).substr(entry.text + entry.titleLength, entry.urlLength); }
+
+	void RemovePosting(uint64_t key, uint32_t index);
+	void AddPosting(uint64_t key, uint32_t index);
+
+	// Drops the text of replaced and removed entries once it outweighs the live text
+	void CompactText();
+
+	bool Intersect(const std::vector<uint64_t>& keys, std::vector<uint32_t>& candidates) const;
+	void Collect(const std::vector<uint32_t>& candidates, const std::vector<std::wstring>& terms,
+		std::vector<TabSearchResult>& results) const;
+	int Score(const Entry& entry, const std::vector<std::wstring>& terms) const;
+
+	std::vector<Entry> m_entries;
+	std::unordered_map<uint32_t, uint32_t> m_slots;  // Tab to entry index
+	std::wstring m_text;                             // Folded titles and URLs, appended on update
+	size_t m_liveText = 0;
+	std::unordered_map<uint64_t, std::vector<uint32_t>> m_postings;  // Key to sorted entry indices
+	mutable TabSearchStats m_stats;
+};
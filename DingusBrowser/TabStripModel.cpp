@@ -0,0 +1,227 @@
+#include "TabStripModel.h"
+
+#include <algorithm>
+
+int TabStripModel::Insert(int position, int width) {
+	position = std::clamp(position, 0, Count());
+	int left, right;
+	Split(m_root, position, left, right);
+	int node = NewNode(width);
+	SetRoot(Merge(Merge(left, node), right));
+	return node;
+}
+
+void TabStripModel::Erase(int position) {
+	if (position < 0 || position >= Count()) {
+		return;
+	}
+	int left, middle, right;
+	Split(m_root, position, left, right);
+	Split(right, 1, middle, right);
+	m_nodes[middle].left = m_freeHead;
+	m_freeHead = middle;
+	SetRoot(Merge(left, right));
+}
+
+void TabStripModel::ResetWidths(int width) {
+	ResetSubtreeWidths(m_root, width);
+}
+
+int TabStripModel::Position(int id) const {
+	int position = Size(m_nodes[id].left);
+	for (int node = id; m_nodes[node].parent != NIL; node = m_nodes[node].parent) {
+		const Node& parent = m_nodes[m_nodes[node].parent];
+		if (parent.right == node) {
+			position += Size(parent.left) + 1;
+		}
+	}
+	return position;
+}
+
+int TabStripModel::IdAt(int position) const {
+	if (position < 0 || position >= Count()) {
+		return NIL;
+	}
+	int node = m_root;
+	for (;;) {
+		const Node& n = m_nodes[node];
+		int leftSize = Size(n.left);
+		if (position < leftSize) {
+			node = n.left;
+		}
+		else if (position == leftSize) {
+			return node;
+		}
+		else {
+			position -= leftSize + 1;
+			node = n.right;
+		}
+	}
+}
+
+void TabStripModel::SetWidth(int position, int width) {
+	if (position >= 0 && position < Count()) {
+		SetNodeWidth(m_root, position, width);
+	}
+}
+
+int TabStripModel::Width(int position) const {
+	int node = IdAt(position);
+	return node == NIL ? 0 : m_nodes[node].width;
+}
+
+int TabStripModel::Offset(int position) const {
+	position = std::clamp(position, 0, Count());
+	int offset = 0;
+	int node = m_root;
+	while (node != NIL) {
+		const Node& n = m_nodes[node];
+		int leftSize = Size(n.left);
+		if (position <= leftSize) {
+			node = n.left;
+		}
+		else {
+			offset += Sum(n.left) + n.width;
+			position -= leftSize + 1;
+			node = n.right;
+		}
+	}
+	return offset;
+}
+
+int TabStripModel::HitTest(int x) const {
+	if (x < 0 || x >= TotalWidth()) {
+		return -1;
+	}
+	int position = 0;
+	int node = m_root;
+	for (;;) {
+		const Node& n = m_nodes[node];
+		int leftSum = Sum(n.left);
+		if (x < leftSum) {
+			node = n.left;
+		}
+		else if (x < leftSum + n.width) {
+			return position + Size(n.left);
+		}
+		else {
+			x -= leftSum + n.width;
+			position += Size(n.left) + 1;
+			node = n.right;
+		}
+	}
+}
+
+bool TabStripModel::SetScroll(int scroll, int viewWidth) {
+	scroll = std::clamp(scroll, 0, std::max(0, TotalWidth() - viewWidth));
+	bool moved = scroll != m_scroll;
+	m_scroll = scroll;
+	return moved;
+}
+
+bool TabStripModel::ScrollIntoView(int position, int viewWidth) {
+	if (position < 0 || position >= Count()) {
+		return SetScroll(m_scroll, viewWidth);
+	}
+	int left = Offset(position);
+	int right = left + Width(position);
+	int scroll = m_scroll;
+	if (right > scroll + viewWidth) {
+		scroll = right - viewWidth;
+	}
+	if (left < scroll) {
+		scroll = left;
+	}
+	return SetScroll(scroll, viewWidth);
+}
+
+int TabStripModel::NewNode(int width) {
+	// xorshift32 is plenty for treap priorities
+	m_seed ^= m_seed << 13;
+	m_seed ^= m_seed >> 17;
+	m_seed ^= m_seed << 5;
+	Node node = { width, width, 1, m_seed, NIL, NIL, NIL };
+
+	if (m_freeHead != NIL) {
+		int index = m_freeHead;
+		m_freeHead = m_nodes[index].left;
+		m_nodes[index] = node;
+		return index;
+	}
+	m_nodes.push_back(node);
+	return static_cast<int>(m_nodes.size()) - 1;
+}
+
+void TabStripModel::Update(int node) {
+	Node& n = m_nodes[node];
+	n.size = Size(n.left) + 1 + Size(n.right);
+	n.sum = Sum(n.left) + n.width + Sum(n.right);
+	if (n.left != NIL) m_nodes[n.left].parent = node;
+	if (n.right != NIL) m_nodes[n.right].parent = node;
+}
+
+void TabStripModel::SetRoot(int root) {
+	m_root = root;
+	if (root != NIL) {
+		m_nodes[root].parent = NIL;
+	}
+}
+
+void TabStripModel::ResetSubtreeWidths(int node, int width) {
+	if (node == NIL) {
+		return;
+	}
+	m_nodes[node].width = width;
+	ResetSubtreeWidths(m_nodes[node].left, width);
+	ResetSubtreeWidths(m_nodes[node].right, width);
+	Update(node);
+}
+
+void TabStripModel::Split(int tree, int count, int& left, int& right) {
+	if (tree == NIL) {
+		left = right = NIL;
+		return;
+	}
+	Node& n = m_nodes[tree];
+	if (count <= Size(n.left)) {
+		Split(n.left, count, left, m_nodes[tree].left);
+		right = tree;
+	}
+	else {
+		Split(n.right, count - Size(n.left) - 1, m_nodes[tree].right, right);
+		left = tree;
+	}
+	Update(tree);
+}
+
+int TabStripModel::Merge(int left, int right) {
+	if (left == NIL) {
+		return right;
+	}
+	if (right == NIL) {
+		return left;
+	}
+	if (m_nodes[left].priority > m_nodes[right].priority) {
+		m_nodes[left].right = Merge(m_nodes[left].right, right);
+		Update(left);
+		return left;
+	}
+	m_nodes[right].left = Merge(left, m_nodes[right].left);
+	Update(right);
+	return right;
+}
+
+void TabStripModel::SetNodeWidth(int node, int position, int width) {
+	Node& n = m_nodes[node];
+	int leftSize = Size(n.left);
+	if (position < leftSize) {
+		SetNodeWidth(n.left, position, width);
+	}
+	else if (position == leftSize) {
+		n.width = width;
+	}
+	else {
+		SetNodeWidth(n.right, position - leftSize - 1, width);
+	}
+	Update(node);
+}
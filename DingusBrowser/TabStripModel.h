@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Tab widths and scrolling for the tab strip.
+//
+// Tabs are kept in strip order in an implicit treap: each node holds one
+// tab's width, and every subtree knows its tab count and total width. That
+// makes insert and erase at any position, changing a width, finding a tab's
+// left edge and hit testing all O(log n), so a strip with thousands of tabs
+// costs no more per change than one with ten. The caller only measures and
+// paints the tabs that are in view; the rest keep an estimated width until
+// they scroll in.
+//
+// Each tab also gets an id when it is inserted. Ids stay put while tabs
+// around them come and go, and nodes link to their parents, so the caller
+// can map a tab to its position (and back) in O(log n) instead of keeping
+// its own order array.
+class TabStripModel {
+public:
+	// Returns the new tab's id. An erased tab's id is reused by a later insert.
+	int Insert(int position, int width);
+	void Erase(int position);
+
+	// Gives every tab the same width, keeping their ids
+	void ResetWidths(int width);
+
+	// Position of the tab with this id, which must not have been erased
+	int Position(int id) const;
+
+	// Id of the tab at position, or -1
+	int IdAt(int position) const;
+
+	void SetWidth(int position, int width);
+	int Width(int position) const;
+
+	// Left edge of the tab in strip coordinates
+	int Offset(int position) const;
+
+	// Tab under strip x, or -1 past either end
+	int HitTest(int x) const;
+
+	int Count() const { return Size(m_root); }
+	int TotalWidth() const { return Sum(m_root); }
+
+	// Left edge of the view in strip coordinates
+	int Scroll() const { return m_scroll; }
+
+	// Clamps scroll so the view stays on the strip. Returns true if it moved.
+	bool SetScroll(int scroll, int viewWidth);
+
+	// Scrolls as little as possible to show the whole tab
+	bool ScrollIntoView(int position, int viewWidth);
+
+private:
+	static constexpr int NIL = -1;
+
+	struct Node {
+		int width;
+		int sum;         // Total width of the subtree
+		int size;        // Tabs in the subtree
+		uint32_t priority;
+		int left, right; // Left doubles as the free list link
+		int parent;
+	};
+
+	int Size(int node) const { return node == NIL ? 0 : m_nodes[node].size; }
+	int Sum(int node) const { return node == NIL ? 0 : m_nodes[node].sum; }
+
+	int NewNode(int width);
+
+	// Recomputes size and sum, and points the children back at node
+	void Update(int node);
+	void SetRoot(int root);
+	void ResetSubtreeWidths(int node, int width);
+
+	// Splits off the first count tabs of tree into left; the rest go to right
+	void Split(int tree, int count, int& left, int& right);
+	int Merge(int left, int right);
+	void SetNodeWidth(int node, int position, int width);
+
+	std::vector<Node> m_nodes;
+	int m_root = NIL;
+	int m_freeHead = NIL;
+	uint32_t m_seed = 0x9E3779B9;
+	int m_scroll = 0;
+};
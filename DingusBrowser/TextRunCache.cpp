@@ -0,0 +1,101 @@
+#include "TextRunCache.h"
+
+namespace {
+	// FNV-1a over the UTF-16 code units
+	uint64_t HashText(std::wstring_view text) {
+		uint64_t hash = 0xcbf29ce484222325ULL;
+		for (wchar_t c : text) {
+			hash ^= static_cast<uint16_t>(c);
+			hash *= 0x100000001b3ULL;
+		}
+		return hash;
+	}
+
+	// Code points whose rendering depends on their neighbours
+	bool NeedsShaping(uint32_t c) {
+		return (c >= 0x0300 && c <= 0x036F) ||   // Combining diacritics
+			(c >= 0x0590 && c <= 0x1CFF) ||      // Right-to-left and Indic/Southeast Asian scripts
+			(c >= 0x200B && c <= 0x200F) ||      // Zero-width and direction marks
+			(c >= 0x202A && c <= 0x202E) ||
+			(c >= 0xFB1D && c <= 0xFEFF);        // Presentation forms and variation selectors
+	}
+}
+
+int TextRun::FitCount(int maxWidth, int ellipsisWidth) const {
+	if (Width() <= maxWidth) {
+		return Count();
+	}
+
+	// Last glyph whose right edge leaves room for the ellipsis
+	int limit = maxWidth - ellipsisWidth;
+	int low = 0, high = Count();
+	while (low < high) {
+		int mid = (low + high + 1) / 2;
+		if (offsets[mid] <= limit) low = mid;
+		else high = mid - 1;
+	}
+	return low;
+}
+
+TextRunCache::TextRunCache(GlyphAtlas& atlas, size_t capacity)
+	: m_atlas(atlas), m_capacity(capacity ? capacity : 1) {}
+
+const TextRun& TextRunCache::Layout(std::wstring_view text) {
+	uint64_t hash = HashText(text);
+	auto it = m_index.find(hash);
+	if (it != m_index.end() && it->second->first == text) {
+		m_stats.hits++;
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		return it->second->second;
+	}
+	m_stats.misses++;
+
+	if (it != m_index.end()) {
+		// Hash collision: the new text takes over the slot
+		m_entries.erase(it->second);
+		m_index.erase(it);
+	}
+	else if (m_entries.size() >= m_capacity) {
+		m_index.erase(HashText(m_entries.back().first));
+		m_entries.pop_back();
+		m_stats.evictions++;
+	}
+
+	m_entries.emplace_front(std::wstring(text), TextRun());
+	m_index.emplace(hash, m_entries.begin());
+	LayoutRun(text, m_entries.front().second);
+	return m_entries.front().second;
+}
+
+void TextRunCache::LayoutRun(std::wstring_view text, TextRun& run) {
+	run.codePoints.clear();
+	run.offsets.clear();
+	run.simple = true;
+
+	int pen = 0;
+	for (size_t i = 0; i < text.size(); i++) {
+		uint32_t c = static_cast<uint32_t>(text[i]);
+		if (c >= 0xD800 && c <= 0xDBFF && i + 1 < text.size() &&
+			text[i + 1] >= 0xDC00 && text[i + 1] <= 0xDFFF) {
+			c = 0x10000 + ((c - 0xD800) << 10) + (static_cast<uint32_t>(text[i + 1]) - 0xDC00);
+			i++;
+		}
+
+		const AtlasGlyph* glyph = NeedsShaping(c) ? nullptr : m_atlas.Get(c);
+		if (!glyph) {
+			run.simple = false;
+		}
+		run.codePoints.push_back(c);
+		run.offsets.push_back(pen);
+		pen += glyph ? glyph->metrics.advance : 0;
+	}
+	run.offsets.push_back(pen);
+}
+
+int TextRunCache::EllipsisWidth() {
+	if (m_ellipsisWidth < 0) {
+		const AtlasGlyph* glyph = m_atlas.Get(ELLIPSIS);
+		m_ellipsisWidth = glyph ? glyph->metrics.advance : 0;
+	}
+	return m_ellipsisWidth;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GlyphAtlas.h"
+
+// Laid-out chrome text, cached by content.
+//
+// A run holds the code points of a string and the pen position of each
+// glyph, so measuring it, fitting it to a width with an ellipsis and drawing
+// it need no further layout. Runs are kept in an LRU keyed by a hash of the
+// text; one cache serves one font (its glyph atlas).
+//
+// Layout is plain left-to-right advance accumulation. Text that needs real
+// shaping (combining marks, complex scripts, glyphs the font lacks) is marked
+// not simple so the caller can fall back to the platform text renderer.
+
+struct TextRun {
+	std::vector<uint32_t> codePoints;
+	std::vector<int> offsets;   // Pen x before each glyph, plus the total width
+	bool simple = true;
+
+	int Count() const { return static_cast<int>(codePoints.size()); }
+	int Width() const { return offsets.empty() ? 0 : offsets.back(); }
+
+	// Number of leading glyphs to draw within maxWidth. When the whole run
+	// does not fit, room is left for an ellipsis of ellipsisWidth.
+	int FitCount(int maxWidth, int ellipsisWidth) const;
+};
+
+struct TextRunCacheStats {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t evictions = 0;
+};
+
+class TextRunCache {
+public:
+	static constexpr uint32_t ELLIPSIS = 0x2026;
+
+	TextRunCache(GlyphAtlas& atlas, size_t capacity);
+
+	TextRunCache(const TextRunCache&) = delete;
+	TextRunCache& operator=(const TextRunCache&) = delete;
+
+	// Returns the run for text, laying it out on a miss. The reference stays
+	// valid until the entry is evicted.
+	const TextRun& Layout(std::wstring_view text);
+
+	// Width of the ellipsis glyph, or 0 if the font has none
+	int EllipsisWidth();
+
+	GlyphAtlas& Atlas() { return m_atlas; }
+	const TextRunCacheStats& Stats() const { return m_stats; }
+
+private:
+	using Entry = std::pair<std::wstring, TextRun>;
+
+	void LayoutRun(std::wstring_view text, TextRun& run);
+
+	GlyphAtlas& m_atlas;
+	size_t m_capacity;
+	std::list<Entry> m_entries;  // Most recently used first
+	std::unordered_map<uint64_t, std::list<Entry>::iterator> m_index;
+	int m_ellipsisWidth = -1;
+	TextRunCacheStats m_stats;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "SvgPath.h"
+
+// Toolbar icon geometry from Icons.svg (24x24 viewBox), compiled into static
+// arrays at build time. Keep these strings in sync with the symbol sheet.
+namespace ToolbarIcons {
+	using Back = Svg::CompiledPath<"M20 11H7.83l5.59-5.59L12 4l-8 8 8 8 1.41-1.41L7.83 13H20v-2z">;
+	using Forward = Svg::CompiledPath<"M12 4l-1.41 1.41L16.17 11H4v2h12.17l-5.58 5.59L12 20l8-8z">;
+	using Refresh = Svg::CompiledPath<"M17.65 6.35A7.958 7.958 0 0012 4c-4.42 0-7.99 3.58-7.99 8s3.57 8 7.99 8c3.73 0 6.84-2.55 7.73-6h-2.08A5.99 5.99 0 0112 18c-3.31 0-6-2.69-6-6s2.69-6 6-6c1.66 0 3.14.69 4.22 1.78L13 11h7V4l-2.35 2.35z">;
+	using Home = Svg::CompiledPath<"M10 20v-6h4v6h5v-8h3L12 3 2 12h3v8z">;
+	using Bookmark = Svg::CompiledPath<"M17 3H7c-1.1 0-1.99.9-1.99 2L5 21l7-3 7 3V5c0-1.1-.9-2-2-2z">;
+}
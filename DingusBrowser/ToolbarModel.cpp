@@ -0,0 +1,55 @@
+#include "ToolbarModel.h"
+
+void ToolbarModel::Reset() {
+	m_buttons.clear();
+	m_hovered = -1;
+	m_damaged = false;
+	m_stats = Stats();
+}
+
+int ToolbarModel::AddButton(int commandId, const ToolbarRect& rect) {
+	ToolbarButton button;
+	button.commandId = commandId;
+	button.rect = rect;
+	m_buttons.push_back(button);
+	return Count() - 1;
+}
+
+int ToolbarModel::HitTest(int x, int y) const {
+	for (int i = 0; i < Count(); i++) {
+		if (m_buttons[i].rect.Contains(x, y)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+bool ToolbarModel::SetHovered(int index) {
+	if (index < 0 || index >= Count()) {
+		index = -1;
+	}
+	if (index == m_hovered) {
+		return false;
+	}
+
+	Invalidate(m_hovered);
+	Invalidate(index);
+	m_hovered = index;
+	m_stats.hoverChanges++;
+	return true;
+}
+
+void ToolbarModel::Invalidate(int index) {
+	if (index < 0 || index >= Count() || m_buttons[index].dirty) {
+		return;
+	}
+	m_buttons[index].dirty = true;
+	m_damaged = true;
+	m_stats.damagedButtons++;
+}
+
+void ToolbarModel::InvalidateAll() {
+	for (int i = 0; i < Count(); i++) {
+		Invalidate(i);
+	}
+}
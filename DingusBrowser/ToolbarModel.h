@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Retained toolbar state.
+//
+// Caches what the toolbar paint and hover code needs about each button (command,
+// rect, hover state) so neither has to query the toolbar control per button.
+// State changes mark the affected buttons dirty, and FlushDamage hands back
+// just those rects for invalidation: a hover move repaints the button that
+// was left and the one that was entered, not the whole bar.
+// Kept free of Win32 so the damage tracking can be exercised outside the browser.
+
+struct ToolbarRect {
+	int left = 0, top = 0, right = 0, bottom = 0;
+
+	bool Contains(int x, int y) const { return x >= left && x < right && y >= top && y < bottom; }
+
+	bool Intersects(const ToolbarRect& other) const {
+		return left < other.right && other.left < right && top < other.bottom && other.top < bottom;
+	}
+};
+
+struct ToolbarButton {
+	int commandId = 0;
+	ToolbarRect rect;
+	bool dirty = false;
+};
+
+class ToolbarModel {
+public:
+	// Rebuilds the button list. Does not damage anything, since a layout
+	// change repaints the whole bar anyway.
+	void Reset();
+	int AddButton(int commandId, const ToolbarRect& rect);
+
+	int Count() const { return static_cast<int>(m_buttons.size()); }
+	const ToolbarButton& At(int index) const { return m_buttons[index]; }
+
+	// Index of the button under (x, y), or -1
+	int HitTest(int x, int y) const;
+
+	int Hovered() const { return m_hovered; }
+
+	// Moves the hover highlight and damages the old and new buttons.
+	// Returns false if nothing changed.
+	bool SetHovered(int index);
+
+	void Invalidate(int index);
+	void InvalidateAll();
+
+	// Calls invalidate(rect) for every dirty button and clears the flags
+	template <typename Fn>
+	void FlushDamage(Fn&& invalidate) {
+		if (!m_damaged) {
+			return;
+		}
+		for (ToolbarButton& button : m_buttons) {
+			if (button.dirty) {
+				button.dirty = false;
+				invalidate(button.rect);
+			}
+		}
+		m_damaged = false;
+	}
+
+	// Counts hover changes and damaged buttons since the last Reset
+	struct Stats {
+		uint64_t hoverChanges = 0;
+		uint64_t damagedButtons = 0;
+	};
+	const Stats& GetStats() const { return m_stats; }
+
+private:
+	std::vector<ToolbarButton> m_buttons;
+	int m_hovered = -1;
+	bool m_damaged = false;
+	Stats m_stats;
+};
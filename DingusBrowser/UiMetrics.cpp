@@ -0,0 +1,48 @@
+#include "UiMetrics.h"
+
+namespace {
+	int Scale(int value, int from, int to) {
+		if (value == 0) {
+			return 0;
+		}
+		int magnitude = value < 0 ? -value : value;
+		long long scaled = (static_cast<long long>(magnitude) * to + from / 2) / from;
+		int result = scaled < 1 ? 1 : static_cast<int>(scaled);
+		return value < 0 ? -result : result;
+	}
+}
+
+UiMetrics ScaleUiMetrics(const UiMetrics& base, int dpi) {
+	int from = base.dpi > 0 ? base.dpi : 96;
+	auto scale = [from, dpi](int value) { return Scale(value, from, dpi); };
+
+	UiMetrics metrics;
+	metrics.dpi = dpi;
+	metrics.toolbarHeight = scale(base.toolbarHeight);
+	metrics.tabHeight = scale(base.tabHeight);
+	metrics.urlBarHeight = scale(base.urlBarHeight);
+	metrics.padding = scale(base.padding);
+	metrics.iconSize = scale(base.iconSize);
+	metrics.fontHeight = scale(base.fontHeight);
+	metrics.maxTabTitleWidth = scale(base.maxTabTitleWidth);
+	metrics.urlBarRadius = scale(base.urlBarRadius);
+	metrics.urlBarTextPadding = scale(base.urlBarTextPadding);
+	metrics.tabTextPadding = scale(base.tabTextPadding);
+	metrics.tabUnderline = scale(base.tabUnderline);
+	metrics.tabSeparatorInset = scale(base.tabSeparatorInset);
+	return metrics;
+}
+
+const UiMetrics& UiMetricsCache::Get(int dpi) {
+	if (dpi <= 0) {
+		dpi = m_base.dpi;
+	}
+	// A process only ever sees a few DPIs, one per monitor scale
+	for (const auto& table : m_tables) {
+		if (table->dpi == dpi) {
+			return *table;
+		}
+	}
+	m_tables.push_back(std::make_unique<UiMetrics>(ScaleUiMetrics(m_base, dpi)));
+	return *m_tables.back();
+}
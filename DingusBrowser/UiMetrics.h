@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+// Chrome sizes for one DPI.
+//
+// Every size the chrome lays out or rasterizes lives in one table. The
+// defaults below are the 96 DPI table; UiMetricsCache scales a full copy once
+// per DPI, so paint and layout code only reads fields instead of scaling
+// values as it goes.
+struct UiMetrics {
+	int dpi = 96;
+
+	int toolbarHeight = 30;
+	int tabHeight = 30;
+	int urlBarHeight = 30;
+	int padding = 8;
+
+	int iconSize = 20;
+	int fontHeight = -14;  // As passed to CreateFont: negative means character height
+	int maxTabTitleWidth = 200;
+
+	int urlBarRadius = 4;
+	int urlBarTextPadding = 8;
+	int tabTextPadding = 8;
+	int tabUnderline = 2;
+	int tabSeparatorInset = 4;
+};
+
+// Scales every size in base from base.dpi to dpi, rounding to the nearest
+// pixel. Sizes that are not zero stay at least one pixel.
+UiMetrics ScaleUiMetrics(const UiMetrics& base, int dpi);
+
+// Scaled tables by DPI. Tables are built on first use and kept, so the
+// references handed out stay valid for the life of the cache.
+class UiMetricsCache {
+public:
+	explicit UiMetricsCache(const UiMetrics& base = UiMetrics()) : m_base(base) {}
+
+	const UiMetrics& Get(int dpi);
+
+	int Count() const { return static_cast<int>(m_tables.size()); }
+
+private:
+	UiMetrics m_base;
+	std::vector<std::unique_ptr<UiMetrics>> m_tables;
+};
@@ -0,0 +1,40 @@
+#include "UrlInput.h"
+
+namespace UrlInput {
+
+	namespace {
+		bool StartsWith(std::wstring_view text, std::wstring_view prefix) {
+			return text.substr(0, prefix.size()) == prefix;
+		}
+
+		std::wstring_view TrimSpacesAndTabs(std::wstring_view text) {
+			size_t begin = text.find_first_not_of(L" \t");
+			if (begin == std::wstring_view::npos) {
+				return std::wstring_view();
+			}
+			return text.substr(begin, text.find_last_not_of(L" \t") + 1 - begin);
+		}
+	}
+
+	Resolved Resolve(std::wstring_view text) {
+		if (text.find(L"://") != std::wstring_view::npos) {
+			return { Kind::Url, std::wstring(text) };
+		}
+		if (StartsWith(text, L"localhost") || StartsWith(text, L"127.0.0.1")) {
+			return { Kind::Local, L"http://" + std::wstring(text) };
+		}
+		if (StartsWith(text, L"/") || (text.size() > 1 && text[1] == L':')) {
+			return { Kind::File, L"file:///" + std::wstring(text) };
+		}
+
+		// Only host names are trimmed; a search keeps the text as typed
+		std::wstring_view host = TrimSpacesAndTabs(text);
+		if (StartsWith(host, L"www.")) {
+			return { Kind::Web, L"https://" + std::wstring(host) };
+		}
+		if (host.find(L'.') != std::wstring_view::npos) {
+			return { Kind::Web, L"https://www." + std::wstring(host) };
+		}
+		return { Kind::Search, L"https://www.google.com/search?q=" + std::wstring(text) };
+	}
+}
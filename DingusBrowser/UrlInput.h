@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// URL bar input resolution.
+//
+// Turns whatever was typed into the URL bar into an address to navigate to:
+// full URLs pass through, local hosts get http://, file paths get file:///,
+// text with a dot gets https:// (and www. if it has none) and anything else
+// becomes a search. Kept free of Win32 so it can be exercised outside the
+// browser.
+namespace UrlInput {
+
+	enum class Kind {
+		Url,     // Already had a scheme
+		Local,   // localhost or 127.0.0.1
+		File,    // Absolute or drive-letter path
+		Web,     // Host name without a scheme
+		Search
+	};
+
+	struct Resolved {
+		Kind kind;
+		std::wstring url;
+	};
+
+	Resolved Resolve(std::wstring_view text);
+}
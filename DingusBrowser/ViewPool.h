@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Pool of pre-created web views.
+//
+// Creating a view is slow and asynchronous, so the pool keeps a few hidden
+// ones ready. Acquire hands out a ready view at once when there is one;
+// otherwise the caller waits for the next view to finish, which may already
+// be on its way. Every Acquire tops the pool back up in the background.
+// The engine that actually creates views is behind ViewEngine, so the policy
+// can run against a fake one.
+
+template <typename View>
+class ViewEngine {
+public:
+	// Called once per CreateView, possibly before CreateView returns
+	using Ready = std::function<void(bool succeeded, View view)>;
+
+	virtual ~ViewEngine() = default;
+
+	// Views are created hidden
+	virtual void CreateView(Ready ready) = 0;
+	virtual void DestroyView(View view) = 0;
+};
+
+struct ViewPoolStats {
+	uint64_t acquires = 0;
+	uint64_t warmHits = 0;    // Acquires served from a ready view
+	uint64_t created = 0;
+	uint64_t failures = 0;
+	uint64_t recycled = 0;
+};
+
+template <typename View>
+class ViewPool {
+public:
+	using Ready = typename ViewEngine<View>::Ready;
+
+	ViewPool(ViewEngine<View>& engine, int warmCount) : m_engine(engine), m_warmCount(warmCount) {}
+
+	ViewPool(const ViewPool&) = delete;
+	ViewPool& operator=(const ViewPool&) = delete;
+
+	~ViewPool() { Clear(); }
+
+	// Calls ready with a view, right away if one is warm. Waiters are served
+	// in order. A failed creation fails the oldest waiter.
+	void Acquire(Ready ready) {
+		m_stats.acquires++;
+		if (!m_ready.empty()) {
+			m_stats.warmHits++;
+		}
+		m_waiters.push_back(std::move(ready));
+		Dispatch();
+		Refill();
+	}
+
+	// Takes back a view that was acquired but never used; destroys it if the
+	// pool is already full
+	void Recycle(View view) {
+		if (!m_closed && static_cast<int>(m_ready.size()) < m_warmCount) {
+			m_ready.push_back(std::move(view));
+			m_stats.recycled++;
+			Dispatch();
+		}
+		else {
+			m_engine.DestroyView(std::move(view));
+		}
+	}
+
+	// Starts enough creations to cover the waiters plus the warm count
+	void Refill() {
+		while (!m_closed && static_cast<int>(m_ready.size()) + m_pending < m_warmCount + static_cast<int>(m_waiters.size())) {
+			m_pending++;
+			m_engine.CreateView([this](bool succeeded, View view) {
+				m_pending--;
+				OnCreated(succeeded, std::move(view));
+			});
+		}
+	}
+
+	// Destroys the ready views and drops the waiters. Views still being
+	// created are destroyed when they arrive.
+	void Clear() {
+		m_closed = true;
+		m_waiters.clear();
+		for (View& view : m_ready) {
+			m_engine.DestroyView(std::move(view));
+		}
+		m_ready.clear();
+	}
+
+	int ReadyCount() const { return static_cast<int>(m_ready.size()); }
+	int PendingCount() const { return m_pending; }
+	int WaiterCount() const { return static_cast<int>(m_waiters.size()); }
+
+	const ViewPoolStats& Stats() const { return m_stats; }
+
+private:
+	void OnCreated(bool succeeded, View view) {
+		if (m_closed) {
+			if (succeeded) {
+				m_engine.DestroyView(std::move(view));
+			}
+			return;
+		}
+
+		if (!succeeded) {
+			// Don't retry here, or a broken engine would spin; the next Acquire refills
+			m_stats.failures++;
+			if (!m_waiters.empty()) {
+				Ready ready = std::move(m_waiters.front());
+				m_waiters.pop_front();
+				ready(false, View());
+			}
+			return;
+		}
+
+		m_stats.created++;
+		m_ready.push_back(std::move(view));
+		Dispatch();
+	}
+
+	void Dispatch() {
+		while (!m_ready.empty() && !m_waiters.empty()) {
+			View view = std::move(m_ready.front());
+			m_ready.erase(m_ready.begin());
+			Ready ready = std::move(m_waiters.front());
+			m_waiters.pop_front();
+			ready(true, std::move(view));
+		}
+	}
+
+	ViewEngine<View>& m_engine;
+	int m_warmCount;
+	std::vector<View> m_ready;
+	std::deque<Ready> m_waiters;
+	int m_pending = 0;
+	bool m_closed = false;
+	ViewPoolStats m_stats;
+};
@@ -8,25 +8,50 @@
 #include <vector>
 #include <CommCtrl.h>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <Uxtheme.h>
 #include <vssym32.h>
 #include <dwmapi.h>
-#include <gdiplus.h>
+
+#include "BackBufferPool.h"
+#include "ChromeCanvas.h"
+#include "ChromeLayout.h"
+#include "ChromePaint.h"
+#include "FramePacer.h"
+#include "GlyphAtlas.h"
+#include "IconAtlas.h"
+#include "IconCache.h"
+#include "IconGeometry.h"
+#include "IconRaster.h"
+#include "LatencyHistogram.h"
+#include "NumberParser.h"
+#include "Session.h"
+#include "SessionJournal.h"
+#include "SlotMap.h"
+#include "SvgPath.h"
+#include "SymbolSheet.h"
+#include "TabHibernation.h"
+#include "TabSearchIndex.h"
+#include "TabStripModel.h"
+#include "TextRunCache.h"
+#include "ToolbarIcons.h"
+#include "ToolbarModel.h"
+#include "UiMetrics.h"
+#include "UrlInput.h"
+#include "ViewPool.h"
 
 #define UNICODE
 #define _UNICODE
 
-#pragma comment(lib, "gdiplus.lib")
 #pragma comment(lib, "uxtheme.lib")
 #pragma comment(lib, "comctl32.lib")
+#pragma comment(lib, "msimg32.lib")
 
 using namespace Microsoft::WRL;
 
 constexpr int WINDOW_WIDTH = 1024;
 constexpr int WINDOW_HEIGHT = 1024;
-constexpr int URL_BAR_HEIGHT = 30;
-constexpr int TOOLBAR_HEIGHT = 30;
-constexpr int TAB_HEIGHT = 30;
 
 constexpr int ID_BACK = 1001;
 constexpr int ID_FORWARD = 1002;
@@ -35,7 +60,9 @@ constexpr int ID_HOME = 1004;
 constexpr int ID_NEW_TAB = 1005;
 constexpr int ID_BOOKMARK = 1006;
 constexpr int ID_URLBAR = 1007;
-constexpr int ID_TABCTRL = 1008;
+constexpr int ID_TABSTRIP = 1008;
+constexpr int ID_TAB_SEARCH_EDIT = 1009;
+constexpr int ID_TAB_SEARCH_LIST = 1010;
 
 constexpr int ID_FILE_NEW_TAB = 2001;
 constexpr int ID_FILE_CLOSE_TAB = 2002;
@@ -44,14 +71,15 @@ constexpr int ID_BOOKMARKS_ADD = 2004;
 constexpr int ID_BOOKMARKS_VIEW = 2005;
 constexpr int ID_TOOLS_DEVTOOLS = 2006;
 constexpr int ID_TOOLS_DOWNLOADS = 2007; 
+constexpr int ID_TOOLS_FRAME_TIMINGS = 2008;
+constexpr int ID_FILE_SEARCH_TABS = 2009;
 
-constexpr int ICON_SIZE = 20;
 constexpr COLORREF ICON_COLOR = RGB(95, 99, 104);
 constexpr COLORREF ICON_HOVER_COLOR = RGB(32, 33, 36);
 
 HWND g_hwnd = nullptr;
 HWND g_urlBar = nullptr;
-HWND g_tabControl = nullptr;
+HWND g_tabStrip = nullptr;
 HWND g_toolbar = nullptr;
 
 namespace Colors {
@@ -64,11 +92,23 @@ namespace Colors {
 	const COLORREF InactiveTabColor = RGB(241, 243, 244);
 }
 
-struct IconPath {
-	std::vector<Gdiplus::PointF> points;
-	std::vector<BYTE> types;
+const ChromePaint::Theme g_chromeTheme = {
+	RGB(255, 255, 255),  // Toolbar and URL bar background
+	Colors::AccentColor,
+	Colors::TextColor,
+	Colors::BorderColor,
+	Colors::ActiveTabColor,
+	Colors::InactiveTabColor,
+	ICON_COLOR,
+	ICON_HOVER_COLOR
 };
 
+// Chrome sizes for the main window's DPI. ApplyUiMetrics swaps in the table
+// for a new DPI as a whole; tables stay cached for when the window moves back.
+UiMetricsCache g_uiMetricsCache;
+const UiMetrics* g_metrics = &g_uiMetricsCache.Get(USER_DEFAULT_SCREEN_DPI);
+wil::unique_hfont g_uiFont;
+
 struct WindowStyle {
 	static void ApplyModernStyle(HWND hwnd) {
 		SetWindowTheme(hwnd, L"Explorer", nullptr);
@@ -91,127 +131,710 @@ struct TabInfo {
 	std::wstring title;
 	std::wstring url;
 	WebViewEventTokens tokens;
+	TabSleep sleep = TabSleep::Awake;
+	uint64_t lastActive = 0;     // GetTickCount64 when last shown
+	int scrollY = 0;             // Saved when the tab is left
+	bool restoreScroll = false;  // Set while a discarded tab reloads
+	uint32_t journalId = 0;      // Names the tab in the session journal
+	std::wstring label;          // Text shown on the tab strip
+	bool labelMeasured = false;  // The strip only measures tabs once they come into view
+	int stripId = -1;            // Id in g_tabStripModel
+};
+
+
+// Work coalesced to one run per display frame while the window is dragged
+enum FrameWork : uint32_t {
+	FRAME_WORK_LAYOUT = 1 << 0,  // Chrome windows and WebView bounds
+	FRAME_WORK_PAINT = 1 << 1    // Paint the invalidated chrome right after the layout
+};
+
+constexpr UINT_PTR FRAME_TIMER_ID = 2;
+constexpr UINT_PTR HIBERNATION_TIMER_ID = 3;
+constexpr UINT HIBERNATION_INTERVAL = 30 * 1000;
+
+// Converts performance counter ticks to units per second, e.g. 1000000 for microseconds
+uint64_t PerformanceTicksTo(LONGLONG ticks, uint64_t unitsPerSecond) {
+	static const LONGLONG frequency = [] {
+		LARGE_INTEGER value;
+		QueryPerformanceFrequency(&value);
+		return value.QuadPart;
+	}();
+
+	// Split the conversion so ticks * unitsPerSecond can't overflow
+	return (ticks / frequency) * unitsPerSecond + (ticks % frequency) * unitsPerSecond / frequency;
+}
+
+uint64_t GetMonotonicMicroseconds() {
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return PerformanceTicksTo(now.QuadPart, 1000000);
+}
+
+FramePacer g_framePacer(GetMonotonicMicroseconds, 1000000 / 60);
+bool g_inSizeMove = false;
+
+// Main window layout, top to bottom
+enum LayoutBand {
+	LAYOUT_TOOLBAR,
+	LAYOUT_TABS,
+	LAYOUT_URL_BAR,
+	LAYOUT_CONTENT,
+	LAYOUT_BAND_COUNT
 };
 
+// Rebuilt from the metrics table by ApplyUiMetrics
+ChromeLayout::Band g_chromeLayout[LAYOUT_BAND_COUNT];
+
+// Rects last applied to the chrome windows, so unchanged ones are not moved
+ChromeRect g_chromeRects[LAYOUT_BAND_COUNT];
+
+// Tabs are addressed by handle, so callbacks for a closed tab find nothing
+// instead of another tab. g_tabStripModel holds the strip order; g_stripTabs
+// maps its tab ids back to handles.
+using TabHandle = SlotHandle;
+
+SlotMap<TabInfo> g_tabs;
+TabStripModel g_tabStripModel;  // Tab order, widths and scroll
+std::vector<TabHandle> g_stripTabs;
+TabHandle g_currentTab;
+
+// Session journal, created by RestoreSession. The writer is declared after
+// its storage so it is destroyed first.
+std::unique_ptr<SessionJournal::Storage> g_journalFile;
+std::unique_ptr<SessionJournal::Writer> g_journal;
+uint32_t g_nextJournalId = 1;
+
+// Creates WebView2 controllers from one environment shared by every tab.
+// The environment is created on the first request; requests made before it
+// is ready wait for it.
+class WebViewEngine : public ViewEngine<ComPtr<ICoreWebView2Controller>> {
+public:
+	void CreateView(Ready ready) override {
+		if (m_environment) {
+			CreateController(std::move(ready));
+			return;
+		}
+
+		m_waiting.push_back(std::move(ready));
+		if (m_waiting.size() > 1) {
+			return;
+		}
+		CreateCoreWebView2EnvironmentWithOptions(nullptr, nullptr, nullptr,
+			Callback<ICoreWebView2CreateCoreWebView2EnvironmentCompletedHandler>(
+				[this](HRESULT result, ICoreWebView2Environment* env) -> HRESULT {
+					std::vector<Ready> waiting = std::move(m_waiting);
+					m_waiting.clear();
+					if (FAILED(result) || !env) {
+						for (Ready& ready : waiting) {
+							ready(false, nullptr);
+						}
+						return result;
+					}
+
+					m_environment = env;
+					for (Ready& ready : waiting) {
+						CreateController(std::move(ready));
+					}
+					return S_OK;
+				}).Get());
+	}
+
+	void DestroyView(ComPtr<ICoreWebView2Controller> controller) override {
+		if (controller) {
+			controller->Close();
+		}
+	}
+
+private:
+	void CreateController(Ready ready) {
+		m_environment->CreateCoreWebView2Controller(g_hwnd,
+			Callback<ICoreWebView2CreateCoreWebView2ControllerCompletedHandler>(
+				[ready](HRESULT result, ICoreWebView2Controller* controller) -> HRESULT {
+					if (FAILED(result) || !controller) {
+						ready(false, nullptr);
+						return result;
+					}
+					controller->put_IsVisible(FALSE);
+					ready(true, controller);
+					return S_OK;
+				}).Get());
+	}
+
+	ComPtr<ICoreWebView2Environment> m_environment;
+	std::vector<Ready> m_waiting;
+};
+
+// One hidden controller is kept ready so a new tab doesn't wait on creation
+constexpr int WARM_CONTROLLERS = 1;
+
+WebViewEngine g_webViewEngine;
+ViewPool<ComPtr<ICoreWebView2Controller>> g_controllerPool(g_webViewEngine, WARM_CONTROLLERS);
 
-std::vector<TabInfo> g_tabs;
-int g_currentTab = -1;
+TabInfo* CurrentTab() {
+	return g_tabs.Get(g_currentTab);
+}
+
+// Position of the tab in the tab strip, or -1
+int TabPosition(TabHandle handle) {
+	const TabInfo* tab = g_tabs.Get(handle);
+	return tab ? g_tabStripModel.Position(tab->stripId) : -1;
+}
+
+// Tab at a position in the tab strip
+TabHandle TabAt(int position) {
+	int id = g_tabStripModel.IdAt(position);
+	return id < 0 ? TabHandle() : g_stripTabs[id];
+}
 std::map<std::wstring, std::wstring> g_bookmarks;
 
-std::map<int, IconPath> g_iconPaths;
+// Open tabs by title and URL, keyed by journal id. Kept current from the
+// title and navigation handlers; File > Search Tabs queries it as you type.
+constexpr size_t TAB_SEARCH_RESULTS = 50;
+constexpr wchar_t TAB_SEARCH_CLASS[] = L"DingusTabSearch";
+TabSearchIndex g_tabSearch;
+// Cleared by RestoreSession: restored tabs are indexed when the search box
+// first opens, so a large session does not delay showing the active tab
+bool g_tabSearchBuilt = true;
+HWND g_tabSearchWindow = nullptr;
+HWND g_tabSearchEdit = nullptr;
+HWND g_tabSearchList = nullptr;
+
 UINT_PTR g_toolbarHoverTimer = 0;
-int g_hoveredButton = -1;
+ToolbarModel g_toolbarModel;
+
+// Latency of the chrome paint and layout handlers, shown by Tools > Frame Timings
+enum FrameEvent {
+	FRAME_TOOLBAR_PAINT,
+	FRAME_URLBAR_PAINT,
+	FRAME_TAB_STRIP_PAINT,
+	FRAME_RESIZE,
+	FRAME_EVENT_COUNT
+};
 
-IconPath ParseSVGPath(const wchar_t* pathData) {
-	IconPath result;
+const wchar_t* const FRAME_EVENT_NAMES[FRAME_EVENT_COUNT] = {
+	L"Toolbar paint",
+	L"URL bar paint",
+	L"Tab strip paint",
+	L"Resize"
+};
 
-	// Simple SVG path parser for M, L, and Z commands
-	float currentX = 0, currentY = 0;
-	const wchar_t* p = pathData;
+LatencyHistogram g_frameTimes[FRAME_EVENT_COUNT];
 
-	while (*p) {
-		while (iswspace(*p)) p++;
+// Records the time from construction to destruction into g_frameTimes
+class FrameTimer {
+public:
+	explicit FrameTimer(FrameEvent event) : m_event(event) {
+		QueryPerformanceCounter(&m_start);
+	}
 
-		if (*p == 'M' || *p == 'm') {
-			bool relative = (*p == 'm');
-			p++;
-			float x = wcstof(p, const_cast<wchar_t**>(&p));
-			while (iswspace(*p) || *p == ',') p++;
-			float y = wcstof(p, const_cast<wchar_t**>(&p));
+	~FrameTimer() {
+		LARGE_INTEGER end;
+		QueryPerformanceCounter(&end);
+		g_frameTimes[m_event].Record(PerformanceTicksTo(end.QuadPart - m_start.QuadPart, 1000000000));
+	}
 
-			if (relative) {
-				x += currentX;
-				y += currentY;
-			}
+	FrameTimer(const FrameTimer&) = delete;
+	FrameTimer& operator=(const FrameTimer&) = delete;
 
-			result.points.push_back(Gdiplus::PointF(x, y));
-			result.types.push_back(Gdiplus::PathPointTypeStart);
-			currentX = x;
-			currentY = y;
-		}
-		else if (*p == 'L' || *p == 'l') {
-			bool relative = (*p == 'l');
-			p++;
-			float x = wcstof(p, const_cast<wchar_t**>(&p));
-			while (iswspace(*p) || *p == ',') p++;
-			float y = wcstof(p, const_cast<wchar_t**>(&p));
-
-			if (relative) {
-				x += currentX;
-				y += currentY;
-			}
+private:
+	FrameEvent m_event;
+	LARGE_INTEGER m_start;
+};
 
-			result.points.push_back(Gdiplus::PointF(x, y));
-			result.types.push_back(Gdiplus::PathPointTypeLine);
-			currentX = x;
-			currentY = y;
-		}
-		else if (*p == 'Z' || *p == 'z') {
-			result.types.back() |= Gdiplus::PathPointTypeCloseSubpath;
-			p++;
+template <typename Icon>
+constexpr IconPath MakeIconPath() {
+	return { Icon::Data.points, Icon::Data.types, static_cast<int>(Icon::Count) };
+}
+
+// Indexed by command ID - ID_BACK so painting needs no parsing or lookup
+constexpr IconPath g_toolbarIcons[] = {
+	MakeIconPath<ToolbarIcons::Back>(),      // ID_BACK
+	MakeIconPath<ToolbarIcons::Forward>(),   // ID_FORWARD
+	MakeIconPath<ToolbarIcons::Refresh>(),   // ID_REFRESH
+	MakeIconPath<ToolbarIcons::Home>(),      // ID_HOME
+	{},                                      // ID_NEW_TAB
+	MakeIconPath<ToolbarIcons::Bookmark>()   // ID_BOOKMARK
+};
+
+// Binds command IDs to <symbol> ids in Icons.svg
+struct IconBinding {
+	int commandId;
+	const char* symbolId;
+};
+
+constexpr IconBinding g_iconBindings[] = {
+	{ ID_BACK, "icon-back" },
+	{ ID_FORWARD, "icon-forward" },
+	{ ID_REFRESH, "icon-refresh" },
+	{ ID_HOME, "icon-home" },
+	{ ID_BOOKMARK, "icon-bookmark" },
+	{ ID_BOOKMARKS_ADD, "icon-bookmark" },
+	{ ID_BOOKMARKS_VIEW, "icon-bookmark" }
+};
+
+// Pre-rasterized masks generated from Icons.svg at build time
+wil::unique_mapview_ptr<uint8_t> g_iconAtlasMapping;
+IconAtlas::View g_iconAtlas;
+
+// Icons.svg itself, indexed at startup and parsed per symbol on first use
+wil::unique_mapview_ptr<uint8_t> g_iconSheetMapping;
+SymbolSheet g_iconSheet;
+
+const char* GetIconSymbol(int commandId) {
+	for (const IconBinding& binding : g_iconBindings) {
+		if (binding.commandId == commandId) {
+			return binding.symbolId;
 		}
-		else {
-			p++;
+	}
+	return nullptr;
+}
+
+// Geometry from the symbol sheet, falling back to the compiled-in icons
+const IconPath* GetToolbarIcon(int commandId) {
+	const char* symbol = GetIconSymbol(commandId);
+	if (symbol) {
+		const IconPath* path = g_iconSheet.GetPath(symbol);
+		if (path) {
+			return path;
 		}
 	}
 
-	return result;
+	int index = commandId - ID_BACK;
+	if (index < 0 || index >= static_cast<int>(_countof(g_toolbarIcons)) || g_toolbarIcons[index].count == 0) {
+		return nullptr;
+	}
+	return &g_toolbarIcons[index];
 }
 
-void InitializeIconPaths() {
-	g_iconPaths[ID_BACK] = ParseSVGPath(L"M20 11H7.83l5.59-5.59L12 4l-8 8 8 8 1.41-1.41L7.83 13H20v-2z");
-	g_iconPaths[ID_FORWARD] = ParseSVGPath(L"M12 4l-1.41 1.41L16.17 11H4v2h12.17l-5.58 5.59L12 20l8-8z");
-	g_iconPaths[ID_REFRESH] = ParseSVGPath(L"M17.65 6.35A7.958 7.958 0 0012 4c-4.42 0-7.99 3.58-7.99 8s3.57 8 7.99 8c3.73 0 6.84-2.55 7.73-6h-2.08A5.99 5.99 0 0112 18c-3.31 0-6-2.69-6-6s2.69-6 6-6c1.66 0 3.14.69 4.22 1.78L13 11h7V4l-2.35 2.35z");
-	g_iconPaths[ID_HOME] = ParseSVGPath(L"M10 20v-6h4v6h5v-8h3L12 3 2 12h3v8z");
+const IconAtlas::Entry* GetToolbarAtlasIcon(int commandId, UINT dpi) {
+	const char* symbol = GetIconSymbol(commandId);
+	if (!g_iconAtlas.IsValid() || !symbol) {
+		return nullptr;
+	}
+	return g_iconAtlas.Find(symbol, static_cast<uint16_t>(dpi));
 }
 
-void DrawIcon(HDC hdc, const IconPath& path, int x, int y, COLORREF color) {
-	Gdiplus::Graphics graphics(hdc);
-	graphics.SetSmoothingMode(Gdiplus::SmoothingModeAntiAlias);
+// Maps a file from the executable's directory read-only
+bool MapFileNextToExecutable(const wchar_t* name, wil::unique_mapview_ptr<uint8_t>& view, size_t& size) {
+	wchar_t path[MAX_PATH];
+	DWORD length = GetModuleFileNameW(nullptr, path, MAX_PATH);
+	if (length == 0 || length >= MAX_PATH) return false;
+
+	wchar_t* fileName = wcsrchr(path, L'\\');
+	fileName = fileName ? fileName + 1 : path;
+	if (wcscpy_s(fileName, MAX_PATH - (fileName - path), name) != 0) return false;
+
+	wil::unique_hfile file(CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+	if (!file) return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file.get(), &fileSize) || fileSize.QuadPart == 0) return false;
+
+	wil::unique_handle mapping(CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+	if (!mapping) return false;
+
+	view.reset(static_cast<uint8_t*>(MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0)));
+	size = static_cast<size_t>(fileSize.QuadPart);
+	return view != nullptr;
+}
+
+// Painting falls back to the vector icons when the atlas is missing or invalid
+void LoadIconAtlas() {
+	size_t size = 0;
+	if (!MapFileNextToExecutable(L"icons.atlas", g_iconAtlasMapping, size) ||
+		!g_iconAtlas.Attach(g_iconAtlasMapping.get(), size)) {
+		g_iconAtlasMapping.reset();
+	}
+}
+
+// Only indexes the sheet; symbol paths are parsed when first drawn
+void LoadIconSheet() {
+	size_t size = 0;
+	if (MapFileNextToExecutable(L"Icons.svg", g_iconSheetMapping, size)) {
+		g_iconSheet.Index(reinterpret_cast<const char*>(g_iconSheetMapping.get()), size);
+	}
+}
+
+// One tinted icon as a premultiplied BGRA DIB section
+struct IconBitmap {
+	wil::unique_hbitmap bitmap;
+	int size = 0;
+};
+
+// Rasterized toolbar icons; hover only swaps which entry gets blitted
+IconCache<IconBitmap> g_iconCache(64);
+
+// 32-bit top-down DIB section, so rows line up with coverage masks
+HBITMAP CreateTopDownDib(int width, int height, void** bits) {
+	BITMAPINFO bmi = {};
+	bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bmi.bmiHeader.biWidth = width;
+	bmi.bmiHeader.biHeight = -height;
+	bmi.bmiHeader.biPlanes = 1;
+	bmi.bmiHeader.biBitCount = 32;
+	bmi.bmiHeader.biCompression = BI_RGB;
+	return CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, bits, nullptr, 0);
+}
+
+IconBitmap CreateIconBitmap(const uint8_t* mask, int size, COLORREF color) {
+	IconBitmap icon;
+	void* bits = nullptr;
+	icon.bitmap.reset(CreateTopDownDib(size, size, &bits));
+	if (!icon.bitmap) return icon;
+
+	// AlphaBlend expects premultiplied BGRA
+	IconRaster::TintCoverage(mask, static_cast<uint32_t*>(bits), size * size,
+		GetRValue(color), GetGValue(color), GetBValue(color));
+	icon.size = size;
+	return icon;
+}
+
+// Icon geometry pre-scaled to each pixel size in use, keyed by (size << 16) | command ID.
+// Hover colors and repeated rasterization at one size share the same copy.
+std::map<int, IconGeometry::ScaledIconPath> g_scaledIcons;
+
+const IconGeometry::ScaledIconPath* GetScaledToolbarIcon(int commandId, int size) {
+	int key = (size << 16) | (commandId & 0xFFFF);
+	auto it = g_scaledIcons.find(key);
+	if (it != g_scaledIcons.end()) {
+		return &it->second;
+	}
+
+	const IconPath* path = GetToolbarIcon(commandId);
+	if (!path) {
+		return nullptr;
+	}
+
+	IconGeometry::ScaledIconPath& scaled = g_scaledIcons[key];
+	IconGeometry::BuildScaledPath(*path, IconGeometry::Transform::Scale(static_cast<float>(size) / 24.0f), scaled);
+	return &scaled;
+}
+
+// Returns the cached bitmap for a toolbar icon, rasterizing it on a miss.
+// Coverage comes from the atlas when it has this size, else from the path.
+const IconBitmap* GetToolbarIconBitmap(int commandId, UINT dpi, COLORREF color) {
+	int size = g_uiMetricsCache.Get(dpi).iconSize;
+	IconCacheKey key = { commandId, static_cast<uint16_t>(size), static_cast<uint16_t>(dpi), color };
+	if (IconBitmap* cached = g_iconCache.Find(key)) {
+		return cached->bitmap ? cached : nullptr;
+	}
+
+	const IconAtlas::Entry* atlasIcon = GetToolbarAtlasIcon(commandId, dpi);
+	if (atlasIcon && atlasIcon->size == size) {
+		return &g_iconCache.Insert(key, CreateIconBitmap(g_iconAtlas.Pixels(*atlasIcon), size, color));
+	}
+
+	const IconGeometry::ScaledIconPath* path = GetScaledToolbarIcon(commandId, size);
+	if (!path) {
+		return nullptr;
+	}
+
+	static IconRaster::CoverageRasterizer rasterizer;
+	std::vector<uint8_t> mask(static_cast<size_t>(size) * size);
+	rasterizer.Reset(size, size);
+	rasterizer.AddFixedPath(path->xs.data(), path->ys.data(), path->types.data(), path->Count(),
+		IconGeometry::FIXED_SHIFT);
+	rasterizer.Resolve(mask.data(), size);
+
+	IconBitmap& icon = g_iconCache.Insert(key, CreateIconBitmap(mask.data(), size, color));
+	return icon.bitmap ? &icon : nullptr;
+}
+
+void DrawIconBitmap(HDC hdc, HDC iconDC, const IconBitmap& icon, int x, int y) {
+	HBITMAP oldBitmap = (HBITMAP)SelectObject(iconDC, icon.bitmap.get());
+	BLENDFUNCTION blend = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+	AlphaBlend(hdc, x, y, icon.size, icon.size, iconDC, 0, 0, icon.size, icon.size, blend);
+	SelectObject(iconDC, oldBitmap);
+}
+
+// Back buffers for the double-buffered controls, one slot each.
+// The bitmap is only selected into the DC while painting, so either can be freed first.
+enum BackBufferSlot {
+	BACKBUFFER_TOOLBAR,
+	BACKBUFFER_URLBAR,
+	BACKBUFFER_TAB_STRIP,
+	BACKBUFFER_TEXT
+};
+
+struct BackBuffer {
+	wil::unique_hdc dc;
+	wil::unique_hbitmap bitmap;
+	uint32_t* bits = nullptr;  // DIB buffers only
+	int stride = 0;            // Pixels per row of bits
+};
+
+BackBufferPool<BackBuffer> g_backBuffers;
+
+// URL bar text as last read from the control; EN_CHANGE marks it stale
+std::wstring g_urlBarText;
+bool g_urlBarTextStale = true;
+
+BackBuffer& AcquireBackBuffer(BackBufferSlot slot, HDC hdc, int width, int height, UINT dpi) {
+	return g_backBuffers.Acquire(slot, width, height, dpi, [hdc](int bucketWidth, int bucketHeight) {
+		BackBuffer buffer;
+		buffer.dc.reset(CreateCompatibleDC(hdc));
+		buffer.bitmap.reset(CreateCompatibleBitmap(hdc, bucketWidth, bucketHeight));
+		return buffer;
+	});
+}
+
+// Premultiplied BGRA buffer that text runs are composited into before blending
+BackBuffer& AcquireTextSurface(HDC hdc, int width, int height) {
+	return g_backBuffers.Acquire(BACKBUFFER_TEXT, width, height, 0, [hdc](int bucketWidth, int bucketHeight) {
+		BackBuffer buffer;
+		void* bits = nullptr;
+		buffer.dc.reset(CreateCompatibleDC(hdc));
+		buffer.bitmap.reset(CreateTopDownDib(bucketWidth, bucketHeight, &bits));
+		buffer.bits = static_cast<uint32_t*>(bits);
+		buffer.stride = bucketWidth;
+		return buffer;
+	});
+}
+
+// Rasterizes glyphs of one font with GetGlyphOutline
+class GdiGlyphSource : public GlyphSource {
+public:
+	explicit GdiGlyphSource(HFONT font) : m_dc(CreateCompatibleDC(nullptr)) {
+		SelectObject(m_dc.get(), font);
+		TEXTMETRICW metrics = {};
+		GetTextMetricsW(m_dc.get(), &metrics);
+		m_ascent = metrics.tmAscent;
+		m_lineHeight = metrics.tmHeight;
+	}
+
+	int Ascent() const override { return m_ascent; }
+	int LineHeight() const override { return m_lineHeight; }
+
+	bool RenderGlyph(uint32_t codePoint, GlyphMetrics& metrics, std::vector<uint8_t>& coverage) override {
+		if (codePoint > 0xFFFF) {
+			return false;  // GetGlyphOutlineW takes UTF-16 code units
+		}
+
+		const MAT2 identity = { {0, 1}, {0, 0}, {0, 0}, {0, 1} };
+		GLYPHMETRICS gm = {};
+		DWORD size = GetGlyphOutlineW(m_dc.get(), codePoint, GGO_GRAY8_BITMAP, &gm, 0, nullptr, &identity);
+		if (size == GDI_ERROR) {
+			return false;
+		}
+
+		metrics.left = gm.gmptGlyphOrigin.x;
+		metrics.top = gm.gmptGlyphOrigin.y;
+		metrics.advance = gm.gmCellIncX;
+		if (size == 0) {
+			// Blank glyph such as a space; the black box is reported as 1x1
+			metrics.width = metrics.height = 0;
+			return true;
+		}
+		metrics.width = gm.gmBlackBoxX;
+		metrics.height = gm.gmBlackBoxY;
+
+		m_raw.resize(size);
+		if (GetGlyphOutlineW(m_dc.get(), codePoint, GGO_GRAY8_BITMAP, &gm, size, m_raw.data(), &identity) == GDI_ERROR) {
+			return false;
+		}
+
+		// Rows are DWORD aligned with 65 gray levels (0-64)
+		int pitch = (metrics.width + 3) & ~3;
+		coverage.resize(static_cast<size_t>(metrics.width) * metrics.height);
+		for (int y = 0; y < metrics.height; y++) {
+			for (int x = 0; x < metrics.width; x++) {
+				unsigned level = m_raw[static_cast<size_t>(y) * pitch + x];
+				coverage[static_cast<size_t>(y) * metrics.width + x] = static_cast<uint8_t>(level >= 64 ? 255 : level * 4);
+			}
+		}
+		return true;
+	}
+
+private:
+	wil::unique_hdc m_dc;
+	int m_ascent = 0;
+	int m_lineHeight = 0;
+	std::vector<uint8_t> m_raw;
+};
+
+// Glyph atlas and run cache for the chrome font, rebuilt if the font changes
+struct ChromeText {
+	explicit ChromeText(HFONT font) : font(font), source(font), atlas(source), runs(atlas, 128) {}
 
-	// Scale the icon to fit our desired size
-	float scale = static_cast<float>(ICON_SIZE) / 24.0f;
-	Gdiplus::Matrix matrix;
-	matrix.Scale(scale, scale);
-	matrix.Translate(static_cast<float>(x), static_cast<float>(y));
-	graphics.SetTransform(&matrix);
+	HFONT font;
+	GdiGlyphSource source;
+	GlyphAtlas atlas;
+	TextRunCache runs;
+	std::vector<uint8_t> coverage;  // Scratch line for compositing runs
+};
 
-	// Create the path
-	Gdiplus::GraphicsPath iconPath;
-	iconPath.AddLines(reinterpret_cast<const Gdiplus::PointF*>(path.points.data()), static_cast<INT>(path.points.size()));
+std::unique_ptr<ChromeText> g_chromeText;
 
-	// Draw the icon
-	Gdiplus::SolidBrush brush(Gdiplus::Color(GetRValue(color),
-		GetGValue(color),
-		GetBValue(color)));
-	graphics.FillPath(&brush, &iconPath);
+ChromeText* GetChromeText(HFONT font) {
+	if (!font) {
+		return nullptr;
+	}
+	if (!g_chromeText || g_chromeText->font != font) {
+		g_chromeText = std::make_unique<ChromeText>(font);
+	}
+	return g_chromeText.get();
 }
 
+// ChromeCanvas over a GDI device context. Icons come from the tinted bitmap cache.
+class GdiCanvas : public ChromeCanvas {
+public:
+	GdiCanvas(HDC hdc, UINT dpi, ChromeText* text = nullptr) : m_hdc(hdc), m_dpi(dpi), m_text(text) {}
+
+	void FillRect(const ChromeRect& rect, uint32_t color) override {
+		RECT r = { rect.left, rect.top, rect.right, rect.bottom };
+		SetDCBrushColor(m_hdc, color);
+		::FillRect(m_hdc, &r, (HBRUSH)GetStockObject(DC_BRUSH));
+	}
+
+	void FrameRoundRect(const ChromeRect& rect, int radius, uint32_t color) override {
+		SetDCPenColor(m_hdc, color);
+		HGDIOBJ oldPen = SelectObject(m_hdc, GetStockObject(DC_PEN));
+		HGDIOBJ oldBrush = SelectObject(m_hdc, GetStockObject(NULL_BRUSH));
+		RoundRect(m_hdc, rect.left, rect.top, rect.right, rect.bottom, radius * 2, radius * 2);
+		SelectObject(m_hdc, oldBrush);
+		SelectObject(m_hdc, oldPen);
+	}
+
+	// Simple runs are drawn from the glyph atlas; anything that needs shaping
+	// goes through DrawText with the font selected into the DC
+	void DrawTextLine(std::wstring_view text, const ChromeRect& rect, uint32_t color) override {
+		const TextRun* run = m_text ? &m_text->runs.Layout(text) : nullptr;
+		if (run && run->simple) {
+			DrawRun(*run, rect, color);
+			return;
+		}
+
+		RECT r = { rect.left, rect.top, rect.right, rect.bottom };
+		SetBkMode(m_hdc, TRANSPARENT);
+		SetTextColor(m_hdc, color);
+		DrawTextW(m_hdc, text.data(), static_cast<int>(text.size()), &r,
+			DT_VCENTER | DT_SINGLELINE | DT_END_ELLIPSIS | DT_NOPREFIX);
+	}
+
+	int IconSize() const override { return g_uiMetricsCache.Get(m_dpi).iconSize; }
+
+	void DrawIcon(int iconId, int x, int y, uint32_t color) override {
+		const IconBitmap* icon = GetToolbarIconBitmap(iconId, m_dpi, color);
+		if (!icon) {
+			return;
+		}
+		if (!m_iconDC) {
+			m_iconDC.reset(CreateCompatibleDC(m_hdc));
+		}
+		DrawIconBitmap(m_hdc, m_iconDC.get(), *icon, x, y);
+	}
+
+private:
+	// Composites the visible glyphs into one coverage line, tints it into a
+	// pooled DIB and blends that with a single AlphaBlend
+	void DrawRun(const TextRun& run, const ChromeRect& rect, uint32_t color) {
+		GlyphAtlas& atlas = m_text->runs.Atlas();
+		int width = rect.Width();
+		int height = atlas.Source().LineHeight();
+		if (width <= 0 || height <= 0) {
+			return;
+		}
+		int count = run.FitCount(width, m_text->runs.EllipsisWidth());
+
+		std::vector<uint8_t>& coverage = m_text->coverage;
+		coverage.assign(static_cast<size_t>(width) * height, 0);
+		auto addGlyph = [&](uint32_t codePoint, int pen) {
+			const AtlasGlyph* glyph = atlas.Get(codePoint);
+			if (!glyph) {
+				return;
+			}
+			const GlyphMetrics& m = glyph->metrics;
+			int x0 = pen + m.left;
+			int y0 = atlas.Source().Ascent() - m.top;
+			for (int y = 0; y < m.height; y++) {
+				if (y0 + y < 0 || y0 + y >= height) continue;
+				const uint8_t* src = atlas.Pixels() + static_cast<size_t>(glyph->y + y) * atlas.Width() + glyph->x;
+				uint8_t* dst = &coverage[static_cast<size_t>(y0 + y) * width];
+				for (int x = 0; x < m.width; x++) {
+					if (x0 + x < 0 || x0 + x >= width) continue;
+					unsigned sum = dst[x0 + x] + src[x];
+					dst[x0 + x] = static_cast<uint8_t>(sum > 255 ? 255 : sum);
+				}
+			}
+		};
+		for (int i = 0; i < count; i++) {
+			addGlyph(run.codePoints[i], run.offsets[i]);
+		}
+		if (count < run.Count()) {
+			addGlyph(TextRunCache::ELLIPSIS, run.offsets[count]);
+		}
+
+		BackBuffer& surface = AcquireTextSurface(m_hdc, width, height);
+		if (!surface.bits) {
+			return;
+		}
+		GdiFlush();
+		for (int y = 0; y < height; y++) {
+			IconRaster::TintCoverage(&coverage[static_cast<size_t>(y) * width], surface.bits + static_cast<size_t>(y) * surface.stride,
+				width, GetRValue(color), GetGValue(color), GetBValue(color));
+		}
+
+		int top = rect.top + (rect.Height() - height) / 2;
+		HGDIOBJ oldBitmap = SelectObject(surface.dc.get(), surface.bitmap.get());
+		BLENDFUNCTION blend = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+		AlphaBlend(m_hdc, rect.left, top, width, height, surface.dc.get(), 0, 0, width, height, blend);
+		SelectObject(surface.dc.get(), oldBitmap);
+	}
+
+	HDC m_hdc;
+	UINT m_dpi;
+	ChromeText* m_text;
+	wil::unique_hdc m_iconDC;
+};
+
 
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-void InitializeWebView(int tabIndex);
+void InitializeWebView(TabHandle handle);
 void ResizeBrowser();
-void NavigateToUrl(int tabIndex);
+uint64_t GetDisplayFrameInterval();
+void RunFrameWork(HWND hwnd, uint32_t work);
+void PumpFrame(HWND hwnd);
+void NavigateToUrl(TabHandle handle);
 void CreateTab();
 void InitializeControls(HWND hwnd, HINSTANCE hInstance);
+void ApplyUiMetrics(UINT dpi);
 void CreateMenuBar(HWND hwnd);
 void HandleMenuCommand(WPARAM wParam);
 void SaveBookmark();
 void ShowBookmarks();
-void SwitchToTab(int index);
-void CloseTab(int index);
+void ShowTabSearch();
+void IndexTab(const TabInfo& tab);
+void ShowFrameTimings();
+void SwitchToTab(TabHandle handle);
+void CloseTab(TabHandle handle);
+void ReleaseTab(TabInfo& tab);
+void WakeTab(TabHandle handle);
+void SetTabLabel(TabHandle handle, const std::wstring& title);
+void PrefetchNextTab();
+bool RestoreSession();
+void JournalTab(SessionJournal::RecordType type, const TabInfo& tab, int32_t value = 0, std::wstring text = std::wstring());
+void SaveScrollPosition(TabHandle handle);
+void EvaluateHibernation();
 void InitializeToolbar(HWND hwnd, HINSTANCE hInstance);
+void SyncToolbarModel();
+void InvalidateToolbarDamage(HWND hwnd);
 void DrawModernUrlBar(HWND hwnd);
-void DrawModerTab(HWND hwnd, HDC hdc, const RECT& rect, bool isSelected);
+LRESULT CALLBACK TabStripProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+LRESULT CALLBACK TabSearchProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+void InvalidateTabsFrom(int position);
 void HandleUrlBarInput();
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
 	HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
 	if (FAILED(hr)) return 1;
 
+	// Draw the chrome at each monitor's own DPI instead of being bitmap-stretched
+	SetProcessDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
+
 	INITCOMMONCONTROLSEX icex;
 	icex.dwSize = sizeof(INITCOMMONCONTROLSEX);
-	icex.dwICC = ICC_TAB_CLASSES | ICC_BAR_CLASSES;
+	icex.dwICC = ICC_BAR_CLASSES;
 	InitCommonControlsEx(&icex);
 
 	const wchar_t CLASS_NAME[] = L"BrowserWindow";
@@ -231,7 +854,8 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		L"DINGUS BROWSER",
 		WS_OVERLAPPEDWINDOW,
 		CW_USEDEFAULT, CW_USEDEFAULT,
-		WINDOW_WIDTH, WINDOW_HEIGHT,
+		MulDiv(WINDOW_WIDTH, GetDpiForSystem(), USER_DEFAULT_SCREEN_DPI),
+		MulDiv(WINDOW_HEIGHT, GetDpiForSystem(), USER_DEFAULT_SCREEN_DPI),
 		nullptr,
 		nullptr,
 		hInstance,
@@ -244,7 +868,12 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	InitializeControls(g_hwnd, hInstance);
 	InitializeToolbar(g_hwnd, hInstance);
 
-	CreateTab();
+	// Start the shared environment and the warm controller before the first tab asks
+	g_controllerPool.Refill();
+	if (!RestoreSession()) {
+		CreateTab();
+	}
+	SetTimer(g_hwnd, HIBERNATION_TIMER_ID, HIBERNATION_INTERVAL, nullptr);
 
 	ShowWindow(g_hwnd, nCmdShow);
 	UpdateWindow(g_hwnd);
@@ -259,81 +888,236 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 }
 
 void DrawModernUrlBar(HWND hwnd) {
+	FrameTimer timer(FRAME_URLBAR_PAINT);
 	RECT rect;
 	GetClientRect(hwnd, &rect);
-	HDC hdc = GetDC(hwnd);
+	PAINTSTRUCT ps;
+	HDC hdc = BeginPaint(hwnd, &ps);
+
+	// Paint into the pooled back buffer
+	UINT dpi = GetDpiForWindow(hwnd);
+	BackBuffer& buffer = AcquireBackBuffer(BACKBUFFER_URLBAR, hdc, rect.right, rect.bottom, dpi);
+	HDC memDC = buffer.dc.get();
+	HBITMAP oldBitmap = (HBITMAP)SelectObject(memDC, buffer.bitmap.get());
+
+	if (g_urlBarTextStale) {
+		g_urlBarText.resize(GetWindowTextLengthW(hwnd));
+		GetWindowTextW(hwnd, g_urlBarText.data(), static_cast<int>(g_urlBarText.size()) + 1);
+		g_urlBarTextStale = false;
+	}
+
+	// Draw the frame and URL text in the control's font
+	HFONT font = (HFONT)SendMessage(hwnd, WM_GETFONT, 0, 0);
+	HGDIOBJ oldFont = SelectObject(memDC, font ? font : GetStockObject(SYSTEM_FONT));
+	GdiCanvas canvas(memDC, dpi, GetChromeText(font));
+	ChromePaint::UrlBar(canvas, { rect.left, rect.top, rect.right, rect.bottom }, g_urlBarText, g_chromeTheme, g_uiMetricsCache.Get(dpi));
+
+	// Copy from memory DC to window DC
+	BitBlt(hdc, 0, 0, rect.right, rect.bottom, memDC, 0, 0, SRCCOPY);
+
+	SelectObject(memDC, oldFont);
+	SelectObject(memDC, oldBitmap);
+	EndPaint(hwnd, &ps);
+}
 
-	// Create memory DC for double buffering
-	HDC memDC = CreateCompatibleDC(hdc);
-	HBITMAP memBitmap = CreateCompatibleBitmap(hdc, rect.right, rect.bottom);
-	HBITMAP oldBitmap = (HBITMAP)SelectObject(memDC, memBitmap);
+// Width a tab gets until its label is measured
+int EstimatedTabWidth() {
+	return g_metrics->maxTabTitleWidth + 2 * g_metrics->tabTextPadding;
+}
 
-	// Fill background
-	HBRUSH bgBrush = CreateSolidBrush(RGB(255, 255, 255));
-	FillRect(memDC, &rect, bgBrush);
-	DeleteObject(bgBrush);
+// Sizes a tab to its label. Returns true if its width changed.
+bool MeasureTab(int position) {
+	TabInfo* tab = g_tabs.Get(TabAt(position));
+	if (tab->labelMeasured) {
+		return false;
+	}
+	tab->labelMeasured = true;
 
-	// Draw rounded rectangle border
-	int radius = 4;
-	HPEN borderPen = CreatePen(PS_SOLID, 1, Colors::BorderColor);
-	HGDIOBJ oldPen = SelectObject(memDC, borderPen);
+	int textWidth = g_metrics->maxTabTitleWidth;
+	if (ChromeText* text = GetChromeText(g_uiFont.get())) {
+		textWidth = min(text->runs.Layout(tab->label).Width(), textWidth);
+	}
+	int width = textWidth + 2 * g_metrics->tabTextPadding;
+	if (width == g_tabStripModel.Width(position)) {
+		return false;
+	}
+	g_tabStripModel.SetWidth(position, width);
+	return true;
+}
 
-	// Draw the rounded rectangle
-	RoundRect(memDC, rect.left, rect.top, rect.right, rect.bottom, radius * 2, radius * 2);
+// Measures the tabs in view, which may pull more tabs into view. Returns
+// true if any width changed.
+bool MeasureVisibleTabs(int viewWidth) {
+	int scroll = g_tabStripModel.Scroll();
+	int position = g_tabStripModel.HitTest(scroll);
+	if (position < 0) {
+		return false;
+	}
 
-	// Draw the URL text
-	SetBkMode(memDC, TRANSPARENT);
-	RECT textRect = rect;
-	textRect.left += 8; // Text padding
-	textRect.right -= 8;
+	bool changed = false;
+	int x = g_tabStripModel.Offset(position);
+	for (; position < g_tabStripModel.Count() && x < scroll + viewWidth; position++) {
+		changed |= MeasureTab(position);
+		x += g_tabStripModel.Width(position);
+	}
+	return changed;
+}
 
-	wchar_t text[2048];
-	GetWindowTextW(hwnd, text, 2048);
-	DrawTextW(memDC, text, -1, &textRect, DT_VCENTER | DT_SINGLELINE);
+// Paints only the tabs that overlap the damaged area
+void PaintTabStrip(HWND hwnd) {
+	FrameTimer timer(FRAME_TAB_STRIP_PAINT);
+	RECT client;
+	GetClientRect(hwnd, &client);
+
+	// Measure before BeginPaint, so a width change can still widen the damage
+	bool moved = MeasureVisibleTabs(client.right);
+	moved |= g_tabStripModel.SetScroll(g_tabStripModel.Scroll(), client.right);
+	if (moved) {
+		InvalidateRect(hwnd, nullptr, FALSE);
+	}
 
-	// Copy from memory DC to window DC
-	BitBlt(hdc, 0, 0, rect.right, rect.bottom, memDC, 0, 0, SRCCOPY);
+	PAINTSTRUCT ps;
+	HDC hdc = BeginPaint(hwnd, &ps);
+
+	// Paint into the pooled back buffer
+	UINT dpi = GetDpiForWindow(hwnd);
+	BackBuffer& buffer = AcquireBackBuffer(BACKBUFFER_TAB_STRIP, hdc, client.right, client.bottom, dpi);
+	HDC memDC = buffer.dc.get();
+	HBITMAP oldBitmap = (HBITMAP)SelectObject(memDC, buffer.bitmap.get());
+	HGDIOBJ oldFont = SelectObject(memDC, g_uiFont.get());
+
+	{
+		GdiCanvas canvas(memDC, dpi, GetChromeText(g_uiFont.get()));
+		canvas.FillRect({ ps.rcPaint.left, ps.rcPaint.top, ps.rcPaint.right, ps.rcPaint.bottom }, Colors::BackgroundColor);
+
+		const UiMetrics& metrics = g_uiMetricsCache.Get(dpi);
+		int current = TabPosition(g_currentTab);
+		int scroll = g_tabStripModel.Scroll();
+		int position = g_tabStripModel.HitTest(scroll + ps.rcPaint.left);
+		if (position >= 0) {
+			int x = g_tabStripModel.Offset(position) - scroll;
+			for (; position < g_tabStripModel.Count() && x < ps.rcPaint.right; position++) {
+				int width = g_tabStripModel.Width(position);
+				const TabInfo* tab = g_tabs.Get(TabAt(position));
+				ChromePaint::Tab(canvas, { x, 0, x + width, client.bottom }, tab->label, position == current, g_chromeTheme, metrics);
+				x += width;
+			}
+		}
+	}
+
+	// Copy the damaged area from memory DC to window DC
+	BitBlt(hdc, ps.rcPaint.left, ps.rcPaint.top,
+		ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+		memDC, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
-	// Clean up
-	SelectObject(memDC, oldPen);
+	SelectObject(memDC, oldFont);
 	SelectObject(memDC, oldBitmap);
-	DeleteObject(borderPen);
-	DeleteObject(memBitmap);
-	DeleteDC(memDC);
-	ReleaseDC(hwnd, hdc);
+	EndPaint(hwnd, &ps);
 }
 
-void DrawModerTab(HWND hwnd, HDC hdc, const RECT& rect, bool isSelected) {
-	HBRUSH hBrush = CreateSolidBrush(isSelected ? Colors::ActiveTabColor : Colors::InactiveTabColor);
+// Repaints from the tab's left edge to the end of the view, since a change
+// to one tab's width moves every tab after it
+void InvalidateTabsFrom(int position) {
+	RECT rect;
+	GetClientRect(g_tabStrip, &rect);
+	if (g_tabStripModel.SetScroll(g_tabStripModel.Scroll(), rect.right)) {
+		InvalidateRect(g_tabStrip, nullptr, FALSE);
+		return;
+	}
+	rect.left = max(0, g_tabStripModel.Offset(position) - g_tabStripModel.Scroll());
+	if (rect.left < rect.right) {
+		InvalidateRect(g_tabStrip, &rect, FALSE);
+	}
+}
+
+void InvalidateTab(int position) {
+	if (position < 0) {
+		return;
+	}
+	int left = g_tabStripModel.Offset(position) - g_tabStripModel.Scroll();
+	RECT rect;
+	GetClientRect(g_tabStrip, &rect);
+	rect.right = min(rect.right, left + g_tabStripModel.Width(position));
+	rect.left = max(0, left);
+	if (rect.left < rect.right) {
+		InvalidateRect(g_tabStrip, &rect, FALSE);
+	}
+}
+
+void ScrollTabStrip(int delta) {
+	RECT client;
+	GetClientRect(g_tabStrip, &client);
+	if (g_tabStripModel.SetScroll(g_tabStripModel.Scroll() + delta, client.right)) {
+		InvalidateRect(g_tabStrip, nullptr, FALSE);
+	}
+}
+
+LRESULT CALLBACK TabStripProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+	switch (uMsg) {
+	case WM_PAINT:
+		PaintTabStrip(hwnd);
+		return 0;
+
+	case WM_ERASEBKGND:
+		return 1;
 
-	FillRect(hdc, &rect, hBrush);
-	DeleteObject(hBrush);
+	case WM_SIZE:
+		// Keep the view on the strip; paint measures whatever came into view
+		g_tabStripModel.SetScroll(g_tabStripModel.Scroll(), LOWORD(lParam));
+		InvalidateRect(hwnd, nullptr, FALSE);
+		return 0;
 
-	if (!isSelected) {
-		HPEN hPen = CreatePen(PS_SOLID, 1, Colors::BorderColor);
-		SelectObject(hdc, hPen);
-		MoveToEx(hdc, rect.right - 1, rect.top + 4, nullptr);
-		LineTo(hdc, rect.right - 1, rect.bottom - 4);
-		DeleteObject(hPen);
+	case WM_LBUTTONDOWN: {
+		int position = g_tabStripModel.HitTest(g_tabStripModel.Scroll() + GET_X_LPARAM(lParam));
+		if (position >= 0) {
+			SwitchToTab(TabAt(position));
+		}
+		return 0;
 	}
 
-	if (isSelected) {
-		RECT borderRect = rect;
-		borderRect.top = borderRect.bottom - 2;
-		hBrush = CreateSolidBrush(Colors::AccentColor);
-		FillRect(hdc, &borderRect, hBrush);
-		DeleteObject(hBrush);
+	case WM_MOUSEWHEEL:
+	case WM_MOUSEHWHEEL: {
+		// Either wheel scrolls the strip sideways, about a tab per notch
+		int delta = GET_WHEEL_DELTA_WPARAM(wParam);
+		ScrollTabStrip(MulDiv(uMsg == WM_MOUSEWHEEL ? -delta : delta, EstimatedTabWidth(), WHEEL_DELTA));
+		return 0;
+	}
 	}
+	return DefWindowProc(hwnd, uMsg, wParam, lParam);
 }
 
-void InitializeToolbar(HWND hwnd, HINSTANCE hInstance) {
-	// Initialize GDI+
-	Gdiplus::GdiplusStartupInput gdiplusStartupInput;
-	ULONG_PTR gdiplusToken;
-	Gdiplus::GdiplusStartup(&gdiplusToken, &gdiplusStartupInput, NULL);
+// Re-reads button commands and rects after the toolbar has laid itself out,
+// so painting and hit testing need no per-button messages. Runs when the
+// buttons change or move: after they are added, when the toolbar is resized
+// and on a DPI change, not on every layout pass.
+void SyncToolbarModel() {
+	int hovered = g_toolbarModel.Hovered();
+	g_toolbarModel.Reset();
+
+	int buttonCount = (int)SendMessage(g_toolbar, TB_BUTTONCOUNT, 0, 0);
+	for (int i = 0; i < buttonCount; i++) {
+		TBBUTTON button;
+		RECT rect;
+		SendMessage(g_toolbar, TB_GETBUTTON, i, (LPARAM)&button);
+		SendMessage(g_toolbar, TB_GETITEMRECT, i, (LPARAM)&rect);
+		g_toolbarModel.AddButton(button.idCommand, { rect.left, rect.top, rect.right, rect.bottom });
+	}
+	g_toolbarModel.SetHovered(hovered);
+	InvalidateToolbarDamage(g_toolbar);
+}
+
+// Invalidates only the buttons whose state changed
+void InvalidateToolbarDamage(HWND hwnd) {
+	g_toolbarModel.FlushDamage([hwnd](const ToolbarRect& damage) {
+		RECT rect = { damage.left, damage.top, damage.right, damage.bottom };
+		InvalidateRect(hwnd, &rect, FALSE);
+	});
+}
 
-	// Initialize icon paths
-	InitializeIconPaths();
+void InitializeToolbar(HWND hwnd, HINSTANCE hInstance) {
+	// Map the pre-rasterized icon atlas and the symbol sheet behind it
+	LoadIconAtlas();
+	LoadIconSheet();
 
 	// Create toolbar with modern style
 	g_toolbar = CreateWindowEx(
@@ -362,63 +1146,47 @@ void InitializeToolbar(HWND hwnd, HINSTANCE hInstance) {
 
 	SendMessage(g_toolbar, TB_BUTTONSTRUCTSIZE, sizeof(TBBUTTON), 0);
 	SendMessage(g_toolbar, TB_ADDBUTTONS, _countof(buttons), (LPARAM)buttons);
+	SyncToolbarModel();
 
 	// Subclass the toolbar for custom drawing
 	SetWindowSubclass(g_toolbar, [](HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
 		UINT_PTR uIdSubclass, DWORD_PTR dwRefData) -> LRESULT {
 			switch (uMsg) {
 			case WM_PAINT: {
+				FrameTimer timer(FRAME_TOOLBAR_PAINT);
 				PAINTSTRUCT ps;
 				HDC hdc = BeginPaint(hwnd, &ps);
 
-				// Create memory DC for double buffering
-				HDC memDC = CreateCompatibleDC(hdc);
-				HBITMAP memBitmap = CreateCompatibleBitmap(hdc, ps.rcPaint.right, ps.rcPaint.bottom);
-				HBITMAP oldBitmap = (HBITMAP)SelectObject(memDC, memBitmap);
-
-				// Fill background
-				RECT rect;
-				GetClientRect(hwnd, &rect);
-				FillRect(memDC, &rect, (HBRUSH)GetStockObject(WHITE_BRUSH));
-
-				// Draw each button
-				TBBUTTON button;
-				int buttonCount = SendMessage(hwnd, TB_BUTTONCOUNT, 0, 0);
-				for (int i = 0; i < buttonCount; i++) {
-					SendMessage(hwnd, TB_GETBUTTON, i, (LPARAM)&button);
-					RECT buttonRect;
-					SendMessage(hwnd, TB_GETITEMRECT, i, (LPARAM)&buttonRect);
-
-					// Calculate icon position
-					int iconX = buttonRect.left + (buttonRect.right - buttonRect.left - ICON_SIZE) / 2;
-					int iconY = buttonRect.top + (buttonRect.bottom - buttonRect.top - ICON_SIZE) / 2;
-
-					// Draw icon
-					auto it = g_iconPaths.find(button.idCommand);
-					if (it != g_iconPaths.end()) {
-						COLORREF iconColor = (i == g_hoveredButton) ? ICON_HOVER_COLOR : ICON_COLOR;
-						DrawIcon(memDC, it->second, iconX, iconY, iconColor);
-					}
+				// Paint into the pooled back buffer
+				RECT client;
+				GetClientRect(hwnd, &client);
+				UINT dpi = GetDpiForWindow(hwnd);
+				BackBuffer& buffer = AcquireBackBuffer(BACKBUFFER_TOOLBAR, hdc, client.right, client.bottom, dpi);
+				HDC memDC = buffer.dc.get();
+				HBITMAP oldBitmap = (HBITMAP)SelectObject(memDC, buffer.bitmap.get());
+
+				// Fill the damaged area and draw the buttons that overlap it
+				{
+					GdiCanvas canvas(memDC, dpi);
+					ChromeRect clip = { ps.rcPaint.left, ps.rcPaint.top, ps.rcPaint.right, ps.rcPaint.bottom };
+					ChromePaint::Toolbar(canvas, g_toolbarModel, clip, g_chromeTheme);
 				}
 
-				// Copy from memory DC to window DC
-				BitBlt(hdc, 0, 0, ps.rcPaint.right, ps.rcPaint.bottom, memDC, 0, 0, SRCCOPY);
+				// Copy the damaged area from memory DC to window DC
+				BitBlt(hdc, ps.rcPaint.left, ps.rcPaint.top,
+					ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+					memDC, ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
 
-				// Clean up
 				SelectObject(memDC, oldBitmap);
-				DeleteObject(memBitmap);
-				DeleteDC(memDC);
 
 				EndPaint(hwnd, &ps);
 				return 0;
 			}
 
 			case WM_MOUSEMOVE: {
-				POINT pt = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
-				int hot = SendMessage(hwnd, TB_HITTEST, 0, (LPARAM)&pt);
-				if (hot != g_hoveredButton) {
-					g_hoveredButton = hot;
-					InvalidateRect(hwnd, NULL, FALSE);
+				int hot = g_toolbarModel.HitTest(GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam));
+				if (g_toolbarModel.SetHovered(hot)) {
+					InvalidateToolbarDamage(hwnd);
 
 					// Start hover timer if not already started
 					if (!g_toolbarHoverTimer) {
@@ -428,10 +1196,17 @@ void InitializeToolbar(HWND hwnd, HINSTANCE hInstance) {
 				break;
 			}
 
+			case WM_SIZE: {
+				// Clipped buttons hide as the bar narrows, so read the rects back
+				// once the control has handled the new size
+				LRESULT result = DefSubclassProc(hwnd, uMsg, wParam, lParam);
+				SyncToolbarModel();
+				return result;
+			}
+
 			case WM_MOUSELEAVE: {
-				if (g_hoveredButton != -1) {
-					g_hoveredButton = -1;
-					InvalidateRect(hwnd, NULL, FALSE);
+				if (g_toolbarModel.SetHovered(-1)) {
+					InvalidateToolbarDamage(hwnd);
 				}
 				if (g_toolbarHoverTimer) {
 					KillTimer(hwnd, g_toolbarHoverTimer);
@@ -444,39 +1219,97 @@ void InitializeToolbar(HWND hwnd, HINSTANCE hInstance) {
 		}, 0, 0);
 }
 
-void CreateTab() {
-	TabInfo newTab;
-	g_tabs.push_back(newTab);
-
-	int tabIndex = g_tabs.size() - 1;
+// Adds a tab to the end of the strip without creating its WebView. Tabs
+// that aren't in the journal yet are added to it.
+TabHandle InsertTab(TabInfo tab, const wchar_t* label) {
+	bool opened = tab.journalId == 0;
+	if (opened) {
+		tab.journalId = g_nextJournalId++;
+	}
+	TabHandle handle = g_tabs.Insert(std::move(tab));
 
-	TCITEM tie;
-	tie.mask = TCIF_TEXT;
-	tie.pszText = (LPSTR)L"New Tab";
-	TabCtrl_InsertItem(g_tabControl, tabIndex, &tie);
+	int position = g_tabStripModel.Count();
+	int id = g_tabStripModel.Insert(position, EstimatedTabWidth());
+	if (id >= static_cast<int>(g_stripTabs.size())) {
+		g_stripTabs.resize(id + 1);
+	}
+	g_stripTabs[id] = handle;
+	g_tabs.Get(handle)->stripId = id;
+	g_tabs.Get(handle)->label = label;
+	InvalidateTabsFrom(position);
 
-	InitializeWebView(tabIndex);
-	SwitchToTab(tabIndex);
+	if (opened) {
+		JournalTab(SessionJournal::RecordType::Opened, *g_tabs.Get(handle), position);
+	}
+	IndexTab(*g_tabs.Get(handle));
+	return handle;
 }
 
-void SwitchToTab(int index) {
-	if (index < 0 || index >= g_tabs.size()) {
+// Shows a page title on the tab. It is measured and cut to fit when next in view.
+void SetTabLabel(TabHandle handle, const std::wstring& title) {
+	TabInfo* tab = g_tabs.Get(handle);
+	if (!tab) {
 		return;
 	}
+	tab->label = title;
+	tab->labelMeasured = false;
+
+	if (IsWindow(g_tabStrip)) {
+		InvalidateTabsFrom(TabPosition(handle));
+	}
+}
+
+void CreateTab() {
+	TabHandle handle = InsertTab(TabInfo(), L"New Tab");
 
-	g_currentTab = index;
-	TabCtrl_SetCurSel(g_tabControl, index);
+	InitializeWebView(handle);
+	SwitchToTab(handle);
+	EvaluateHibernation();
+}
+
+void SwitchToTab(TabHandle handle) {
+	TabInfo* tab = g_tabs.Get(handle);
+	if (!tab) {
+		return;
+	}
 
-	// Hide all WebViews
-	for (int i = 0; i < g_tabs.size(); i++) {
-		if (g_tabs[i].controller) {
-			g_tabs[i].controller->put_IsVisible(i == index);
+	// Only the outgoing and incoming WebViews change visibility
+	uint64_t now = GetTickCount64();
+	TabInfo* previous = CurrentTab();
+	if (previous && previous != tab) {
+		previous->lastActive = now;
+		SaveScrollPosition(g_currentTab);
+		if (previous->controller) {
+			previous->controller->put_IsVisible(FALSE);
 		}
 	}
+	if (g_currentTab != handle) {
+		JournalTab(SessionJournal::RecordType::Activated, *tab);
+	}
+	int previousPosition = TabPosition(g_currentTab);
+	g_currentTab = handle;
+	WakeTab(handle);
+	tab->lastActive = now;
+	if (tab->controller) {
+		tab->controller->put_IsVisible(TRUE);
+	}
+
+	// Scroll the strip to the new tab, which needs its real width first
+	RECT strip;
+	GetClientRect(g_tabStrip, &strip);
+	int position = TabPosition(handle);
+	MeasureTab(position);
+	if (g_tabStripModel.ScrollIntoView(position, strip.right)) {
+		InvalidateRect(g_tabStrip, nullptr, FALSE);
+	}
+	else {
+		InvalidateTab(previousPosition);
+		InvalidateTabsFrom(position);
+	}
 
 	// Update URL bar with current tab's URL
-	if (g_urlBar && g_tabs[index].webView) {
-		SetWindowText(g_urlBar, (LPCSTR)g_tabs[index].url.c_str());
+	if (g_urlBar && tab->webView) {
+		SetWindowText(g_urlBar, (LPCSTR)tab->url.c_str());
 	}
 
 	// Resize the browser to update the layout
@@ -484,9 +1317,8 @@ void SwitchToTab(int index) {
 }
 
 void SaveBookmark() {
-	if (g_currentTab >= 0 && g_currentTab < g_tabs.size()) {
-		TabInfo& currentTab = g_tabs[g_currentTab];
-		g_bookmarks[currentTab.title] = currentTab.url;
+	if (TabInfo* currentTab = CurrentTab()) {
+		g_bookmarks[currentTab->title] = currentTab->url;
 		MessageBoxW(g_hwnd, L"Bookmark added!", L"Success", MB_OK);
 	}
 }
@@ -499,6 +1331,188 @@ void ShowBookmarks() {
 	MessageBoxW(g_hwnd, bookmarksList.c_str(), L"Bookmarks", MB_OK);
 }
 
+// Puts the tab's current title and URL in the search index
+void IndexTab(const TabInfo& tab) {
+	if (g_tabSearchBuilt) {
+		g_tabSearch.Update(tab.journalId, tab.title, tab.url);
+	}
+}
+
+// Indexes every tab if a restore left the index unbuilt
+void BuildTabSearch() {
+	if (g_tabSearchBuilt) {
+		return;
+	}
+	for (const TabInfo& tab : g_tabs) {
+		g_tabSearch.Update(tab.journalId, tab.title, tab.url);
+	}
+	g_tabSearchBuilt = true;
+}
+
+// Refills the result list for the text in the search box, best match first
+void RefreshTabSearch() {
+	std::wstring query(GetWindowTextLengthW(g_tabSearchEdit), L'\0');
+	GetWindowTextW(g_tabSearchEdit, query.data(), static_cast<int>(query.size()) + 1);
+
+	// Find the tabs behind the results in one pass over the tabs
+	std::vector<TabSearchResult> results = g_tabSearch.Search(query, TAB_SEARCH_RESULTS);
+	std::unordered_map<uint32_t, size_t> ranks;
+	for (size_t i = 0; i < results.size(); i++) {
+		ranks[results[i].tab] = i;
+	}
+	std::vector<const TabInfo*> rows(results.size());
+	for (const TabInfo& tab : g_tabs) {
+		if (auto rank = ranks.find(tab.journalId); rank != ranks.end()) {
+			rows[rank->second] = &tab;
+		}
+	}
+
+	SendMessage(g_tabSearchList, WM_SETREDRAW, FALSE, 0);
+	SendMessage(g_tabSearchList, LB_RESETCONTENT, 0, 0);
+	for (const TabInfo* tab : rows) {
+		if (tab) {
+			std::wstring line = tab->title.empty() ? tab->url : tab->title + L"  \u2014  " + tab->url;
+			LRESULT item = SendMessageW(g_tabSearchList, LB_ADDSTRING, 0, (LPARAM)line.c_str());
+			SendMessage(g_tabSearchList, LB_SETITEMDATA, item, tab->journalId);
+		}
+	}
+	SendMessage(g_tabSearchList, LB_SETCURSEL, 0, 0);
+	SendMessage(g_tabSearchList, WM_SETREDRAW, TRUE, 0);
+	InvalidateRect(g_tabSearchList, nullptr, TRUE);
+}
+
+// Switches to the selected result and closes the search
+void ActivateTabSearchResult() {
+	LRESULT item = SendMessage(g_tabSearchList, LB_GETCURSEL, 0, 0);
+	if (item == LB_ERR) {
+		return;
+	}
+	uint32_t journalId = static_cast<uint32_t>(SendMessage(g_tabSearchList, LB_GETITEMDATA, item, 0));
+	DestroyWindow(g_tabSearchWindow);
+
+	for (size_t i = 0; i < g_tabs.Size(); i++) {
+		if (g_tabs.ValueAt(i).journalId == journalId) {
+			SwitchToTab(g_tabs.HandleAt(i));
+			return;
+		}
+	}
+}
+
+// Arrow keys move through the results while typing continues in the box
+LRESULT CALLBACK TabSearchEditProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData) {
+	if (uMsg == WM_KEYDOWN) {
+		switch (wParam) {
+		case VK_UP:
+		case VK_DOWN: {
+			LRESULT count = SendMessage(g_tabSearchList, LB_GETCOUNT, 0, 0);
+			LRESULT item = SendMessage(g_tabSearchList, LB_GETCURSEL, 0, 0) + (wParam == VK_DOWN ? 1 : -1);
+			if (item >= 0 && item < count) {
+				SendMessage(g_tabSearchList, LB_SETCURSEL, item, 0);
+			}
+			return 0;
+		}
+
+		case VK_RETURN:
+			ActivateTabSearchResult();
+			return 0;
+
+		case VK_ESCAPE:
+			DestroyWindow(g_tabSearchWindow);
+			return 0;
+		}
+	}
+	else if (uMsg == WM_CHAR && (wParam == VK_RETURN || wParam == VK_ESCAPE)) {
+		return 0;  // No beep
+	}
+	return DefSubclassProc(hwnd, uMsg, wParam, lParam);
+}
+
+LRESULT CALLBACK TabSearchProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+	switch (uMsg) {
+	case WM_COMMAND:
+		if (LOWORD(wParam) == ID_TAB_SEARCH_EDIT && HIWORD(wParam) == EN_CHANGE) {
+			RefreshTabSearch();
+		}
+		else if (LOWORD(wParam) == ID_TAB_SEARCH_LIST && HIWORD(wParam) == LBN_DBLCLK) {
+			ActivateTabSearchResult();
+		}
+		return 0;
+
+	case WM_ACTIVATE:
+		if (LOWORD(wParam) != WA_INACTIVE) {
+			SetFocus(g_tabSearchEdit);
+		}
+		return 0;
+
+	case WM_DESTROY:
+		g_tabSearchWindow = g_tabSearchEdit = g_tabSearchList = nullptr;
+		return 0;
+	}
+	return DefWindowProc(hwnd, uMsg, wParam, lParam);
+}
+
+void ShowTabSearch() {
+	BuildTabSearch();
+	if (g_tabSearchWindow) {
+		SetActiveWindow(g_tabSearchWindow);
+		return;
+	}
+
+	HINSTANCE hInstance = GetModuleHandleW(nullptr);
+	// A box over the top of the browser, sized for the window's DPI
+	const UiMetrics& metrics = *g_metrics;
+	int width = MulDiv(480, metrics.dpi, USER_DEFAULT_SCREEN_DPI);
+	int listHeight = MulDiv(320, metrics.dpi, USER_DEFAULT_SCREEN_DPI);
+	RECT client = { 0, 0, width, metrics.urlBarHeight + listHeight + metrics.padding * 3 };
+	DWORD style = WS_POPUP | WS_CAPTION | WS_SYSMENU;
+	AdjustWindowRectExForDpi(&client, style, FALSE, 0, metrics.dpi);
+	RECT owner;
+	GetWindowRect(g_hwnd, &owner);
+	int x = (owner.left + owner.right - (client.right - client.left)) / 2;
+	int y = owner.top + metrics.toolbarHeight * 2;
+
+	g_tabSearchWindow = CreateWindowExW(0, TAB_SEARCH_CLASS, L"Search Tabs", style,
+		x, y, client.right - client.left, client.bottom - client.top, g_hwnd, nullptr, hInstance, nullptr);
+	g_tabSearchEdit = CreateWindowExW(0, L"EDIT", L"", WS_CHILD | WS_VISIBLE | WS_BORDER | ES_AUTOHSCROLL,
+		metrics.padding, metrics.padding, width - metrics.padding * 2, metrics.urlBarHeight,
+		g_tabSearchWindow, (HMENU)ID_TAB_SEARCH_EDIT, hInstance, nullptr);
+	g_tabSearchList = CreateWindowExW(0, L"LISTBOX", nullptr, WS_CHILD | WS_VISIBLE | WS_BORDER | WS_VSCROLL | LBS_NOTIFY | LBS_NOINTEGRALHEIGHT,
+		metrics.padding, metrics.urlBarHeight + metrics.padding * 2, width - metrics.padding * 2, listHeight,
+		g_tabSearchWindow, (HMENU)ID_TAB_SEARCH_LIST, hInstance, nullptr);
+
+	SendMessage(g_tabSearchEdit, WM_SETFONT, (WPARAM)g_uiFont.get(), FALSE);
+	SendMessage(g_tabSearchList, WM_SETFONT, (WPARAM)g_uiFont.get(), FALSE);
+	SetWindowSubclass(g_tabSearchEdit, TabSearchEditProc, 0, 0);
+
+	ShowWindow(g_tabSearchWindow, SW_SHOW);
+	SetFocus(g_tabSearchEdit);
+}
+
+void ShowFrameTimings() {
+	std::wstring report = L"Event: count, p50 / p99 / max (\u00b5s)\n";
+	for (int i = 0; i < FRAME_EVENT_COUNT; i++) {
+		LatencyHistogram::Summary summary = g_frameTimes[i].Summarize();
+		wchar_t line[160];
+		swprintf_s(line, L"%s: %llu, %.1f / %.1f / %.1f\n", FRAME_EVENT_NAMES[i], summary.count,
+			summary.p50 / 1000.0, summary.p99 / 1000.0, summary.max / 1000.0);
+		report += line;
+	}
+
+	const BackBufferStats& buffers = g_backBuffers.Stats();
+	wchar_t line[160];
+	swprintf_s(line, L"\nBack buffers: %llu allocations, %llu reuses\n",
+		buffers.allocations, buffers.reuses);
+	report += line;
+
+	const ViewPoolStats& controllers = g_controllerPool.Stats();
+	swprintf_s(line, L"Controllers: %llu tabs opened, %llu from the warm pool\n",
+		controllers.acquires, controllers.warmHits);
+	report += line;
+
+	OutputDebugStringW(report.c_str());
+	MessageBoxW(g_hwnd, report.c_str(), L"Frame Timings", MB_OK);
+}
+
 LRESULT CALLBACK UrlBarProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR uIdSubclass, DWORD_PTR dwRefData) {
 	switch (uMsg) {
 	case WM_KEYDOWN:
@@ -521,40 +1535,101 @@ LRESULT CALLBACK UrlBarProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
 	switch (uMsg) {
 	case WM_DESTROY: {
-		while (!g_tabs.empty()) {
-			CloseTab(g_tabs.size() - 1);
+		// Writes out whatever the journal still has queued
+		g_journal.reset();
+
+		// Release directly; CloseTab would open a new tab after the last one
+		for (TabInfo& tab : g_tabs) {
+			ReleaseTab(tab);
 		}
+		g_controllerPool.Clear();
 		CoUninitialize();
 		PostQuitMessage(0);
 		return 0;
 	}
 
 	case WM_SIZE:
-		if (g_currentTab >= 0 && g_currentTab < g_tabs.size()) {
-			ResizeBrowser();
+		if (CurrentTab()) {
+			// While dragging, follow the size at most once per frame; otherwise
+			// (maximize, restore, snap) apply it at once
+			g_framePacer.Request(FRAME_WORK_LAYOUT | FRAME_WORK_PAINT);
+			if (g_inSizeMove) {
+				PumpFrame(hwnd);
+			}
+			else {
+				RunFrameWork(hwnd, g_framePacer.Flush());
+			}
 		}
 		return 0;
 
+	case WM_ENTERSIZEMOVE:
+		g_inSizeMove = true;
+		g_framePacer.SetFrameInterval(GetDisplayFrameInterval());
+		return 0;
+
+	case WM_EXITSIZEMOVE:
+		// Apply the final size exactly, whether or not a frame is due
+		g_inSizeMove = false;
+		KillTimer(hwnd, FRAME_TIMER_ID);
+		RunFrameWork(hwnd, g_framePacer.Flush());
+		return 0;
+
+	case WM_DPICHANGED: {
+		// Swap in the tables for the new DPI, then take the size Windows suggests
+		ApplyUiMetrics(HIWORD(wParam));
+		const RECT* suggested = reinterpret_cast<const RECT*>(lParam);
+		SetWindowPos(hwnd, nullptr, suggested->left, suggested->top,
+			suggested->right - suggested->left, suggested->bottom - suggested->top,
+			SWP_NOZORDER | SWP_NOACTIVATE);
+
+		// The size may not have changed, but the chrome heights did
+		if (CurrentTab()) {
+			g_framePacer.Request(FRAME_WORK_LAYOUT | FRAME_WORK_PAINT);
+			RunFrameWork(hwnd, g_framePacer.Flush());
+		}
+
+		// Button metrics follow the DPI even when the bar keeps its size
+		SyncToolbarModel();
+		return 0;
+	}
+
+	case WM_TIMER:
+		if (wParam == FRAME_TIMER_ID) {
+			PumpFrame(hwnd);
+			return 0;
+		}
+		if (wParam == HIBERNATION_TIMER_ID) {
+			EvaluateHibernation();
+			return 0;
+		}
+		break;
+
 	case WM_COMMAND:
 		switch (LOWORD(wParam)) {
 		case ID_BACK:
-			if (g_currentTab >= 0 && g_currentTab < g_tabs.size() && g_tabs[g_currentTab].webView)
-				g_tabs[g_currentTab].webView->GoBack();
+			if (TabInfo* tab = CurrentTab(); tab && tab->webView)
+				tab->webView->GoBack();
 			break;
 
 		case ID_FORWARD:
-			if (g_currentTab >= 0 && g_currentTab < g_tabs.size() && g_tabs[g_currentTab].webView)
-				g_tabs[g_currentTab].webView->GoForward();
+			if (TabInfo* tab = CurrentTab(); tab && tab->webView)
+				tab->webView->GoForward();
 			break;
 
 		case ID_REFRESH:
-			if (g_currentTab >= 0 && g_currentTab < g_tabs.size() && g_tabs[g_currentTab].webView)
-				g_tabs[g_currentTab].webView->Reload();
+			if (TabInfo* tab = CurrentTab(); tab && tab->webView)
+				tab->webView->Reload();
 			break;
 
 		case ID_HOME:
-			if (g_currentTab >= 0 && g_currentTab < g_tabs.size() && g_tabs[g_currentTab].webView)
-				g_tabs[g_currentTab].webView->Navigate(L"https://www.google.com");
+			if (TabInfo* tab = CurrentTab(); tab && tab->webView)
+				tab->webView->Navigate(L"https://www.google.com");
+			break;
+
+		case ID_URLBAR:
+			if (HIWORD(wParam) == EN_CHANGE) {
+				g_urlBarTextStale = true;
+			}
 			break;
 
 		default:
@@ -562,17 +1637,6 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			break;
 		}
 		return 0;
-
-	case WM_NOTIFY: {
-		LPNMHDR pnmh = (LPNMHDR)lParam;
-		if (pnmh->hwndFrom == g_tabControl && pnmh->code == TCN_SELCHANGE) {
-			int newIndex = TabCtrl_GetCurSel(g_tabControl);
-			if (newIndex >= 0 && newIndex < g_tabs.size()) {
-				SwitchToTab(newIndex);
-			}
-		}
-		return 0;
-	}
 	}
 	return DefWindowProc(hwnd, uMsg, wParam, lParam);
 }
@@ -584,8 +1648,7 @@ void HandleMenuCommand(WPARAM wParam) {
 		break;
 
 	case ID_FILE_CLOSE_TAB:
-		if (g_currentTab >= 0)
-			CloseTab(g_currentTab);
+		CloseTab(g_currentTab);
 		break;
 
 	case ID_FILE_EXIT:
@@ -600,187 +1663,504 @@ void HandleMenuCommand(WPARAM wParam) {
 		ShowBookmarks();
 		break;
 
+	case ID_FILE_SEARCH_TABS:
+		ShowTabSearch();
+		break;
+
 	case ID_TOOLS_DEVTOOLS:
-		if (g_currentTab >= 0 && g_tabs[g_currentTab].webView)
-			g_tabs[g_currentTab].webView->OpenDevToolsWindow();
+		if (TabInfo* tab = CurrentTab(); tab && tab->webView)
+			tab->webView->OpenDevToolsWindow();
+		break;
+
+	case ID_TOOLS_FRAME_TIMINGS:
+		ShowFrameTimings();
 		break;
 	}
 }
 
-void CloseTab(int index) {
-	if (index < 0 || index >= g_tabs.size()) return;
+// Drops the tab's event handlers and WebView2 objects
+void ReleaseTab(TabInfo& tab) {
+	if (tab.webView) {
+		tab.webView->remove_NavigationCompleted(tab.tokens.navigationCompletedToken);
+		tab.webView->remove_DocumentTitleChanged(tab.tokens.titleChangedToken);
+	}
+	if (tab.controller) {
+		tab.controller->Close();
+	}
+	tab.webView = nullptr;
+	tab.controller = nullptr;
+}
+
+HibernationPolicy g_hibernation;
+
+// Stops a background tab's renderer without dropping it
+void SuspendTab(TabInfo& tab) {
+	ComPtr<ICoreWebView2_3> webView;
+	if (!tab.webView || FAILED(tab.webView.As(&webView))) {
+		return;
+	}
+
+	ComPtr<ICoreWebView2_19> memoryTarget;
+	if (SUCCEEDED(tab.webView.As(&memoryTarget))) {
+		memoryTarget->put_MemoryUsageTargetLevel(COREWEBVIEW2_MEMORY_USAGE_TARGET_LEVEL_LOW);
+	}
+	webView->TrySuspend(Callback<ICoreWebView2TrySuspendCompletedHandler>(
+		[](HRESULT result, BOOL isSuccessful) -> HRESULT {
+			return S_OK;
+		}).Get());
+	tab.sleep = TabSleep::Suspended;
+}
+
+// Drops a background tab's renderer; URL, title and scroll position stay in TabInfo
+void DiscardTab(TabInfo& tab) {
+	ReleaseTab(tab);
+	tab.sleep = TabSleep::Discarded;
+}
+
+// Resumes a suspended tab, or recreates the WebView of a discarded one
+void WakeTab(TabHandle handle) {
+	TabInfo* tab = g_tabs.Get(handle);
+	if (!tab) {
+		return;
+	}
+
+	if (tab->sleep == TabSleep::Suspended) {
+		ComPtr<ICoreWebView2_3> webView;
+		if (tab->webView && SUCCEEDED(tab->webView.As(&webView))) {
+			webView->Resume();
+		}
+		ComPtr<ICoreWebView2_19> memoryTarget;
+		if (tab->webView && SUCCEEDED(tab->webView.As(&memoryTarget))) {
+			memoryTarget->put_MemoryUsageTargetLevel(COREWEBVIEW2_MEMORY_USAGE_TARGET_LEVEL_NORMAL);
+		}
+	}
+	else if (tab->sleep == TabSleep::Discarded) {
+		tab->sleep = TabSleep::Awake;
+		tab->restoreScroll = tab->scrollY > 0;
+		InitializeWebView(handle);
+		return;
+	}
+	tab->sleep = TabSleep::Awake;
+}
 
-	// Remove event handlers before closing
-	if (g_tabs[index].webView) {
-		g_tabs[index].webView->remove_NavigationCompleted(g_tabs[index].tokens.navigationCompletedToken);
-		g_tabs[index].webView->remove_DocumentTitleChanged(g_tabs[index].tokens.titleChangedToken);
+// Remembers where the page was scrolled, in case the tab gets discarded
+void SaveScrollPosition(TabHandle handle) {
+	TabInfo* tab = g_tabs.Get(handle);
+	if (!tab || !tab->webView) {
+		return;
 	}
 
-	// Release WebView2 resources
-	g_tabs[index].webView = nullptr;
-	g_tabs[index].controller = nullptr;
+	ComPtr<ICoreWebView2> webView = tab->webView;
+	webView->ExecuteScript(L"Math.round(window.scrollY)", Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
+		[handle, webView](HRESULT result, LPCWSTR json) -> HRESULT {
+			// The reply is JSON: a number, or null if the page went away
+			TabInfo* tab = g_tabs.Get(handle);
+			float scrollY = 0;
+			if (tab && tab->webView == webView && SUCCEEDED(result) && json && NumberParser::ParseFloat(json, scrollY)) {
+				tab->scrollY = scrollY > 0 ? static_cast<int>(scrollY < 1e9f ? scrollY : 1e9f) : 0;
+				JournalTab(SessionJournal::RecordType::Scrolled, *tab, tab->scrollY);
+			}
+			return S_OK;
+		}).Get());
+}
 
-	TabCtrl_DeleteItem(g_tabControl, index);
-	g_tabs.erase(g_tabs.begin() + index);
+bool IsPlayingAudio(const TabInfo& tab) {
+	ComPtr<ICoreWebView2_8> webView;
+	BOOL playing = FALSE;
+	if (tab.webView && SUCCEEDED(tab.webView.As(&webView))) {
+		webView->get_IsDocumentPlayingAudio(&playing);
+	}
+	return playing;
+}
+
+// Suspends idle background tabs and discards the oldest ones past the tab budget
+void EvaluateHibernation() {
+	std::vector<TabActivity> activity;
+	activity.reserve(g_tabs.Size());
+	for (size_t i = 0; i < g_tabs.Size(); i++) {
+		const TabInfo& tab = g_tabs.ValueAt(i);
+		TabActivity entry;
+		entry.sleep = tab.sleep;
+		entry.lastActive = tab.lastActive;
+		entry.visible = g_tabs.HandleAt(i) == g_currentTab;
+		// Leave tabs alone while their WebView is still coming up, or while they play audio
+		entry.keepAwake = tab.sleep != TabSleep::Discarded && (!tab.webView || IsPlayingAudio(tab));
+		activity.push_back(entry);
+	}
 
-	if (g_tabs.empty()) {
-		g_currentTab = -1;
+	for (const HibernationAction& action : g_hibernation.Evaluate(activity, GetTickCount64())) {
+		TabInfo& tab = g_tabs.ValueAt(action.tab);
+		if (action.kind == HibernationAction::Discard) {
+			DiscardTab(tab);
+		}
+		else {
+			SuspendTab(tab);
+		}
+	}
+}
+
+// Restored tabs get their WebViews when first shown. Only the few next to
+// the active tab load ahead, one after another, so startup costs the same
+// however many tabs the session had.
+constexpr int RESTORE_PREFETCH_TABS = 2;
+
+std::vector<TabHandle> g_prefetchQueue;
+
+// The session file sits next to the executable, like the WebView2 user data folder
+std::wstring GetSessionPath() {
+	wchar_t path[MAX_PATH];
+	DWORD length = GetModuleFileNameW(nullptr, path, MAX_PATH);
+	std::wstring sessionPath(path, length);
+	size_t dot = sessionPath.find_last_of(L'.');
+	if (dot != std::wstring::npos && dot > sessionPath.find_last_of(L'\\')) {
+		sessionPath.resize(dot);
+	}
+	return sessionPath + L".session";
+}
+
+// Session journal on disk. Only touched from the journal's writer thread.
+class JournalFile : public SessionJournal::Storage {
+public:
+	explicit JournalFile(std::wstring path) : m_path(std::move(path)) {}
+
+	bool Append(std::string_view data) override {
+		if (!m_file) {
+			m_file.reset(CreateFileW(m_path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+			if (!m_file || !SetFilePointerEx(m_file.get(), {}, nullptr, FILE_END)) {
+				m_file.reset();
+				return false;
+			}
+		}
+		return WriteAll(m_file.get(), data);
+	}
+
+	// Write a new file and move it over the old one, so a failed write keeps the last journal
+	bool Replace(std::string_view data) override {
+		m_file.reset();
+		std::wstring tempPath = m_path + L".tmp";
+		wil::unique_hfile file(CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+		if (!file) {
+			return false;
+		}
+		bool written = WriteAll(file.get(), data);
+		file.reset();
+
+		if (!written || !MoveFileExW(tempPath.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+			DeleteFileW(tempPath.c_str());
+			return false;
+		}
+		return true;
+	}
+
+private:
+	// Flushed as well, so losing power costs no more than a crash does
+	static bool WriteAll(HANDLE file, std::string_view data) {
+		DWORD written = 0;
+		return WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) && written == data.size() &&
+			FlushFileBuffers(file);
+	}
+
+	std::wstring m_path;
+	wil::unique_hfile m_file;
+};
+
+// Queues a change to a tab for the journal; the file is written on the journal's thread
+void JournalTab(SessionJournal::RecordType type, const TabInfo& tab, int32_t value, std::wstring text) {
+	if (!g_journal) {
+		return;
+	}
+	SessionJournal::Record record;
+	record.type = type;
+	record.tab = tab.journalId;
+	record.value = value;
+	record.text = std::move(text);
+	g_journal->Write(std::move(record));
+}
+
+// Replays the journal left by the last run and starts journaling this one.
+// Brings back the saved tab strip; returns false if there was nothing to restore.
+bool RestoreSession() {
+	std::wstring path = GetSessionPath();
+	SessionJournal::Model model;
+	wil::unique_hfile file(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+	LARGE_INTEGER size;
+	if (file && GetFileSizeEx(file.get(), &size) && size.QuadPart <= 64 * 1024 * 1024) {
+		std::string data(static_cast<size_t>(size.QuadPart), '\0');
+		DWORD read = 0;
+		if (ReadFile(file.get(), data.data(), static_cast<DWORD>(data.size()), &read, nullptr)) {
+			// A torn last record is simply not replayed
+			data.resize(read);
+			SessionJournal::Replay(data, model);
+		}
+	}
+	file.reset();
+
+	// The writer starts by compacting what was replayed, dropping any torn tail
+	g_nextJournalId = model.NextId();
+	g_journalFile = std::make_unique<JournalFile>(path);
+	g_journal = std::make_unique<SessionJournal::Writer>(*g_journalFile, model);
+
+	Session::State& state = model.state;
+	if (state.tabs.empty()) {
+		return false;
+	}
+
+	// Every tab starts out discarded: just its strip entry and saved state
+	g_tabSearchBuilt = false;
+	std::vector<TabHandle> handles;
+	handles.reserve(state.tabs.size());
+	uint64_t now = GetTickCount64();
+	for (size_t i = 0; i < state.tabs.size(); i++) {
+		Session::Tab& saved = state.tabs[i];
+		std::wstring label = !saved.title.empty() ? saved.title : !saved.url.empty() ? saved.url : L"New Tab";
+		TabInfo tab;
+		tab.url = std::move(saved.url);
+		tab.title = std::move(saved.title);
+		tab.scrollY = saved.scrollY;
+		tab.sleep = TabSleep::Discarded;
+		tab.lastActive = now;
+		tab.journalId = model.ids[i];
+		TabHandle handle = InsertTab(std::move(tab), L"");
+		SetTabLabel(handle, label);
+		handles.push_back(handle);
+	}
+
+	// Showing the active tab creates its WebView; its first load starts the prefetch
+	int active = state.active >= 0 ? state.active : 0;
+	g_prefetchQueue.clear();
+	for (int position : Session::PrefetchOrder(static_cast<int>(handles.size()), active, RESTORE_PREFETCH_TABS)) {
+		g_prefetchQueue.push_back(handles[position]);
+	}
+	SwitchToTab(handles[active]);
+	return true;
+}
+
+// Starts loading the next restored tab that is still waiting, if any
+void PrefetchNextTab() {
+	while (!g_prefetchQueue.empty()) {
+		TabHandle handle = g_prefetchQueue.front();
+		g_prefetchQueue.erase(g_prefetchQueue.begin());
+		TabInfo* tab = g_tabs.Get(handle);
+		if (tab && tab->sleep == TabSleep::Discarded) {
+			WakeTab(handle);
+			return;
+		}
+	}
+}
+
+void CloseTab(TabHandle handle) {
+	TabInfo* tab = g_tabs.Get(handle);
+	if (!tab) return;
+
+	ReleaseTab(*tab);
+	JournalTab(SessionJournal::RecordType::Closed, *tab);
+	g_tabSearch.Remove(tab->journalId);
+
+	int position = TabPosition(handle);
+	g_tabStripModel.Erase(position);
+	InvalidateTabsFrom(position);
+	g_tabs.Erase(handle);
+
+	if (g_tabStripModel.Count() == 0) {
+		g_currentTab = TabHandle();
 		CreateTab();
 	}
-	else {
-		g_currentTab = min(index, g_tabs.size() - 1);
-		SwitchToTab(g_currentTab);
+	else if (handle == g_currentTab) {
+		g_currentTab = TabHandle();
+		SwitchToTab(TabAt(min(position, g_tabStripModel.Count() - 1)));
 	}
 }
 
-void InitializeWebView(int tabIndex) {
-	CreateCoreWebView2EnvironmentWithOptions(nullptr, nullptr, nullptr,
-		Callback<ICoreWebView2CreateCoreWebView2EnvironmentCompletedHandler>(
-			[tabIndex](HRESULT result, ICoreWebView2Environment* env) -> HRESULT {
-				if (FAILED(result)) {
-					MessageBoxW(g_hwnd, L"Failed to create WebView2 environment", L"Error", MB_OK);
-					return result;
-				}
+void InitializeWebView(TabHandle handle) {
+	g_controllerPool.Acquire([handle](bool succeeded, ComPtr<ICoreWebView2Controller> controller) {
+		if (!succeeded) {
+			MessageBoxW(g_hwnd, L"Failed to create WebView2 controller", L"Error", MB_OK);
+			return;
+		}
 
-				env->CreateCoreWebView2Controller(g_hwnd,
-					Callback<ICoreWebView2CreateCoreWebView2ControllerCompletedHandler>(
-						[tabIndex](HRESULT result, ICoreWebView2Controller* controller) -> HRESULT {
-							if (FAILED(result)) {
-								MessageBoxW(g_hwnd, L"Failed to create WebView2 controller", L"Error", MB_OK);
-								return result;
-							}
+		TabInfo* tab = g_tabs.Get(handle);
+		if (!tab) {
+			// The tab was closed while its controller was being created
+			g_controllerPool.Recycle(controller);
+			return;
+		}
 
-							if (tabIndex >= 0 && tabIndex < g_tabs.size()) {
-								g_tabs[tabIndex].controller = controller;
-								controller->get_CoreWebView2(&g_tabs[tabIndex].webView);
-
-								if (g_tabs[tabIndex].webView) {
-									// Configure WebView settings
-									ICoreWebView2Settings* settings;
-									g_tabs[tabIndex].webView->get_Settings(&settings);
-									if (settings) {
-										settings->put_IsScriptEnabled(TRUE);
-										settings->put_AreDefaultScriptDialogsEnabled(TRUE);
-										settings->put_IsWebMessageEnabled(TRUE);
-										settings->Release();  // Release after use
-									}
-
-									// Register navigation event handler
-									g_tabs[tabIndex].webView->add_NavigationCompleted(
-										Callback<ICoreWebView2NavigationCompletedEventHandler>(
-											[tabIndex](ICoreWebView2* sender, ICoreWebView2NavigationCompletedEventArgs* args) -> HRESULT {
-												if (tabIndex >= 0 && tabIndex < g_tabs.size()) {
-													wil::unique_cotaskmem_string url;
-													sender->get_Source(&url);
-													if (url) {
-														g_tabs[tabIndex].url = url.get();
-														if (tabIndex == g_currentTab && g_urlBar) {
-															SetWindowTextW(g_urlBar, url.get());
-														}
-													}
-												}
-												return S_OK;
-											}).Get(),
-												&g_tabs[tabIndex].tokens.navigationCompletedToken);
-
-									// Register document title changed event handler
-									g_tabs[tabIndex].webView->add_DocumentTitleChanged(
-										Callback<ICoreWebView2DocumentTitleChangedEventHandler>(
-											[tabIndex](ICoreWebView2* sender, IUnknown* args) -> HRESULT {
-												if (tabIndex >= 0 && tabIndex < g_tabs.size()) {
-													wil::unique_cotaskmem_string title;
-													sender->get_DocumentTitle(&title);
-													if (title) {
-														g_tabs[tabIndex].title = title.get();
-
-														// Update tab text safely
-														TCITEMW tie = { 0 };
-														tie.mask = TCIF_TEXT;
-														tie.pszText = const_cast<LPWSTR>(g_tabs[tabIndex].title.c_str());
-														tie.cchTextMax = static_cast<int>(g_tabs[tabIndex].title.length());
-
-														if (IsWindow(g_tabControl)) {
-															TabCtrl_SetItem(g_tabControl, tabIndex, &tie);
-														}
-													}
-												}
-												return S_OK;
-											}).Get(),
-												&g_tabs[tabIndex].tokens.titleChangedToken);
-
-									// Position the WebView
-									RECT bounds;
-									GetClientRect(g_hwnd, &bounds);
-									controller->put_Bounds(bounds);
-
-									// Navigate to default page
-									g_tabs[tabIndex].webView->Navigate(L"https://www.google.com");
+		tab->controller = controller;
+		controller->get_CoreWebView2(&tab->webView);
+		controller->put_IsVisible(handle == g_currentTab);
+
+		if (tab->webView) {
+			// Configure WebView settings
+			ICoreWebView2Settings* settings;
+			tab->webView->get_Settings(&settings);
+			if (settings) {
+				settings->put_IsScriptEnabled(TRUE);
+				settings->put_AreDefaultScriptDialogsEnabled(TRUE);
+				settings->put_IsWebMessageEnabled(TRUE);
+				settings->Release();  // Release after use
+			}
+
+			// Register navigation event handler
+			tab->webView->add_NavigationCompleted(
+				Callback<ICoreWebView2NavigationCompletedEventHandler>(
+					[handle](ICoreWebView2* sender, ICoreWebView2NavigationCompletedEventArgs* args) -> HRESULT {
+						if (TabInfo* tab = g_tabs.Get(handle)) {
+							wil::unique_cotaskmem_string url;
+							sender->get_Source(&url);
+							if (url) {
+								if (tab->url != url.get()) {
+									tab->url = url.get();
+									JournalTab(SessionJournal::RecordType::Navigated, *tab, 0, tab->url);
+									IndexTab(*tab);
 								}
+								if (handle == g_currentTab && g_urlBar) {
+									SetWindowTextW(g_urlBar, url.get());
+								}
+							}
+
+							// A discarded tab that reloaded goes back to its old scroll position
+							if (tab->restoreScroll) {
+								std::wstring script = L"window.scrollTo(0, " + std::to_wstring(tab->scrollY) + L")";
+								sender->ExecuteScript(script.c_str(), Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
+									[](HRESULT result, LPCWSTR json) -> HRESULT {
+										return S_OK;
+									}).Get());
+								tab->restoreScroll = false;
 							}
+						}
+
+						// Each finished load lets the next restored tab start loading
+						PrefetchNextTab();
+						return S_OK;
+					}).Get(),
+						&tab->tokens.navigationCompletedToken);
+
+			// Register document title changed event handler
+			tab->webView->add_DocumentTitleChanged(
+				Callback<ICoreWebView2DocumentTitleChangedEventHandler>(
+					[handle](ICoreWebView2* sender, IUnknown* args) -> HRESULT {
+						TabInfo* tab = g_tabs.Get(handle);
+						if (!tab) {
 							return S_OK;
-						}).Get());
-				return S_OK;
-			}).Get());
+						}
+
+						wil::unique_cotaskmem_string title;
+						sender->get_DocumentTitle(&title);
+						// Unchanged titles would only make the tab control re-measure
+						if (title && tab->title != title.get()) {
+							tab->title = title.get();
+							SetTabLabel(handle, tab->title);
+							JournalTab(SessionJournal::RecordType::TitleChanged, *tab, 0, tab->title);
+							IndexTab(*tab);
+						}
+						return S_OK;
+					}).Get(),
+						&tab->tokens.titleChangedToken);
+
+			// Position the WebView if its tab is showing; SwitchToTab does it otherwise
+			if (handle == g_currentTab) {
+				ResizeBrowser();
+			}
+
+			// Navigate to the default page, or back to where a discarded tab was
+			tab->webView->Navigate(tab->url.empty() ? L"https://www.google.com" : tab->url.c_str());
+		}
+	});
 }
 
 
-void ResizeBrowser() {
-	if (g_currentTab < 0 || g_currentTab >= g_tabs.size() || !g_tabs[g_currentTab].controller) {
-		return;
+// Adds a window move to a DeferWindowPos batch unless the window is already there.
+// If the batch has failed, moves the window directly instead.
+HDWP DeferChromeWindow(HDWP batch, HWND hwnd, LayoutBand band, const ChromeRect& rect) {
+	ChromeRect& applied = g_chromeRects[band];
+	if (rect.left == applied.left && rect.top == applied.top && rect.right == applied.right && rect.bottom == applied.bottom) {
+		return batch;
+	}
+	applied = rect;
+
+	UINT flags = SWP_NOZORDER | SWP_NOACTIVATE;
+	if (batch) {
+		return DeferWindowPos(batch, hwnd, nullptr, rect.left, rect.top, rect.Width(), rect.Height(), flags);
+	}
+	SetWindowPos(hwnd, nullptr, rect.left, rect.top, rect.Width(), rect.Height(), flags);
+	return nullptr;
+}
+
+// Refresh period of the display in microseconds, or 60 Hz if DWM can't say
+uint64_t GetDisplayFrameInterval() {
+	DWM_TIMING_INFO info = {};
+	info.cbSize = sizeof(info);
+	if (SUCCEEDED(DwmGetCompositionTimingInfo(nullptr, &info)) && info.rateRefresh.uiNumerator > 0) {
+		return uint64_t(1000000) * info.rateRefresh.uiDenominator / info.rateRefresh.uiNumerator;
 	}
+	return 1000000 / 60;
+}
+
+void RunFrameWork(HWND hwnd, uint32_t work) {
+	if (work & FRAME_WORK_LAYOUT) {
+		ResizeBrowser();
+	}
+	if (work & FRAME_WORK_PAINT) {
+		RedrawWindow(hwnd, nullptr, nullptr, RDW_UPDATENOW | RDW_ALLCHILDREN);
+	}
+}
+
+// Runs the pending frame work if it is due, and keeps the frame timer
+// armed for whatever is still pending
+void PumpFrame(HWND hwnd) {
+	RunFrameWork(hwnd, g_framePacer.TakeDue());
 
+	uint64_t wait = g_framePacer.TimeUntilDue();
+	if (wait == FramePacer::NOT_PENDING) {
+		KillTimer(hwnd, FRAME_TIMER_ID);
+	}
+	else {
+		SetTimer(hwnd, FRAME_TIMER_ID, static_cast<UINT>((wait + 999) / 1000), nullptr);
+	}
+}
+
+void ResizeBrowser() {
+	FrameTimer timer(FRAME_RESIZE);
 	RECT bounds;
 	GetClientRect(g_hwnd, &bounds);
 
-	// Add some padding for modern look
-	const int PADDING = 8;
-
-	// Position the toolbar
-	SendMessage(g_toolbar, TB_AUTOSIZE, 0, 0);
-
-	// Position the tab control with padding
-	SetWindowPos(g_tabControl, nullptr,
-		PADDING, TOOLBAR_HEIGHT,
-		bounds.right - (PADDING * 2), TAB_HEIGHT,
-		SWP_NOZORDER);
-
-	// Position the URL bar with padding
-	SetWindowPos(g_urlBar, nullptr,
-		PADDING, TOOLBAR_HEIGHT + TAB_HEIGHT + (PADDING / 2),
-		bounds.right - (PADDING * 2), URL_BAR_HEIGHT,
-		SWP_NOZORDER);
-
-	// Calculate WebView bounds with padding
-	RECT webViewBounds = {
-		PADDING,
-		TOOLBAR_HEIGHT + TAB_HEIGHT + URL_BAR_HEIGHT + PADDING,
-		bounds.right - PADDING,
-		bounds.bottom - PADDING
-	};
+	// Solve the whole layout first
+	ChromeRect rects[LAYOUT_BAND_COUNT];
+	ChromeLayout::Solve(g_chromeLayout, LAYOUT_BAND_COUNT, bounds.right, bounds.bottom, rects);
+
+	// Then move the chrome windows together, so they relayout and repaint once
+	HDWP batch = BeginDeferWindowPos(3);  // Toolbar, tabs and URL bar
+	batch = DeferChromeWindow(batch, g_toolbar, LAYOUT_TOOLBAR, rects[LAYOUT_TOOLBAR]);
+	batch = DeferChromeWindow(batch, g_tabStrip, LAYOUT_TABS, rects[LAYOUT_TABS]);
+	batch = DeferChromeWindow(batch, g_urlBar, LAYOUT_URL_BAR, rects[LAYOUT_URL_BAR]);
+	if (batch) {
+		EndDeferWindowPos(batch);
+	}
+
+	TabInfo* tab = CurrentTab();
+	if (!tab || !tab->controller) {
+		return;
+	}
 
 	// Resize the WebView
-	g_tabs[g_currentTab].controller->put_Bounds(webViewBounds);
+	const ChromeRect& content = rects[LAYOUT_CONTENT];
+	RECT webViewBounds = { content.left, content.top, content.right, content.bottom };
+	tab->controller->put_Bounds(webViewBounds);
 }
 
-void InitializeControls(HWND hwnd, HINSTANCE hInstance) {
-	WindowStyle::ApplyModernStyle(hwnd);
+// Switches the chrome to the metrics table for dpi: layout bands and UI font
+void ApplyUiMetrics(UINT dpi) {
+	g_metrics = &g_uiMetricsCache.Get(dpi);
+	const UiMetrics& metrics = *g_metrics;
 
-	// Create URL bar with modern styling
-	g_urlBar = CreateWindowExW(
-		0, // Remove WS_EX_CLIENTEDGE for modern look
-		L"EDIT",
-		L"",
-		WS_CHILD | WS_VISIBLE | ES_AUTOHSCROLL,
-		0, TOOLBAR_HEIGHT + TAB_HEIGHT,
-		WINDOW_WIDTH, URL_BAR_HEIGHT,
-		hwnd,
-		(HMENU)ID_URLBAR,
-		hInstance,
-		nullptr
-	);
+	int padding = metrics.padding;
+	g_chromeLayout[LAYOUT_TOOLBAR] = { metrics.toolbarHeight };
+	g_chromeLayout[LAYOUT_TABS] = { metrics.tabHeight, padding, 0, padding, 0 };
+	g_chromeLayout[LAYOUT_URL_BAR] = { metrics.urlBarHeight, padding, padding / 2, padding, 0 };
+	g_chromeLayout[LAYOUT_CONTENT] = { ChromeLayout::FILL, padding, padding / 2, padding, padding };
 
-	HFONT hFont = CreateFontW(
-		-14,              // Height
+	wil::unique_hfont font(CreateFontW(
+		metrics.fontHeight, // Height
 		0,               // Width
 		0,               // Escapement
 		0,               // Orientation
@@ -794,82 +2174,94 @@ void InitializeControls(HWND hwnd, HINSTANCE hInstance) {
 		CLEARTYPE_QUALITY,           // Quality
 		DEFAULT_PITCH | FF_DONTCARE, // PitchAndFamily
 		L"Segoe UI"     // Modern font
+	));
+
+	// Hand the controls the new font before the old one is freed. The glyph
+	// atlas is keyed by font handle, which may be reused, so drop it too.
+	SendMessage(g_urlBar, WM_SETFONT, (WPARAM)font.get(), TRUE);
+	g_chromeText.reset();
+	g_uiFont = std::move(font);
+
+	// Tab widths were measured in the old font; remeasure as tabs come into view
+	g_tabStripModel.ResetWidths(EstimatedTabWidth());
+	for (TabInfo& tab : g_tabs) {
+		tab.labelMeasured = false;
+	}
+	if (g_tabStrip) {
+		InvalidateRect(g_tabStrip, nullptr, FALSE);
+	}
+}
+
+void InitializeControls(HWND hwnd, HINSTANCE hInstance) {
+	WindowStyle::ApplyModernStyle(hwnd);
+
+	// Create URL bar with modern styling
+	g_urlBar = CreateWindowExW(
+		0, // Remove WS_EX_CLIENTEDGE for modern look
+		L"EDIT",
+		L"",
+		WS_CHILD | WS_VISIBLE | ES_AUTOHSCROLL,
+		0, 0, 0, 0,  // Positioned by ResizeBrowser
+		hwnd,
+		(HMENU)ID_URLBAR,
+		hInstance,
+		nullptr
 	);
 
-	// Create tab control with modern styling
-	g_tabControl = CreateWindowExW(
+	// Create the tab strip. It draws itself and only measures the tabs in view,
+	// where a tab control would relayout every tab on each change.
+	WNDCLASSW tabStripClass = {};
+	tabStripClass.lpfnWndProc = TabStripProc;
+	tabStripClass.hInstance = hInstance;
+	tabStripClass.lpszClassName = L"DingusTabStrip";
+	tabStripClass.hCursor = LoadCursor(nullptr, IDC_ARROW);
+	RegisterClassW(&tabStripClass);
+
+	// Popup for File > Search Tabs
+	WNDCLASSW searchClass = {};
+	searchClass.lpfnWndProc = TabSearchProc;
+	searchClass.hInstance = hInstance;
+	searchClass.lpszClassName = TAB_SEARCH_CLASS;
+	searchClass.hbrBackground = (HBRUSH)(COLOR_WINDOW + 1);
+	searchClass.hCursor = LoadCursor(nullptr, IDC_ARROW);
+	RegisterClassW(&searchClass);
+
+	g_tabStrip = CreateWindowExW(
 		0,
-		WC_TABCONTROLW,
+		tabStripClass.lpszClassName,
 		nullptr,
-		WS_CHILD | WS_VISIBLE | WS_CLIPSIBLINGS | TCS_FLATBUTTONS | TCS_BUTTONS,
-		0, TOOLBAR_HEIGHT,
-		WINDOW_WIDTH, TAB_HEIGHT,
+		WS_CHILD | WS_VISIBLE | WS_CLIPSIBLINGS,
+		0, 0, 0, 0,  // Positioned by ResizeBrowser
 		hwnd,
-		(HMENU)ID_TABCTRL,
+		(HMENU)ID_TABSTRIP,
 		hInstance,
 		nullptr
 	);
 
-	SendMessage(g_urlBar, WM_SETFONT, (WPARAM)hFont, TRUE);
-	SendMessage(g_tabControl, WM_SETFONT, (WPARAM)hFont, TRUE);
-
-	// Set up modern tab control styling
-	DWORD extendedStyle = TCS_EX_FLATSEPARATORS;
-	SendMessage(g_tabControl, TCM_SETEXTENDEDSTYLE, 0, extendedStyle);
+	// Font and layout for the window's DPI
+	ApplyUiMetrics(GetDpiForWindow(hwnd));
 
 	// Set up URL bar event handling with subclassing
 	SetWindowSubclass(g_urlBar, UrlBarProc, 0, 0);
 }
 
-void NavigateToUrl(int tabIndex) {
-	if (tabIndex < 0 || tabIndex >= g_tabs.size() || !g_tabs[tabIndex].webView) {
+void NavigateToUrl(TabHandle handle) {
+	TabInfo* tab = g_tabs.Get(handle);
+	if (!tab || !tab->webView) {
 		return;
 	}
 
 	// Get the URL from the URL bar
 	wchar_t urlBuffer[2048];
 	GetWindowTextW(g_urlBar, urlBuffer, 2048);
-	std::wstring url(urlBuffer);
-
-	// If the URL doesn't start with a protocol, add https://
-	if (url.find(L"://") == std::wstring::npos) {
-		// Check if it's a valid IP address or localhost
-		if (url.find(L"localhost") == 0 ||
-			url.find(L"127.0.0.1") == 0) {
-			url = L"http://" + url;
-		}
-		// Check if it's a file path
-		else if (url.find(L"/") == 0 ||
-			(url.length() > 1 && url[1] == L':')) {
-			url = L"file:///" + url;
-		}
-		// Default to https
-		else {
-			// Remove any leading/trailing whitespace
-			url.erase(0, url.find_first_not_of(L" \t"));
-			url.erase(url.find_last_not_of(L" \t") + 1);
-
-			// If it starts with "www.", just add https://
-			if (url.substr(0, 4) == L"www.") {
-				url = L"https://" + url;
-			}
-			// Otherwise, add both https:// and www.
-			else if (url.find(L".") != std::wstring::npos) {
-				url = L"https://www." + url;
-			}
-			// If it doesn't contain a dot, treat it as a search query
-			else {
-				url = L"https://www.google.com/search?q=" +
-					std::wstring(urlBuffer);
-			}
-		}
-	}
+	// Add a scheme, or turn the text into a search
+	std::wstring url = UrlInput::Resolve(urlBuffer).url;
 
 	// Update the URL bar with the processed URL
 	SetWindowTextW(g_urlBar, url.c_str());
 
 	// Navigate to the URL
-	HRESULT hr = g_tabs[tabIndex].webView->Navigate(url.c_str());
+	HRESULT hr = tab->webView->Navigate(url.c_str());
 	if (FAILED(hr)) {
 		MessageBoxW(g_hwnd,
 			L"Failed to navigate to the specified URL",
@@ -879,9 +2271,7 @@ void NavigateToUrl(int tabIndex) {
 }
 
 void HandleUrlBarInput() {
-	if (g_currentTab >= 0 && g_currentTab < g_tabs.size()) {
-		NavigateToUrl(g_currentTab);
-	}
+	NavigateToUrl(g_currentTab);
 }
 
 void CreateMenuBar(HWND hwnd) {
@@ -893,6 +2283,7 @@ void CreateMenuBar(HWND hwnd) {
 	// File menu
 	AppendMenuW(hFileMenu, MF_STRING, ID_FILE_NEW_TAB, L"New Tab\tCtrl+T");
 	AppendMenuW(hFileMenu, MF_STRING, ID_FILE_CLOSE_TAB, L"Close Tab\tCtrl+W");
+	AppendMenuW(hFileMenu, MF_STRING, ID_FILE_SEARCH_TABS, L"Search Tabs\tCtrl+Shift+A");
 	AppendMenuW(hFileMenu, MF_SEPARATOR, 0, nullptr);
 	AppendMenuW(hFileMenu, MF_STRING, ID_FILE_EXIT, L"Exit\tAlt+F4");
 	AppendMenuW(hMenuBar, MF_POPUP, (UINT_PTR)hFileMenu, L"File");
@@ -905,6 +2296,8 @@ void CreateMenuBar(HWND hwnd) {
 	// Tools menu
 	AppendMenuW(hToolsMenu, MF_STRING, ID_TOOLS_DEVTOOLS, L"Developer Tools\tF12");
 	AppendMenuW(hToolsMenu, MF_STRING, ID_TOOLS_DOWNLOADS, L"Downloads\tCtrl+J");
+	AppendMenuW(hToolsMenu, MF_SEPARATOR, 0, nullptr);
+	AppendMenuW(hToolsMenu, MF_STRING, ID_TOOLS_FRAME_TIMINGS, L"Frame Timings");
 	AppendMenuW(hMenuBar, MF_POPUP, (UINT_PTR)hToolsMenu, L"Tools");
 
 	// Set the menu bar
@@ -915,11 +2308,12 @@ void CreateMenuBar(HWND hwnd) {
 		(LPACCEL)new ACCEL[]{
 			{FVIRTKEY | FCONTROL, 'T', ID_FILE_NEW_TAB},
 			{FVIRTKEY | FCONTROL, 'W', ID_FILE_CLOSE_TAB},
+			{FVIRTKEY | FCONTROL | FSHIFT, 'A', ID_FILE_SEARCH_TABS},
 			{FVIRTKEY | FCONTROL, 'D', ID_BOOKMARKS_ADD},
 			{FVIRTKEY | FCONTROL, 'B', ID_BOOKMARKS_VIEW},
 			{FVIRTKEY | FCONTROL, 'J', ID_TOOLS_DOWNLOADS},
 			{FVIRTKEY, VK_F12, ID_TOOLS_DEVTOOLS}
 		},
-		6
+		7
 	);
 }
\ No newline at end of file
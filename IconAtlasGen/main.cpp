@@ -0,0 +1,125 @@
+// Build step: rasterizes every <symbol> in the icon sheet at each DPI scale
+// and packs the coverage masks into one atlas file for the browser to map.
+//
+// Usage: IconAtlasGen <Icons.svg> <output.atlas> [icon size at 96 DPI]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../DingusBrowser/IconAtlas.h"
+#include "../DingusBrowser/IconRaster.h"
+#include "../DingusBrowser/SvgPath.h"
+#include "../DingusBrowser/SymbolSheet.h"
+
+struct Mask {
+	IconAtlas::Entry entry;
+	std::vector<uint8_t> pixels;
+};
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		fprintf(stderr, "Usage: IconAtlasGen <Icons.svg> <output.atlas> [icon size]\n");
+		return 1;
+	}
+	int baseSize = argc > 3 ? atoi(argv[3]) : 20;
+	if (baseSize <= 0) {
+		fprintf(stderr, "IconAtlasGen: invalid icon size\n");
+		return 1;
+	}
+
+	std::ifstream input(argv[1], std::ios::binary);
+	if (!input) {
+		fprintf(stderr, "IconAtlasGen: cannot open %s\n", argv[1]);
+		return 1;
+	}
+	std::stringstream buffer;
+	buffer << input.rdbuf();
+	std::string svg = buffer.str();
+
+	SymbolSheet sheet;
+	sheet.Index(svg.data(), svg.size());
+
+	std::vector<Mask> masks;
+	size_t symbolCount = 0;
+	IconRaster::CoverageRasterizer rasterizer;
+	for (size_t i = 0; i < sheet.Count(); i++) {
+		const SheetSymbol& symbol = sheet.At(i);
+		if (symbol.id.empty() || symbol.id.size() >= IconAtlas::NAME_LENGTH) {
+			fprintf(stderr, "IconAtlasGen: skipping symbol '%.*s'\n",
+				static_cast<int>(symbol.id.size()), symbol.id.data());
+			continue;
+		}
+		if (sheet.Find(symbol.id) != static_cast<int>(i)) {
+			// The atlas needs unique entries; the first definition wins, as in the sheet
+			fprintf(stderr, "IconAtlasGen: skipping duplicate symbol '%.*s'\n",
+				static_cast<int>(symbol.id.size()), symbol.id.data());
+			continue;
+		}
+
+		const IconPath* path = sheet.GetPath(i);
+		if (!path) {
+			fprintf(stderr, "IconAtlasGen: no usable path data in '%.*s'\n",
+				static_cast<int>(symbol.id.size()), symbol.id.data());
+			return 1;
+		}
+		symbolCount++;
+
+		for (uint16_t dpi : IconAtlas::DPI_SCALES) {
+			int size = (baseSize * dpi + 48) / 96;
+
+			Mask mask = {};
+			memcpy(mask.entry.name, symbol.id.data(), symbol.id.size());
+			mask.entry.dpi = dpi;
+			mask.entry.size = static_cast<uint16_t>(size);
+			mask.pixels.resize(static_cast<size_t>(size) * size);
+
+			// Sheet paths are normalized to the 24x24 icon space
+			rasterizer.Reset(size, size);
+			rasterizer.AddPath(*path, static_cast<float>(size) / 24.0f, 0.0f, 0.0f);
+			rasterizer.Resolve(mask.pixels.data(), size);
+			masks.push_back(std::move(mask));
+		}
+	}
+
+	std::sort(masks.begin(), masks.end(), [](const Mask& a, const Mask& b) {
+		return IconAtlas::CompareEntry(a.entry, b.entry.name, b.entry.dpi) < 0;
+	});
+
+	IconAtlas::Header header = { IconAtlas::MAGIC, IconAtlas::VERSION, static_cast<uint32_t>(masks.size()), 0 };
+	size_t offset = sizeof(header) + masks.size() * sizeof(IconAtlas::Entry);
+	for (Mask& mask : masks) {
+		offset = (offset + 3) & ~static_cast<size_t>(3);
+		mask.entry.offset = static_cast<uint32_t>(offset);
+		offset += mask.pixels.size();
+	}
+
+	std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+	if (!output) {
+		fprintf(stderr, "IconAtlasGen: cannot write %s\n", argv[2]);
+		return 1;
+	}
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (const Mask& mask : masks) {
+		output.write(reinterpret_cast<const char*>(&mask.entry), sizeof(mask.entry));
+	}
+	size_t written = sizeof(header) + masks.size() * sizeof(IconAtlas::Entry);
+	for (const Mask& mask : masks) {
+		static const char padding[4] = {};
+		output.write(padding, mask.entry.offset - written);
+		output.write(reinterpret_cast<const char*>(mask.pixels.data()), mask.pixels.size());
+		written = mask.entry.offset + mask.pixels.size();
+	}
+	if (!output) {
+		fprintf(stderr, "IconAtlasGen: write to %s failed\n", argv[2]);
+		return 1;
+	}
+
+	printf("IconAtlasGen: %zu symbols, %zu masks -> %s\n", symbolCount, masks.size(), argv[2]);
+	return 0;
+}
@@ -0,0 +1,103 @@
+#include "Check.h"
+
+#include <memory>
+
+#include "BackBufferPool.h"
+
+namespace {
+
+	// Counts live surfaces, so the test can see the old one freed first
+	int g_live = 0;
+	int g_peak = 0;
+
+	struct Surface {
+		std::shared_ptr<int> size;
+
+		static Surface Make(int width, int height) {
+			g_live++;
+			g_peak = g_live > g_peak ? g_live : g_peak;
+			return { std::shared_ptr<int>(new int(width * height), [](int* p) { g_live--; delete p; }) };
+		}
+	};
+
+	struct Recorder {
+		int calls = 0;
+		int width = 0;
+		int height = 0;
+
+		Surface operator()(int w, int h) {
+			calls++;
+			width = w;
+			height = h;
+			return Surface::Make(w, h);
+		}
+	};
+}
+
+TEST_CASE(BucketSizes) {
+	CHECK(BackBufferPool<Surface>::BucketSize(0) == 64);
+	CHECK(BackBufferPool<Surface>::BucketSize(1) == 64);
+	CHECK(BackBufferPool<Surface>::BucketSize(64) == 64);
+	CHECK(BackBufferPool<Surface>::BucketSize(65) == 128);
+}
+
+TEST_CASE(ReusesWithinBucket) {
+	BackBufferPool<Surface> pool;
+	Recorder create;
+	Surface& first = pool.Acquire(0, 100, 30, 96, create);
+	CHECK(create.calls == 1 && create.width == 128 && create.height == 64);
+
+	// Repaints and small resizes keep the surface
+	Surface& again = pool.Acquire(0, 128, 64, 96, create);
+	pool.Acquire(0, 70, 10, 96, create);
+	CHECK(create.calls == 1 && &again == &first);
+	CHECK(pool.Stats().allocations == 1 && pool.Stats().reuses == 2);
+}
+
+TEST_CASE(ReplacesWhenOutgrownShrunkOrDpiChanges) {
+	BackBufferPool<Surface> pool;
+	Recorder create;
+	pool.Acquire(0, 500, 100, 96, create);
+	pool.Acquire(0, 600, 100, 96, create);  // Outgrown
+	CHECK(create.calls == 2 && create.width == 640);
+
+	pool.Acquire(0, 300, 100, 96, create);  // Half the area: kept
+	CHECK(create.calls == 2);
+	pool.Acquire(0, 100, 60, 96, create);   // Far below: replaced
+	CHECK(create.calls == 3 && create.width == 128 && create.height == 64);
+
+	pool.Acquire(0, 100, 60, 144, create);  // New DPI
+	CHECK(create.calls == 4);
+
+	// The old surface is freed before the new one is made
+	CHECK(g_peak == 1 && g_live == 1);
+}
+
+TEST_CASE(SlotsAreIndependent) {
+	BackBufferPool<Surface> pool;
+	Recorder create;
+	pool.Acquire(2, 100, 30, 96, create);
+	pool.Acquire(0, 100, 30, 96, create);
+	CHECK(create.calls == 2);
+
+	pool.Release(2);
+	pool.Release(9);
+	pool.Acquire(0, 100, 30, 96, create);
+	CHECK(create.calls == 2);
+	pool.Acquire(2, 100, 30, 96, create);
+	CHECK(create.calls == 3);
+
+	pool.Clear();
+	CHECK(g_live == 0);
+}
+
+TEST_CASE(SweepingResizeAllocatesRarely) {
+	// Dragging a window edge 800 pixels each way, 3 pixels per step
+	BackBufferPool<Surface> pool;
+	Recorder create;
+	int steps = 0;
+	for (int width = 100; width < 900; width += 3, steps++) pool.Acquire(0, width, 30, 96, create);
+	for (int width = 900; width > 50; width -= 3, steps++) pool.Acquire(0, width, 30, 96, create);
+	CHECK(create.calls <= 20);
+	CHECK(static_cast<int>(pool.Stats().allocations + pool.Stats().reuses) == steps);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "LatencyHistogram.h"
+
+// Minimal benchmark harness for the portable modules.
+//
+// Run() times a batch of items twice: once as a tight loop for throughput,
+// and once item by item into a LatencyHistogram for the p50/p90/p99 of a
+// single call. Pass --quick (as ctest does) to run each batch a few times,
+// which only checks that the benchmark still works.
+namespace Bench {
+
+	struct Options {
+		int repeat = 200;
+	};
+
+	inline Options ParseOptions(int argc, char** argv) {
+		Options options;
+		for (int i = 1; i < argc; i++) {
+			if (strcmp(argv[i], "--quick") == 0) options.repeat = 2;
+			else if (strncmp(argv[i], "--repeat=", 9) == 0) options.repeat = atoi(argv[i] + 9);
+		}
+		return options;
+	}
+
+	// Keeps results alive so the optimizer can't drop the work
+	inline void Consume(size_t value) {
+		static volatile size_t sink;
+		sink = sink + value;
+	}
+
+	inline void PrintHeader() {
+		printf("%-28s %10s %10s %9s %9s %9s\n", "benchmark", "items", "MB/s", "p50 ns", "p90 ns", "p99 ns");
+	}
+
+	// fn(i) processes item i of count; bytes is the input size of one pass
+	// over all items, or 0 where throughput in bytes means nothing. Returns
+	// the seconds one pass took, for callers that report their own rates.
+	template <typename Fn>
+	double Run(const Options& options, const char* name, size_t count, size_t bytes, Fn&& fn) {
+		using Clock = std::chrono::steady_clock;
+
+		for (size_t i = 0; i < count; i++) fn(i);  // Warm up
+
+		Clock::time_point start = Clock::now();
+		for (int r = 0; r < options.repeat; r++) {
+			for (size_t i = 0; i < count; i++) fn(i);
+		}
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		LatencyHistogram latency;
+		for (int r = 0; r < options.repeat; r++) {
+			for (size_t i = 0; i < count; i++) {
+				Clock::time_point before = Clock::now();
+				fn(i);
+				latency.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count()));
+			}
+		}
+
+		LatencyHistogram::Summary summary = latency.Summarize();
+		double megabytes = static_cast<double>(bytes) * options.repeat / (1024.0 * 1024.0);
+		if (bytes && seconds > 0) {
+			printf("%-28s %10zu %10.1f %9llu %9llu %9llu\n", name, count, megabytes / seconds,
+				static_cast<unsigned long long>(summary.p50), static_cast<unsigned long long>(summary.p90), static_cast<unsigned long long>(summary.p99));
+		}
+		else {
+			printf("%-28s %10zu %10s %9llu %9llu %9llu\n", name, count, "-",
+				static_cast<unsigned long long>(summary.p50), static_cast<unsigned long long>(summary.p90), static_cast<unsigned long long>(summary.p99));
+		}
+		return options.repeat > 0 ? seconds / options.repeat : 0;
+	}
+}
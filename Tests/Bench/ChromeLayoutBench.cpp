@@ -0,0 +1,68 @@
+// ChromeLayout::Solve over the bands main.cpp builds, as a window is
+// resized: one row per DPI, each item one window size from a sweep of
+// 200x150 up to 3840x2160 (a resize drag produces one Solve per size).
+// A last row rebuilds the metrics and bands for every item, as moving
+// the window to a monitor with another DPI does.
+
+#include "Bench.h"
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "ChromeLayout.h"
+#include "UiMetrics.h"
+
+namespace {
+	constexpr int DPIS[] = { 96, 120, 144, 192, 288 };
+
+	enum LayoutBand {
+		LAYOUT_TOOLBAR,
+		LAYOUT_TABS,
+		LAYOUT_URL_BAR,
+		LAYOUT_CONTENT,
+		LAYOUT_BAND_COUNT
+	};
+
+	// As ApplyUiMetrics in main.cpp
+	void BuildBands(const UiMetrics& metrics, ChromeLayout::Band* bands) {
+		int padding = metrics.padding;
+		bands[LAYOUT_TOOLBAR] = { metrics.toolbarHeight };
+		bands[LAYOUT_TABS] = { metrics.tabHeight, padding, 0, padding, 0 };
+		bands[LAYOUT_URL_BAR] = { metrics.urlBarHeight, padding, padding / 2, padding, 0 };
+		bands[LAYOUT_CONTENT] = { ChromeLayout::FILL, padding, padding / 2, padding, padding };
+	}
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+	Bench::PrintHeader();
+
+	std::vector<std::pair<int, int>> sizes;
+	for (int width = 200; width <= 3840; width += 40) {
+		sizes.emplace_back(width, 150 + (width - 200) * (2160 - 150) / (3840 - 200));
+	}
+
+	UiMetrics base;
+	ChromeRect rects[LAYOUT_BAND_COUNT];
+	for (int dpi : DPIS) {
+		ChromeLayout::Band bands[LAYOUT_BAND_COUNT];
+		BuildBands(ScaleUiMetrics(base, dpi), bands);
+
+		char name[64];
+		snprintf(name, sizeof(name), "Solve %d dpi", dpi);
+		Bench::Run(options, name, sizes.size(), 0, [&](size_t i) {
+			ChromeLayout::Solve(bands, LAYOUT_BAND_COUNT, sizes[i].first, sizes[i].second, rects);
+			Bench::Consume(static_cast<size_t>(rects[LAYOUT_CONTENT].bottom));
+		});
+	}
+
+	Bench::Run(options, "scale+Solve all dpis", sizes.size() * std::size(DPIS), 0, [&](size_t i) {
+		ChromeLayout::Band bands[LAYOUT_BAND_COUNT];
+		BuildBands(ScaleUiMetrics(base, DPIS[i % std::size(DPIS)]), bands);
+		const std::pair<int, int>& size = sizes[i / std::size(DPIS)];
+		ChromeLayout::Solve(bands, LAYOUT_BAND_COUNT, size.first, size.second, rects);
+		Bench::Consume(static_cast<size_t>(rects[LAYOUT_CONTENT].bottom));
+	});
+	return 0;
+}
@@ -0,0 +1,284 @@
+// Full chrome frames (toolbar, tab strip, URL bar) painted into a
+// SoftwareCanvas at common window widths and tab counts. MB/s is the rate
+// at which finished frame pixels are produced.
+//
+// A hover storm replays thousands of synthetic mouse moves through the
+// toolbar model the way the toolbar's WM_MOUSEMOVE handler does, one
+// percentile sample per event.
+//
+// The toolbar icon pipeline is measured separately on the same icon set
+// main.cpp draws: transforming it to each icon size as int16 fixed-point
+// x/y arrays versus the float point list it replaced, rasterizing each icon
+// from either form, and curve flattening with its throughput and the
+// largest distance it left between curve and polyline.
+
+#include "Bench.h"
+#include "BoxGlyphSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ChromePaint.h"
+#include "IconFlatten.h"
+#include "IconGeometry.h"
+#include "IconRaster.h"
+#include "SoftwareCanvas.h"
+#include "ToolbarIcons.h"
+
+namespace {
+	template <typename Icon>
+	constexpr IconPath MakeIconPath() {
+		return { Icon::Data.points, Icon::Data.types, static_cast<int>(Icon::Count) };
+	}
+
+	// main.cpp's g_toolbarIcons, without the empty new-tab slot
+	constexpr IconPath g_toolbarIcons[] = {
+		MakeIconPath<ToolbarIcons::Back>(),
+		MakeIconPath<ToolbarIcons::Forward>(),
+		MakeIconPath<ToolbarIcons::Refresh>(),
+		MakeIconPath<ToolbarIcons::Home>(),
+		MakeIconPath<ToolbarIcons::Bookmark>()
+	};
+
+	constexpr int ICON_SIZES[] = { 16, 20, 24, 32 };
+
+	struct Cubic {
+		Svg::Point p0, p1, p2, p3;
+
+		Svg::Point At(float t) const {
+			float u = 1 - t;
+			float a = u * u * u, b = 3 * u * u * t, c = 3 * u * t * t, d = t * t * t;
+			return { a * p0.x + b * p1.x + c * p2.x + d * p3.x, a * p0.y + b * p1.y + c * p2.y + d * p3.y };
+		}
+	};
+
+	// Device-space cubics of every toolbar icon at one pixel size
+	std::vector<Cubic> ToolbarCubics(int size) {
+		float scale = static_cast<float>(size) / 24.0f;
+		std::vector<Cubic> cubics;
+		for (const IconPath& icon : g_toolbarIcons) {
+			Svg::Point last = {};
+			for (int i = 0; i < icon.count; i++) {
+				Svg::Point point = { icon.points[i].x * scale, icon.points[i].y * scale };
+				if ((icon.types[i] & Svg::PointTypeMask) == Svg::PointTypeBezier && i + 2 < icon.count) {
+					Cubic cubic = { last, point,
+						{ icon.points[i + 1].x * scale, icon.points[i + 1].y * scale },
+						{ icon.points[i + 2].x * scale, icon.points[i + 2].y * scale } };
+					cubics.push_back(cubic);
+					last = cubic.p3;
+					i += 2;
+				}
+				else {
+					last = point;
+				}
+			}
+		}
+		return cubics;
+	}
+
+	float DistanceToSegment(Svg::Point p, Svg::Point a, Svg::Point b) {
+		float dx = b.x - a.x, dy = b.y - a.y;
+		float lengthSquared = dx * dx + dy * dy;
+		float t = lengthSquared > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSquared : 0;
+		t = t < 0 ? 0 : (t > 1 ? 1 : t);
+		return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+	}
+
+	// Largest distance from the curve to the polyline the flattener produced,
+	// sampled between each pair of polyline points
+	float FlattenError(const Cubic& cubic, float tolerance) {
+		float xs[IconFlatten::MAX_SEGMENTS];
+		float ys[IconFlatten::MAX_SEGMENTS];
+		int segments = IconFlatten::CubicSegmentCount(cubic.p0, cubic.p1, cubic.p2, cubic.p3, tolerance);
+		IconFlatten::EvaluateCubic(cubic.p0, cubic.p1, cubic.p2, cubic.p3, segments, xs, ys);
+
+		float error = 0;
+		Svg::Point from = cubic.p0;
+		for (int s = 0; s < segments; s++) {
+			Svg::Point to = { xs[s], ys[s] };
+			for (int k = 1; k < 16; k++) {
+				float t = (s + k / 16.0f) / segments;
+				error = std::fmax(error, DistanceToSegment(cubic.At(t), from, to));
+			}
+			from = to;
+		}
+		return error;
+	}
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+
+	UiMetrics metrics;
+	ChromePaint::Theme theme;
+	theme.background = 0xF3F3F3;
+	theme.accent = 0xD47800;
+	theme.text = 0x202020;
+	theme.border = 0xC8C8C8;
+	theme.activeTab = 0xFFFFFF;
+	theme.inactiveTab = 0xF3F3F3;
+	theme.icon = 0x404040;
+	theme.iconHover = 0xD47800;
+
+	std::vector<uint8_t> icon(static_cast<size_t>(metrics.iconSize) * metrics.iconSize, 160);
+	SoftwareCanvas::IconMaskSource icons = [&](int) { return icon.data(); };
+
+	BoxGlyphSource source;
+	GlyphAtlas atlas(source);
+	TextRunCache text(atlas, 256);
+
+	ToolbarModel toolbar;
+	for (int i = 0; i < 4; i++) {
+		toolbar.AddButton(1001 + i, { 4 + i * 36, 0, 4 + i * 36 + 32, metrics.toolbarHeight });
+	}
+	toolbar.SetHovered(1);
+
+	int height = metrics.toolbarHeight + metrics.tabHeight + metrics.urlBarHeight;
+	Bench::PrintHeader();
+	for (int width : { 800, 1280, 1920, 3840 }) {
+		for (int tabs : { 1, 10, 50, 200 }) {
+			std::vector<std::wstring> titles;
+			for (int i = 0; i < tabs; i++) {
+				titles.push_back(L"Tab " + std::to_wstring(i) + L" - Example Domain");
+			}
+
+			SoftwareCanvas canvas(width, height, metrics.iconSize, icons);
+			canvas.SetText(&text);
+			int tabWidth = width / tabs < metrics.maxTabTitleWidth ? width / tabs : metrics.maxTabTitleWidth;
+			if (tabWidth < 40) tabWidth = 40;  // The strip scrolls instead of shrinking further
+
+			char name[64];
+			snprintf(name, sizeof(name), "frame %dpx %d tabs", width, tabs);
+			size_t frameBytes = static_cast<size_t>(width) * height * 4;
+			Bench::Run(options, name, 1, frameBytes, [&](size_t) {
+				ChromePaint::Toolbar(canvas, toolbar, { 0, 0, width, metrics.toolbarHeight }, theme);
+
+				int top = metrics.toolbarHeight;
+				canvas.FillRect({ 0, top, width, top + metrics.tabHeight }, theme.background);
+				for (int i = 0; i < tabs && i * tabWidth < width; i++) {
+					ChromeRect rect = { i * tabWidth, top, (i + 1) * tabWidth, top + metrics.tabHeight };
+					ChromePaint::Tab(canvas, rect, titles[i], i == 0, theme, metrics);
+				}
+
+				top += metrics.tabHeight;
+				ChromeRect bar = { metrics.padding, top, width - metrics.padding, top + metrics.urlBarHeight };
+				ChromePaint::UrlBar(canvas, bar, L"https://www.example.com/some/long/path?query=1", theme, metrics);
+				Bench::Consume(canvas.Pixel(width / 2, height / 2));
+			});
+		}
+	}
+
+	// One item is one mouse move: hit test, hover update and damage flush.
+	// The pointer wanders over six buttons and sometimes leaves the bar.
+	ToolbarModel hoverModel;
+	for (int i = 0; i < 6; i++) {
+		hoverModel.AddButton(1001 + i, { 4 + i * 36, 4, 4 + i * 36 + 32, metrics.toolbarHeight - 4 });
+	}
+	std::vector<std::pair<int, int>> moves(8192);
+	std::mt19937 random(11);
+	int x = 0, y = metrics.toolbarHeight / 2;
+	for (auto& move : moves) {
+		x = std::clamp(x + static_cast<int>(random() % 25) - 12, -20, 240);
+		y = std::clamp(y + static_cast<int>(random() % 9) - 4, -10, metrics.toolbarHeight + 10);
+		move = { x, y };
+	}
+	size_t damaged = 0;
+	Bench::Run(options, "toolbar hover storm", moves.size(), 0, [&](size_t i) {
+		int hot = hoverModel.HitTest(moves[i].first, moves[i].second);
+		if (hoverModel.SetHovered(hot)) {
+			hoverModel.FlushDamage([&](const ToolbarRect&) { damaged++; });
+		}
+	});
+	Bench::Consume(damaged);
+	printf("  %llu hover changes, %llu damaged buttons\n",
+		static_cast<unsigned long long>(hoverModel.GetStats().hoverChanges),
+		static_cast<unsigned long long>(hoverModel.GetStats().damagedButtons));
+
+	// One item is one icon: edges through AddLine, then Resolve to a mask
+	IconRaster::CoverageRasterizer rasterizer;
+	for (int size : ICON_SIZES) {
+		std::vector<uint8_t> mask(static_cast<size_t>(size) * size);
+		float scale = static_cast<float>(size) / 24.0f;
+
+		char name[64];
+		snprintf(name, sizeof(name), "raster icons %dpx", size);
+		Bench::Run(options, name, std::size(g_toolbarIcons), mask.size() * std::size(g_toolbarIcons), [&](size_t i) {
+			rasterizer.Reset(size, size);
+			rasterizer.AddPath(g_toolbarIcons[i], scale, 0.0f, 0.0f);
+			rasterizer.Resolve(mask.data(), size);
+			Bench::Consume(mask[mask.size() / 2]);
+		});
+
+		// The same icons from geometry scaled once, as the toolbar draws them
+		std::vector<IconGeometry::ScaledIconPath> scaled(std::size(g_toolbarIcons));
+		for (size_t i = 0; i < scaled.size(); i++) {
+			IconGeometry::BuildScaledPath(g_toolbarIcons[i], IconGeometry::Transform::Scale(scale), scaled[i]);
+		}
+		snprintf(name, sizeof(name), "raster fixed icons %dpx", size);
+		Bench::Run(options, name, scaled.size(), mask.size() * scaled.size(), [&](size_t i) {
+			rasterizer.Reset(size, size);
+			rasterizer.AddFixedPath(scaled[i].xs.data(), scaled[i].ys.data(), scaled[i].types.data(),
+				scaled[i].Count(), IconGeometry::FIXED_SHIFT);
+			rasterizer.Resolve(mask.data(), size);
+			Bench::Consume(mask[mask.size() / 2]);
+		});
+	}
+
+	// One item is one icon scaled to every size: float points (AoS), as
+	// AddPath maps them, against int16 fixed-point x/y arrays (SoA)
+	size_t iconPoints = 0;
+	for (const IconPath& icon : g_toolbarIcons) iconPoints += icon.count;
+	std::vector<Svg::Point> floatPoints(iconPoints);
+	Bench::Run(options, "transform icons float AoS", std::size(g_toolbarIcons),
+		iconPoints * std::size(ICON_SIZES) * sizeof(Svg::Point), [&](size_t i) {
+		const IconPath& icon = g_toolbarIcons[i];
+		for (int size : ICON_SIZES) {
+			float scale = static_cast<float>(size) / 24.0f;
+			for (int p = 0; p < icon.count; p++) {
+				floatPoints[p] = { icon.points[p].x * scale, icon.points[p].y * scale };
+			}
+		}
+		Bench::Consume(static_cast<size_t>(floatPoints[icon.count - 1].x));
+	});
+
+	std::vector<int16_t> fixedXs(iconPoints), fixedYs(iconPoints);
+	Bench::Run(options, "transform icons fixed SoA", std::size(g_toolbarIcons),
+		iconPoints * std::size(ICON_SIZES) * sizeof(Svg::Point), [&](size_t i) {
+		const IconPath& icon = g_toolbarIcons[i];
+		for (int size : ICON_SIZES) {
+			IconGeometry::TransformPoints(icon.points, icon.count,
+				IconGeometry::Transform::Scale(static_cast<float>(size) / 24.0f), fixedXs.data(), fixedYs.data());
+		}
+		Bench::Consume(static_cast<size_t>(fixedXs[icon.count - 1]));
+	});
+
+	// One item is one cubic: segment count plus evaluation, as AddPath does
+	const float tolerance = IconFlatten::DEFAULT_TOLERANCE;
+	for (int size : ICON_SIZES) {
+		std::vector<Cubic> cubics = ToolbarCubics(size);
+		size_t segments = 0;
+		float error = 0;
+		for (const Cubic& cubic : cubics) {
+			segments += IconFlatten::CubicSegmentCount(cubic.p0, cubic.p1, cubic.p2, cubic.p3, tolerance);
+			error = std::fmax(error, FlattenError(cubic, tolerance));
+		}
+
+		char name[64];
+		snprintf(name, sizeof(name), "flatten icons %dpx", size);
+		double seconds = Bench::Run(options, name, cubics.size(), 0, [&](size_t i) {
+			const Cubic& cubic = cubics[i];
+			float xs[IconFlatten::MAX_SEGMENTS];
+			float ys[IconFlatten::MAX_SEGMENTS];
+			int count = IconFlatten::CubicSegmentCount(cubic.p0, cubic.p1, cubic.p2, cubic.p3, tolerance);
+			IconFlatten::EvaluateCubic(cubic.p0, cubic.p1, cubic.p2, cubic.p3, count, xs, ys);
+			Bench::Consume(static_cast<size_t>(xs[count - 1] + ys[count - 1]) + count);
+		});
+		printf("  %zu segments, %.1f M segments/s, max error %.4f px (tolerance %.4f)\n",
+			segments, seconds > 0 ? segments / seconds / 1e6 : 0.0, error, tolerance);
+	}
+	return 0;
+}
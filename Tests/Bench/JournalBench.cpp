@@ -0,0 +1,111 @@
+// Session journal of a 1,000-tab session as RestoreSession reads it: a
+// snapshot followed by records appended since, up to the 64 KB the writer
+// lets through before compacting. Times Replay of the snapshot alone and
+// with the records, Session::Decode of the same session, and framing
+// records as the writer thread does.
+
+#include "Bench.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Session.h"
+#include "SessionJournal.h"
+
+namespace {
+	constexpr int TAB_COUNT = 1000;
+	constexpr size_t COMPACT_AFTER = 64 * 1024;  // Writer default
+
+	Session::State MakeSession() {
+		Session::State state;
+		for (int i = 0; i < TAB_COUNT; i++) {
+			Session::Tab tab;
+			tab.url = L"https://example.com/articles/" + std::to_wstring(i * 7919 % 100000);
+			tab.title = L"Example article " + std::to_wstring(i) + L" - Example Domain";
+			tab.scrollY = i % 3 * 400;
+			state.tabs.push_back(std::move(tab));
+		}
+		state.active = TAB_COUNT / 2;
+		return state;
+	}
+
+	// Browsing on open tabs: mostly navigations with their titles and scrolls
+	std::vector<SessionJournal::Record> MakeRecords(size_t bytes) {
+		using SessionJournal::RecordType;
+		std::mt19937 random(7);
+		std::vector<SessionJournal::Record> records;
+		std::string framed;
+		while (framed.size() < bytes) {
+			SessionJournal::Record record;
+			record.tab = 1 + random() % TAB_COUNT;
+			switch (random() % 8) {
+			case 0: case 1: case 2:
+				record.type = RecordType::Navigated;
+				record.text = L"https://example.org/page/" + std::to_wstring(random() % 1000000);
+				break;
+			case 3: case 4:
+				record.type = RecordType::TitleChanged;
+				record.text = L"Page " + std::to_wstring(random() % 1000000) + L" - Example";
+				break;
+			case 5: case 6:
+				record.type = RecordType::Scrolled;
+				record.value = static_cast<int32_t>(random() % 20000);
+				break;
+			default:
+				record.type = RecordType::Activated;
+				break;
+			}
+			SessionJournal::AppendFrame(framed, record);
+			records.push_back(std::move(record));
+		}
+		return records;
+	}
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+	Bench::PrintHeader();
+
+	SessionJournal::Record snapshot;
+	snapshot.type = SessionJournal::RecordType::Snapshot;
+	snapshot.snapshot = MakeSession();
+	for (int i = 0; i < TAB_COUNT; i++) {
+		snapshot.snapshotIds.push_back(static_cast<uint32_t>(i + 1));
+	}
+
+	std::string snapshotOnly;
+	SessionJournal::AppendFrame(snapshotOnly, snapshot);
+	std::vector<SessionJournal::Record> records = MakeRecords(COMPACT_AFTER);
+	std::string journal = snapshotOnly;
+	for (const SessionJournal::Record& record : records) {
+		SessionJournal::AppendFrame(journal, record);
+	}
+
+	std::string session = Session::Encode(snapshot.snapshot);
+	Bench::Run(options, "Session::Decode 1000 tabs", 1, session.size(), [&](size_t) {
+		Session::State state;
+		Session::Decode(session, state);
+		Bench::Consume(state.tabs.size());
+	});
+
+	Bench::Run(options, "Replay snapshot", 1, snapshotOnly.size(), [&](size_t) {
+		SessionJournal::Model model;
+		Bench::Consume(SessionJournal::Replay(snapshotOnly, model));
+	});
+
+	char name[64];
+	snprintf(name, sizeof(name), "Replay snapshot+%zu records", records.size());
+	Bench::Run(options, name, 1, journal.size(), [&](size_t) {
+		SessionJournal::Model model;
+		Bench::Consume(SessionJournal::Replay(journal, model));
+	});
+
+	std::string frames;
+	Bench::Run(options, "AppendFrame", records.size(), journal.size() - snapshotOnly.size(), [&](size_t i) {
+		if (i == 0) frames.clear();
+		SessionJournal::AppendFrame(frames, records[i]);
+	});
+	Bench::Consume(frames.size());
+	return 0;
+}
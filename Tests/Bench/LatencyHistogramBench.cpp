@@ -0,0 +1,81 @@
+// LatencyHistogram::Record on its own, single-threaded and from several
+// threads into one histogram, as the paint and journal threads share
+// g_frameTimes. A single Record is shorter than the clock reads around it,
+// so items are batches of BATCH values and the cost of one Record is
+// reported from the throughput loop.
+
+#include "Bench.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "LatencyHistogram.h"
+
+namespace {
+	constexpr size_t BATCH = 1024;
+	constexpr int THREAD_COUNT = 4;
+
+	// Frame-time-like values: mostly 1-16 ms with a long tail
+	std::vector<uint64_t> RandomValues(size_t count, uint32_t seed) {
+		std::mt19937_64 random(seed);
+		std::lognormal_distribution<double> distribution(15.0, 0.8);
+		std::vector<uint64_t> values(count);
+		for (uint64_t& value : values) {
+			value = static_cast<uint64_t>(distribution(random));
+		}
+		return values;
+	}
+
+	void PrintPerRecord(double seconds, size_t records) {
+		printf("  %.2f ns per Record\n", records && seconds > 0 ? seconds * 1e9 / records : 0.0);
+	}
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+	Bench::PrintHeader();
+
+	std::vector<uint64_t> values = RandomValues(BATCH * 64, 1);
+	size_t batches = values.size() / BATCH;
+
+	LatencyHistogram histogram;
+	double seconds = Bench::Run(options, "Record batch", batches, 0, [&](size_t i) {
+		const uint64_t* batch = &values[i * BATCH];
+		for (size_t v = 0; v < BATCH; v++) histogram.Record(batch[v]);
+	});
+	PrintPerRecord(seconds, values.size());
+	Bench::Consume(histogram.Count());
+
+	// Same value every time: all increments hit one bucket
+	LatencyHistogram constant;
+	seconds = Bench::Run(options, "Record one bucket", batches, 0, [&](size_t) {
+		for (size_t v = 0; v < BATCH; v++) constant.Record(16000000);
+	});
+	PrintPerRecord(seconds, values.size());
+	Bench::Consume(constant.Count());
+
+	// Every item runs THREAD_COUNT threads that each record one batch
+	LatencyHistogram shared;
+	std::vector<std::vector<uint64_t>> threadValues;
+	for (int t = 0; t < THREAD_COUNT; t++) {
+		threadValues.push_back(RandomValues(BATCH * 16, 2 + t));
+	}
+	seconds = Bench::Run(options, "Record 4 threads", 1, 0, [&](size_t) {
+		std::vector<std::thread> threads;
+		for (int t = 0; t < THREAD_COUNT; t++) {
+			threads.emplace_back([&shared, &values = threadValues[t]] {
+				for (uint64_t value : values) shared.Record(value);
+			});
+		}
+		for (std::thread& thread : threads) thread.join();
+	});
+	PrintPerRecord(seconds, THREAD_COUNT * threadValues[0].size());
+	Bench::Consume(shared.Count());
+
+	Bench::Run(options, "Summarize", 1, 0, [&](size_t) {
+		Bench::Consume(histogram.Summarize().p99);
+	});
+	return 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cwchar>
+#include <cwctype>
+#include <vector>
+
+#include "SvgPath.h"
+
+// The runtime ParseSVGPath that Svg::ParsePath replaced, kept only so the
+// benchmark can compare the two. It understands M, L and Z and skips every
+// other character. GDI+ points and types are swapped for their portable
+// equivalents, and a Z before any point is ignored instead of indexing an
+// empty vector; otherwise it is unchanged.
+namespace LegacySvgPath {
+
+	struct IconPath {
+		std::vector<Svg::Point> points;
+		std::vector<uint8_t> types;
+	};
+
+	inline IconPath ParseSVGPath(const wchar_t* pathData) {
+		IconPath result;
+
+		// Simple SVG path parser for M, L, and Z commands
+		float currentX = 0, currentY = 0;
+		const wchar_t* p = pathData;
+
+		while (*p) {
+			while (iswspace(*p)) p++;
+
+			if (*p == 'M' || *p == 'm') {
+				bool relative = (*p == 'm');
+				p++;
+				float x = wcstof(p, const_cast<wchar_t**>(&p));
+				while (iswspace(*p) || *p == ',') p++;
+				float y = wcstof(p, const_cast<wchar_t**>(&p));
+
+				if (relative) {
+					x += currentX;
+					y += currentY;
+				}
+
+				result.points.push_back({ x, y });
+				result.types.push_back(Svg::PointTypeStart);
+				currentX = x;
+				currentY = y;
+			}
+			else if (*p == 'L' || *p == 'l') {
+				bool relative = (*p == 'l');
+				p++;
+				float x = wcstof(p, const_cast<wchar_t**>(&p));
+				while (iswspace(*p) || *p == ',') p++;
+				float y = wcstof(p, const_cast<wchar_t**>(&p));
+
+				if (relative) {
+					x += currentX;
+					y += currentY;
+				}
+
+				result.points.push_back({ x, y });
+				result.types.push_back(Svg::PointTypeLine);
+				currentX = x;
+				currentY = y;
+			}
+			else if (*p == 'Z' || *p == 'z') {
+				if (!result.types.empty()) {
+					result.types.back() |= Svg::PointTypeCloseSubpath;
+				}
+				p++;
+			}
+			else {
+				p++;
+			}
+		}
+
+		return result;
+	}
+}
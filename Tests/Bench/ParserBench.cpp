@@ -0,0 +1,159 @@
+// Throughput and per-call latency of the text parsers: numbers (against
+// strtof), SVG path data (against the runtime parser it replaced), the
+// symbol sheet indexer and URL bar resolution.
+
+#include "Bench.h"
+#include "Check.h"
+#include "LegacySvgPath.h"
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "NumberParser.h"
+#include "SvgPath.h"
+#include "SymbolSheet.h"
+#include "UrlInput.h"
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+	std::string svg = Check::ReadSourceFile("DingusBrowser/Icons.svg");
+	if (svg.empty()) {
+		fprintf(stderr, "Cannot read Icons.svg\n");
+		return 1;
+	}
+
+	// Every d attribute in the sheet, NUL terminated as ParsePath wants
+	std::vector<std::string> paths;
+	size_t pathBytes = 0;
+	for (size_t at = svg.find(" d=\""); at != std::string::npos; at = svg.find(" d=\"", at + 1)) {
+		size_t begin = at + 4;
+		paths.push_back(svg.substr(begin, svg.find('"', begin) - begin));
+		pathBytes += paths.back().size();
+	}
+
+	// The same paths as wide strings, which is what the old parser took
+	std::vector<std::wstring> widePaths;
+	for (const std::string& path : paths) {
+		widePaths.emplace_back(path.begin(), path.end());
+	}
+
+	// Numbers as they appear in path data and as printed with full precision
+	std::vector<std::string> numbers;
+	size_t numberBytes = 0;
+	std::mt19937 random(5);
+	for (int i = 0; i < 4096; i++) {
+		char text[32];
+		float value = static_cast<float>(random() % 100000) / 1000.0f - 50.0f;
+		snprintf(text, sizeof(text), i % 2 ? "%.9g" : "%g", value);
+		numbers.push_back(text);
+		numberBytes += numbers.back().size();
+	}
+
+	// A sheet of several thousand symbols: the real ones over and over
+	// under new ids, with comments between them as in Icons.svg
+	constexpr int LARGE_SHEET_SYMBOLS = 6000;
+	std::string largeSheet = "<svg xmlns=\"http://www.w3.org/2000/svg\" style=\"display: none;\">\n";
+	std::vector<std::string> largeIds;
+	for (int i = 0; i < LARGE_SHEET_SYMBOLS; i++) {
+		const std::string& path = paths[i % paths.size()];
+		largeIds.push_back("icon-" + std::to_string(i));
+		largeSheet += "  <!-- Icon " + std::to_string(i) + " -->\n  <symbol id=\"" + largeIds.back() +
+			"\" viewBox=\"0 0 24 24\">\n    <path d=\"" + path + "\"/>\n  </symbol>\n";
+	}
+	largeSheet += "</svg>\n";
+	std::vector<size_t> lookups(4096);
+	for (size_t& lookup : lookups) lookup = random() % LARGE_SHEET_SYMBOLS;
+
+	std::vector<std::wstring> typed = {
+		L"https://github.com/dingus/browser/pulls?q=is%3Aopen",
+		L"localhost:3000/dashboard",
+		L"C:\\Users\\dingus\\Documents\\notes.html",
+		L"example.com",
+		L"www.wikipedia.org",
+		L"  news.ycombinator.com  ",
+		L"how do treaps rebalance",
+		L"weather",
+	};
+	size_t typedBytes = 0;
+	for (const std::wstring& text : typed) typedBytes += text.size() * sizeof(wchar_t);
+
+	Bench::PrintHeader();
+
+	Bench::Run(options, "NumberParser::ParseFloat", numbers.size(), numberBytes, [&](size_t i) {
+		float value = 0;
+		NumberParser::ParseFloat(numbers[i].c_str(), value);
+		Bench::Consume(static_cast<size_t>(value));
+	});
+
+	Bench::Run(options, "strtof", numbers.size(), numberBytes, [&](size_t i) {
+		Bench::Consume(static_cast<size_t>(strtof(numbers[i].c_str(), nullptr)));
+	});
+
+	Bench::Run(options, "SvgPath measure+fill", paths.size(), pathBytes, [&](size_t i) {
+		Svg::Point points[512];
+		uint8_t types[512];
+		Svg::ParseResult measured = Svg::ParsePath(paths[i].c_str(), nullptr, nullptr, 0);
+		Svg::ParseResult filled = Svg::ParsePath(paths[i].c_str(), points, types, measured.count < 512 ? measured.count : 512);
+		Bench::Consume(filled.count);
+	});
+
+	Bench::Run(options, "SvgPath wide measure+fill", widePaths.size(), pathBytes, [&](size_t i) {
+		Svg::Point points[512];
+		uint8_t types[512];
+		Svg::ParseResult measured = Svg::ParsePath(widePaths[i].c_str(), nullptr, nullptr, 0);
+		Svg::ParseResult filled = Svg::ParsePath(widePaths[i].c_str(), points, types, measured.count < 512 ? measured.count : 512);
+		Bench::Consume(filled.count);
+	});
+
+	// Only understands M, L and Z, so it does less work on curves than the
+	// parser above and still gets them wrong
+	Bench::Run(options, "legacy ParseSVGPath", widePaths.size(), pathBytes, [&](size_t i) {
+		Bench::Consume(LegacySvgPath::ParseSVGPath(widePaths[i].c_str()).points.size());
+	});
+
+	Bench::Run(options, "SymbolSheet index", 1, svg.size(), [&](size_t) {
+		SymbolSheet sheet;
+		Bench::Consume(sheet.Index(svg.data(), svg.size()));
+	});
+
+	Bench::Run(options, "SymbolSheet index+load all", 1, svg.size(), [&](size_t) {
+		SymbolSheet sheet;
+		size_t count = sheet.Index(svg.data(), svg.size());
+		for (size_t i = 0; i < count; i++) {
+			const IconPath* path = sheet.GetPath(i);
+			Bench::Consume(path ? path->count : 0);
+		}
+	});
+
+	Bench::Run(options, "SymbolSheet index 6000", 1, largeSheet.size(), [&](size_t) {
+		SymbolSheet sheet;
+		Bench::Consume(sheet.Index(largeSheet.data(), largeSheet.size()));
+	});
+
+	// Startup: index everything, then load only what the toolbar shows
+	Bench::Run(options, "SymbolSheet 6000 load 6", 1, largeSheet.size(), [&](size_t) {
+		SymbolSheet sheet;
+		sheet.Index(largeSheet.data(), largeSheet.size());
+		for (int i = 0; i < 6; i++) {
+			const IconPath* path = sheet.GetPath(largeIds[i * 1000]);
+			Bench::Consume(path ? path->count : 0);
+		}
+	});
+
+	SymbolSheet large;
+	large.Index(largeSheet.data(), largeSheet.size());
+	Bench::Run(options, "SymbolSheet 6000 find", lookups.size(), 0, [&](size_t i) {
+		Bench::Consume(static_cast<size_t>(large.Find(largeIds[lookups[i]])));
+	});
+	Bench::Run(options, "SymbolSheet 6000 find+load", lookups.size(), 0, [&](size_t i) {
+		const IconPath* path = large.GetPath(largeIds[lookups[i]]);
+		Bench::Consume(path ? path->count : 0);
+	});
+
+	Bench::Run(options, "UrlInput resolve", typed.size(), typedBytes, [&](size_t i) {
+		Bench::Consume(UrlInput::Resolve(typed[i]).url.size());
+	});
+	return 0;
+}
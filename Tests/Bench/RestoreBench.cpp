@@ -0,0 +1,107 @@
+// Session restore with N = 10 to 10,000 saved tabs, driven the way
+// RestoreSession in main.cpp drives it: decode the session, add every tab
+// discarded to the slot map and tab strip, queue the prefetch, then acquire
+// the active tab's view from the pool. One item is one whole restore, timed
+// until the active view is ready. The fake engine creates views
+// synchronously, so the time is the restore's own work on the way to the
+// first view.
+//
+// The tab search index is left out of that path, as main.cpp builds it
+// when the search box first opens; its cost is the second row per size.
+
+#include "Bench.h"
+#include "FakeViewEngine.h"
+
+#include <string>
+#include <vector>
+
+#include "Session.h"
+#include "SlotMap.h"
+#include "TabSearchIndex.h"
+#include "TabStripModel.h"
+#include "ViewPool.h"
+
+namespace {
+	constexpr int RESTORE_PREFETCH_TABS = 2;  // As in main.cpp
+
+	struct Tab {
+		std::wstring url;
+		std::wstring title;
+		int scrollY = 0;
+		uint32_t journalId = 0;
+		int stripId = -1;
+		int view = 0;  // 0 while discarded
+	};
+
+	Session::State MakeSession(int tabCount) {
+		Session::State state;
+		for (int i = 0; i < tabCount; i++) {
+			Session::Tab tab;
+			tab.url = L"https://example.com/articles/" + std::to_wstring(i * 7919 % 100000);
+			tab.title = L"Example article " + std::to_wstring(i) + L" - Example Domain";
+			tab.scrollY = i % 3 * 400;
+			state.tabs.push_back(std::move(tab));
+		}
+		state.active = tabCount / 2;
+		return state;
+	}
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+	Bench::PrintHeader();
+
+	for (int tabCount : { 10, 100, 1000, 10000 }) {
+		std::string data = Session::Encode(MakeSession(tabCount));
+
+		char name[64];
+		snprintf(name, sizeof(name), "restore %d tabs", tabCount);
+		Bench::Run(options, name, 1, data.size(), [&](size_t) {
+			Session::State state;
+			if (!Session::Decode(data, state)) return;
+
+			SlotMap<Tab> tabs;
+			TabStripModel strip;
+			std::vector<SlotHandle> handles;
+			handles.reserve(state.tabs.size());
+			for (size_t i = 0; i < state.tabs.size(); i++) {
+				Session::Tab& saved = state.tabs[i];
+				Tab tab;
+				tab.url = std::move(saved.url);
+				tab.title = std::move(saved.title);
+				tab.scrollY = saved.scrollY;
+				tab.journalId = static_cast<uint32_t>(i + 1);
+				SlotHandle handle = tabs.Insert(std::move(tab));
+				Tab* inserted = tabs.Get(handle);
+				inserted->stripId = strip.Insert(strip.Count(), 120);
+				handles.push_back(handle);
+			}
+
+			int active = state.active >= 0 ? state.active : 0;
+			std::vector<SlotHandle> prefetch;
+			for (int position : Session::PrefetchOrder(static_cast<int>(handles.size()), active, RESTORE_PREFETCH_TABS)) {
+				prefetch.push_back(handles[position]);
+			}
+
+			FakeViewEngine engine;
+			engine.synchronous = true;
+			ViewPool<int> pool(engine, 1);
+			int view = 0;
+			pool.Acquire([&view](bool succeeded, int created) { view = succeeded ? created : -1; });
+			tabs.Get(handles[active])->view = view;
+			Bench::Consume(static_cast<size_t>(view) + prefetch.size());
+		});
+
+		Session::State state;
+		Session::Decode(data, state);
+		snprintf(name, sizeof(name), "index %d restored tabs", tabCount);
+		Bench::Run(options, name, 1, 0, [&](size_t) {
+			TabSearchIndex search;
+			for (size_t i = 0; i < state.tabs.size(); i++) {
+				search.Update(static_cast<uint32_t>(i + 1), state.tabs[i].title, state.tabs[i].url);
+			}
+			Bench::Consume(search.Size());
+		});
+	}
+	return 0;
+}
@@ -0,0 +1,93 @@
+// Tab bookkeeping with 10k open tabs: the slot map holding TabInfo and the
+// tab strip model holding positions, driven the way main.cpp drives them.
+
+#include "Bench.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SlotMap.h"
+#include "TabStripModel.h"
+
+namespace {
+	constexpr int TAB_COUNT = 10000;
+
+	struct Tab {
+		std::wstring url;
+		int stripId = -1;
+	};
+
+	struct Registry {
+		SlotMap<Tab> tabs;
+		TabStripModel strip;
+		std::vector<SlotHandle> stripTabs;  // By strip id
+
+		SlotHandle Open(int position) {
+			SlotHandle handle = tabs.Insert({ L"https://example.com/" });
+			int id = strip.Insert(position, 120);
+			if (static_cast<size_t>(id) >= stripTabs.size()) stripTabs.resize(id + 1);
+			stripTabs[id] = handle;
+			tabs.Get(handle)->stripId = id;
+			return handle;
+		}
+
+		void Close(SlotHandle handle) {
+			Tab* tab = tabs.Get(handle);
+			if (tab) {
+				strip.Erase(strip.Position(tab->stripId));
+				tabs.Erase(handle);
+			}
+		}
+	};
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+
+	Registry registry;
+	std::vector<SlotHandle> handles;
+	for (int i = 0; i < TAB_COUNT; i++) {
+		handles.push_back(registry.Open(i));
+	}
+
+	std::mt19937 random(1);
+	std::vector<size_t> order(TAB_COUNT);
+	for (size_t& i : order) i = random() % TAB_COUNT;
+
+	Bench::PrintHeader();
+	Bench::Run(options, "lookup by handle", TAB_COUNT, 0, [&](size_t i) {
+		Bench::Consume(registry.tabs.Get(handles[order[i]])->url.size());
+	});
+	Bench::Run(options, "lookup stale handle", TAB_COUNT, 0, [&](size_t i) {
+		SlotHandle stale = { handles[order[i]].index, handles[order[i]].generation + 1 };
+		Bench::Consume(registry.tabs.Get(stale) != nullptr);
+	});
+	Bench::Run(options, "position of tab", TAB_COUNT, 0, [&](size_t i) {
+		Bench::Consume(registry.strip.Position(registry.tabs.Get(handles[order[i]])->stripId));
+	});
+	Bench::Run(options, "tab at position", TAB_COUNT, 0, [&](size_t i) {
+		Bench::Consume(registry.stripTabs[registry.strip.IdAt(static_cast<int>(order[i]))].index);
+	});
+	Bench::Run(options, "hit test", TAB_COUNT, 0, [&](size_t i) {
+		Bench::Consume(registry.strip.HitTest(static_cast<int>(order[i]) * 120 + 7));
+	});
+	Bench::Run(options, "close and reopen", TAB_COUNT, 0, [&](size_t i) {
+		SlotHandle& handle = handles[order[i]];
+		Tab* tab = registry.tabs.Get(handle);
+		int position = registry.strip.Position(tab->stripId);
+		registry.Close(handle);
+		handle = registry.Open(position);
+	});
+
+	bool consistent = registry.tabs.Size() == TAB_COUNT && registry.strip.Count() == TAB_COUNT;
+	for (SlotHandle handle : handles) {
+		const Tab* tab = registry.tabs.Get(handle);
+		consistent = consistent && tab && registry.stripTabs[tab->stripId] == handle;
+	}
+	if (!consistent) {
+		fprintf(stderr, "tab registry out of sync\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,74 @@
+// Tab search over 10k synthetic tabs: building the index, keeping it
+// current as tabs navigate, and queries as they are typed a key at a time.
+
+#include "Bench.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TabSearchIndex.h"
+
+namespace {
+	constexpr int TAB_COUNT = 10000;
+
+	const wchar_t* const WORDS[] = {
+		L"Rust", L"compiler", L"GitHub", L"pull", L"request", L"news", L"weather", L"Berlin", L"recipe",
+		L"pasta", L"video", L"music", L"docs", L"Reference", L"Stack", L"Overflow", L"question", L"python",
+		L"release", L"notes", L"Wiki", L"Linux", L"kernel", L"Über", L"café", L"map"
+	};
+	const wchar_t* const HOSTS[] = {
+		L"github.com", L"news.ycombinator.com", L"en.wikipedia.org", L"stackoverflow.com", L"docs.rs", L"example.org"
+	};
+
+	struct Page {
+		std::wstring title;
+		std::wstring url;
+	};
+
+	Page RandomPage(std::mt19937& random) {
+		Page page;
+		int count = 2 + random() % 6;
+		for (int i = 0; i < count; i++) {
+			if (i) page.title += L' ';
+			page.title += WORDS[random() % std::size(WORDS)];
+		}
+		page.title += L" " + std::to_wstring(random() % 100000);
+		page.url = std::wstring(L"https://") + HOSTS[random() % std::size(HOSTS)] + L"/" + WORDS[random() % std::size(WORDS)] +
+			L"/" + std::to_wstring(random() % 1000000);
+		return page;
+	}
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+
+	std::mt19937 random(11);
+	std::vector<Page> pages;
+	size_t bytes = 0;
+	for (int i = 0; i < TAB_COUNT; i++) {
+		pages.push_back(RandomPage(random));
+		bytes += (pages.back().title.size() + pages.back().url.size()) * sizeof(wchar_t);
+	}
+
+	Bench::PrintHeader();
+	TabSearchIndex index;
+	Bench::Run(options, "update 10k tabs", TAB_COUNT, bytes, [&](size_t i) {
+		// Alternates each tab between two pages so every update changes the text
+		const Page& page = pages[(i + index.Stats().updates / TAB_COUNT) % TAB_COUNT];
+		index.Update(static_cast<uint32_t>(i), page.title, page.url);
+	});
+
+	const wchar_t* const typing[] = {
+		L"g", L"gi", L"git", L"gith", L"github", L"github p", L"github pull",
+		L"r", L"re", L"rec", L"recipe", L"recipe pasta", L"b", L"ber", L"berlin 4"
+	};
+	for (const wchar_t* query : typing) {
+		char name[64];
+		snprintf(name, sizeof(name), "search \"%ls\"", query);
+		Bench::Run(options, name, 1, 0, [&](size_t) {
+			Bench::Consume(index.Search(query, 20).size());
+		});
+	}
+	return 0;
+}
@@ -0,0 +1,74 @@
+// Time from ViewPool::Acquire to a ready view, with the pool cold (no warm
+// views, as WARM_CONTROLLERS = 0) and warm (WARM_CONTROLLERS = 1).
+//
+// The engine is the step-driven fake from the tests, one Step per
+// simulated millisecond. Creating a view takes 60-250 ms. Tabs open a
+// second or two apart, with occasional bursts of several at once, and the
+// acquire-to-ready times are percentiles of simulated time, not of how
+// long the pool code itself runs. That is timed separately below.
+
+#include "Bench.h"
+#include "FakeViewEngine.h"
+
+#include <random>
+
+#include "LatencyHistogram.h"
+#include "ViewPool.h"
+
+namespace {
+	constexpr uint64_t NS_PER_STEP = 1000000;
+
+	void RunScenario(const char* name, int warmCount, int acquires) {
+		FakeViewEngine engine;
+		ViewPool<int> pool(engine, warmCount);
+		pool.Refill();
+
+		std::mt19937 random(3);
+		std::uniform_int_distribution<int> latency(60, 250);
+		std::exponential_distribution<double> gap(1.0 / 1500.0);
+		LatencyHistogram readyTimes;
+
+		for (int i = 0; i < acquires; i++) {
+			// One in five tabs opens together with the previous one
+			int wait = random() % 5 == 0 ? static_cast<int>(random() % 20) : static_cast<int>(gap(random));
+			engine.Step(wait);
+
+			engine.latency = latency(random);
+			int start = engine.Now();
+			pool.Acquire([&readyTimes, &engine, start](bool succeeded, int view) {
+				if (succeeded) {
+					readyTimes.Record(static_cast<uint64_t>(engine.Now() - start) * NS_PER_STEP);
+					engine.DestroyView(view);
+				}
+			});
+		}
+		engine.Step(1000);
+
+		LatencyHistogram::Summary summary = readyTimes.Summarize();
+		printf("%-28s %10d %10llu %9.1f %9.1f %9.1f\n", name, acquires,
+			static_cast<unsigned long long>(pool.Stats().warmHits),
+			summary.p50 / 1e6, summary.p90 / 1e6, summary.p99 / 1e6);
+	}
+}
+
+int main(int argc, char** argv) {
+	Bench::Options options = Bench::ParseOptions(argc, argv);
+	int acquires = options.repeat * 50;
+
+	printf("%-28s %10s %10s %9s %9s %9s\n", "acquire to ready", "acquires", "warm hits", "p50 ms", "p90 ms", "p99 ms");
+	RunScenario("cold (WARM_CONTROLLERS 0)", 0, acquires);
+	RunScenario("warm (WARM_CONTROLLERS 1)", 1, acquires);
+	printf("\n");
+
+	// The pool's own cost per Acquire, with views created synchronously
+	FakeViewEngine engine;
+	engine.synchronous = true;
+	ViewPool<int> pool(engine, 1);
+	pool.Refill();
+	Bench::PrintHeader();
+	Bench::Run(options, "Acquire warm, synchronous", 1000, 0, [&](size_t) {
+		pool.Acquire([&](bool, int view) { engine.DestroyView(view); });
+	});
+	Bench::Consume(static_cast<size_t>(engine.live));
+	return 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GlyphAtlas.h"
+
+// Stand-in for the GDI glyph source: every glyph is a solid box, so text
+// can be laid out, cached and drawn without a font.
+class BoxGlyphSource : public GlyphSource {
+public:
+	static constexpr int ADVANCE = 7;
+	static constexpr int SPACE_ADVANCE = 4;
+
+	// Code point the font can't draw, to exercise the fallback paths
+	static constexpr uint32_t MISSING = 0x05D0;
+
+	int Ascent() const override { return 10; }
+	int LineHeight() const override { return 14; }
+
+	bool RenderGlyph(uint32_t codePoint, GlyphMetrics& metrics, std::vector<uint8_t>& coverage) override {
+		rendered++;
+		if (codePoint == MISSING) {
+			return false;
+		}
+		metrics = GlyphMetrics();
+		if (codePoint == ' ') {
+			metrics.advance = SPACE_ADVANCE;
+			return true;
+		}
+		metrics.advance = ADVANCE;
+		metrics.left = 1;
+		metrics.top = 8;
+		metrics.width = 5;
+		metrics.height = 8;
+		coverage.assign(static_cast<size_t>(metrics.width) * metrics.height, 255);
+		return true;
+	}
+
+	int rendered = 0;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Minimal test harness for the portable modules.
+//
+// Each test file builds into its own executable. TEST_CASE registers a
+// function, CHECK reports a failed expression and carries on, and TestMain
+// runs every case (or only those named on the command line) and exits
+// non-zero if any check failed.
+namespace Check {
+
+	using CaseFunction = void (*)();
+
+	struct Case {
+		const char* name;
+		CaseFunction run;
+	};
+
+	inline std::vector<Case>& Cases() {
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	inline int& Failures() {
+		static int failures = 0;
+		return failures;
+	}
+
+	struct Registration {
+		Registration(const char* name, CaseFunction run) {
+			Cases().push_back({ name, run });
+		}
+	};
+
+	inline void Fail(const char* file, int line, const char* expression) {
+		fprintf(stderr, "%s(%d): CHECK(%s) failed\n", file, line, expression);
+		Failures()++;
+	}
+
+	// Reads a file from the source tree, e.g. "DingusBrowser/Icons.svg".
+	// Empty if it can't be read.
+	inline std::string ReadSourceFile(const char* relativePath) {
+		std::string path = std::string(DINGUS_SOURCE_DIR) + "/" + relativePath;
+		std::string data;
+		if (FILE* file = fopen(path.c_str(), "rb")) {
+			char buffer[4096];
+			size_t read;
+			while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+				data.append(buffer, read);
+			}
+			fclose(file);
+		}
+		return data;
+	}
+}
+
+#define TEST_CASE(name) \
+	static void name(); \
+	static Check::Registration name##Registration(#name, name); \
+	static void name()
+
+#define CHECK(expression) ((expression) ? void() : Check::Fail(__FILE__, __LINE__, #expression))
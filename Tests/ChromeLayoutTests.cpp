@@ -0,0 +1,58 @@
+#include "Check.h"
+
+#include "ChromeLayout.h"
+
+namespace {
+
+	bool Is(const ChromeRect& rect, int left, int top, int right, int bottom) {
+		return rect.left == left && rect.top == top && rect.right == right && rect.bottom == bottom;
+	}
+}
+
+TEST_CASE(BrowserChrome) {
+	// Shaped like the browser's toolbar, tabs, URL bar and content bands
+	ChromeLayout::Band bands[] = {
+		{ 30 },
+		{ 30, 8, 0, 8, 0 },
+		{ 30, 8, 4, 8, 0 },
+		{ ChromeLayout::FILL, 8, 4, 8, 8 },
+	};
+	ChromeRect rects[4];
+	ChromeLayout::Solve(bands, 4, 1024, 768, rects);
+	CHECK(Is(rects[0], 0, 0, 1024, 30));
+	CHECK(Is(rects[1], 8, 30, 1016, 60));
+	CHECK(Is(rects[2], 8, 64, 1016, 94));
+	CHECK(Is(rects[3], 8, 98, 1016, 760));
+}
+
+TEST_CASE(FillBandsShareLeftover) {
+	ChromeLayout::Band bands[] = {
+		{ ChromeLayout::FILL },
+		{ 10 },
+		{ ChromeLayout::FILL },
+		{ ChromeLayout::FILL },
+	};
+	ChromeRect rects[4];
+	ChromeLayout::Solve(bands, 4, 100, 111, rects);  // 101 left for three
+	CHECK(rects[0].Height() == 34 && rects[2].Height() == 34 && rects[3].Height() == 33);
+	CHECK(rects[3].bottom == 111);
+	CHECK(rects[1].top == 34 && rects[2].top == 44);
+}
+
+TEST_CASE(TooSmallClampsToEmpty) {
+	ChromeLayout::Band bands[] = {
+		{ 30, 20, 0, 20, 0 },
+		{ 30 },
+		{ ChromeLayout::FILL, 0, 5, 0, 5 },
+	};
+	ChromeRect rects[3];
+	ChromeLayout::Solve(bands, 3, 30, 40, rects);
+	CHECK(Is(rects[0], 20, 0, 20, 30));  // Margins wider than the window
+	CHECK(Is(rects[1], 0, 30, 30, 40));   // Cut at the bottom
+	CHECK(rects[2].Height() == 0 && rects[2].top == 40);
+
+	ChromeLayout::Solve(bands, 3, 0, 0, rects);
+	for (const ChromeRect& rect : rects) {
+		CHECK(rect.Width() >= 0 && rect.Height() == 0);
+	}
+}
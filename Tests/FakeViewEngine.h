@@ -0,0 +1,67 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "ViewPool.h"
+
+// Stand-in for the WebView2 controller engine, driven by hand. Completes
+// creations after a fixed number of Step calls, or at once when
+// synchronous. Views are numbered from 1.
+class FakeViewEngine : public ViewEngine<int> {
+public:
+	int latency = 5;
+	bool synchronous = false;
+	bool failing = false;
+	int live = 0;  // Created and not destroyed
+
+	void CreateView(Ready ready) override {
+		if (synchronous) {
+			Complete(ready);
+			return;
+		}
+		m_jobs.push_back({ m_now + latency, std::move(ready) });
+	}
+
+	void DestroyView(int) override { live--; }
+
+	void Step(int count = 1) {
+		for (int i = 0; i < count; i++) {
+			m_now++;
+			std::vector<Job> due;
+			for (size_t j = 0; j < m_jobs.size();) {
+				if (m_jobs[j].due <= m_now) {
+					due.push_back(std::move(m_jobs[j]));
+					m_jobs.erase(m_jobs.begin() + j);
+				}
+				else {
+					j++;
+				}
+			}
+			for (Job& job : due) {
+				Complete(job.ready);
+			}
+		}
+	}
+
+	int Now() const { return m_now; }
+
+private:
+	struct Job {
+		int due;
+		Ready ready;
+	};
+
+	void Complete(Ready& ready) {
+		if (failing) {
+			ready(false, 0);
+			return;
+		}
+		live++;
+		ready(true, m_next++);
+	}
+
+	std::vector<Job> m_jobs;
+	int m_now = 0;
+	int m_next = 1;
+};
@@ -0,0 +1,75 @@
+#include "Check.h"
+
+#include "FramePacer.h"
+
+namespace {
+	constexpr uint64_t FRAME = 16667;
+}
+
+TEST_CASE(FirstRequestIsDueImmediately) {
+	uint64_t now = 1000;
+	FramePacer pacer([&] { return now; }, FRAME);
+	CHECK(pacer.TimeUntilDue() == FramePacer::NOT_PENDING);
+	CHECK(pacer.TakeDue() == 0);
+
+	pacer.Request(1);
+	CHECK(pacer.TimeUntilDue() == 0);
+	CHECK(pacer.TakeDue() == 1);
+	CHECK(pacer.Pending() == 0 && pacer.TimeUntilDue() == FramePacer::NOT_PENDING);
+
+	// After an idle stretch the next request runs right away too
+	now += 5 * FRAME;
+	pacer.Request(4);
+	CHECK(pacer.TakeDue() == 4);
+}
+
+TEST_CASE(RequestsWithinAFrameCoalesce) {
+	uint64_t now = 1000;
+	FramePacer pacer([&] { return now; }, FRAME);
+	pacer.Request(1);
+	pacer.TakeDue();
+
+	now += 5000;
+	pacer.Request(1);
+	pacer.Request(2);
+	CHECK(pacer.TimeUntilDue() == FRAME - 5000);
+	CHECK(pacer.TakeDue() == 0 && pacer.Pending() == 3);
+
+	now += FRAME - 5000;
+	CHECK(pacer.TakeDue() == 3);
+	CHECK(pacer.Stats().requests == 3 && pacer.Stats().frames == 2);
+}
+
+TEST_CASE(DragRunsOncePerFrame) {
+	// A WM_SIZE every millisecond for 100 ms runs at most once per frame
+	uint64_t now = 0;
+	FramePacer pacer([&] { return now; }, FRAME);
+	int runs = 0;
+	for (int i = 0; i < 100; i++) {
+		now += 1000;
+		pacer.Request(1);
+		if (pacer.TakeDue()) runs++;
+	}
+	CHECK(runs >= 5 && runs <= 7);
+
+	// The final size is applied exactly by a flush
+	CHECK(pacer.Pending() == 1);
+	CHECK(pacer.Flush() == 1);
+	CHECK(pacer.Flush() == 0);
+	CHECK(pacer.Stats().flushes == 2 && pacer.Stats().frames == static_cast<uint64_t>(runs) + 1);
+}
+
+TEST_CASE(IntervalFollowsRefreshRate) {
+	uint64_t now = 0;
+	FramePacer pacer([&] { return now; }, FRAME);
+	pacer.Request(1);
+	pacer.TakeDue();
+
+	pacer.SetFrameInterval(6944);  // 144 Hz
+	CHECK(pacer.FrameInterval() == 6944);
+	now += 4000;
+	pacer.Request(1);
+	CHECK(pacer.TimeUntilDue() == 2944);
+	now += 2944;
+	CHECK(pacer.TakeDue() == 1);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Fuzz targets use the libFuzzer entry point, so each one builds either
+// against libFuzzer (DINGUS_LIBFUZZER, Clang) or against FuzzDriver.cpp,
+// which replays a corpus and mutates it for a fixed number of runs.
+// A broken invariant aborts, which both report as a crash.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+#define FUZZ_CHECK(expression) \
+	((expression) ? void() : (fprintf(stderr, "%s(%d): FUZZ_CHECK(%s) failed\n", __FILE__, __LINE__, #expression), abort()))
@@ -0,0 +1,133 @@
+// Stand-in for libFuzzer where it isn't available (GCC, MSVC).
+//
+// Usage: FuzzTarget [-runs=N] [-seed=N] [-max_len=N] [file or directory...]
+//
+// Runs every corpus input once, then runs N inputs made by mutating random
+// corpus entries. Not coverage guided, but deterministic for a given seed,
+// which is what a ctest smoke run wants. The flags match libFuzzer's.
+
+#include "Fuzz.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+	using Input = std::vector<uint8_t>;
+
+	bool ReadInput(const std::filesystem::path& path, std::vector<Input>& corpus) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+		corpus.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	void Mutate(Input& input, const std::vector<Input>& corpus, std::mt19937_64& random, size_t maxLength) {
+		int mutations = 1 + static_cast<int>(random() % 4);
+		for (int m = 0; m < mutations; m++) {
+			size_t size = input.size();
+			switch (random() % 7) {
+			case 0:  // Flip a bit
+				if (size) input[random() % size] ^= static_cast<uint8_t>(1 << (random() % 8));
+				break;
+			case 1:  // Random byte
+				if (size) input[random() % size] = static_cast<uint8_t>(random());
+				break;
+			case 2:  // Insert a byte seen elsewhere in the corpus, so tokens stay plausible
+				if (const Input& other = corpus[random() % corpus.size()]; !other.empty()) {
+					input.insert(input.begin() + static_cast<ptrdiff_t>(random() % (size + 1)), other[random() % other.size()]);
+				}
+				break;
+			case 3:  // Erase a range
+				if (size) {
+					size_t begin = random() % size;
+					size_t end = begin + 1 + random() % (size - begin);
+					input.erase(input.begin() + static_cast<ptrdiff_t>(begin), input.begin() + static_cast<ptrdiff_t>(end));
+				}
+				break;
+			case 4:  // Duplicate a range
+				if (size) {
+					size_t begin = random() % size;
+					size_t length = 1 + random() % (size - begin);
+					Input copy(input.begin() + static_cast<ptrdiff_t>(begin), input.begin() + static_cast<ptrdiff_t>(begin + length));
+					input.insert(input.begin() + static_cast<ptrdiff_t>(random() % (size + 1)), copy.begin(), copy.end());
+				}
+				break;
+			case 5:  // Splice in part of another input
+				if (const Input& other = corpus[random() % corpus.size()]; !other.empty()) {
+					size_t begin = random() % other.size();
+					size_t length = 1 + random() % (other.size() - begin);
+					input.insert(input.begin() + static_cast<ptrdiff_t>(random() % (size + 1)),
+						other.begin() + static_cast<ptrdiff_t>(begin), other.begin() + static_cast<ptrdiff_t>(begin + length));
+				}
+				break;
+			case 6:  // Truncate
+				if (size) input.resize(random() % size);
+				break;
+			}
+		}
+		if (input.size() > maxLength) {
+			input.resize(maxLength);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	long long runs = 10000;
+	unsigned long long seed = 1;
+	size_t maxLength = 4096;
+	std::vector<Input> corpus;
+
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		if (strncmp(arg, "-runs=", 6) == 0) {
+			runs = atoll(arg + 6);
+		}
+		else if (strncmp(arg, "-seed=", 6) == 0) {
+			seed = strtoull(arg + 6, nullptr, 10);
+		}
+		else if (strncmp(arg, "-max_len=", 9) == 0) {
+			maxLength = static_cast<size_t>(atoll(arg + 9));
+		}
+		else if (arg[0] == '-') {
+			fprintf(stderr, "Ignoring unsupported flag %s\n", arg);
+		}
+		else if (std::filesystem::is_directory(arg)) {
+			for (const auto& entry : std::filesystem::directory_iterator(arg)) {
+				if (entry.is_regular_file()) ReadInput(entry.path(), corpus);
+			}
+		}
+		else if (!ReadInput(arg, corpus)) {
+			fprintf(stderr, "Cannot read %s\n", arg);
+			return 1;
+		}
+	}
+
+	for (const Input& input : corpus) {
+		LLVMFuzzerTestOneInput(input.data(), input.size());
+	}
+	if (corpus.empty()) {
+		corpus.emplace_back();
+	}
+
+	std::mt19937_64 random(seed);
+	Input input;
+	for (long long run = 0; run < runs; run++) {
+		input = corpus[random() % corpus.size()];
+		Mutate(input, corpus, random, maxLength);
+		// Exact-size copy, so the sanitizer build catches reads past the end
+		std::unique_ptr<uint8_t[]> exact(new uint8_t[input.size()]);
+		if (!input.empty()) memcpy(exact.get(), input.data(), input.size());
+		LLVMFuzzerTestOneInput(exact.get(), input.size());
+	}
+
+	printf("%zu corpus inputs, %lld mutated runs\n", corpus.size(), runs);
+	return 0;
+}
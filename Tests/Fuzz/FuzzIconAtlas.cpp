@@ -0,0 +1,39 @@
+// A damaged or hostile atlas file is either rejected by Attach or safe to
+// search and blit from: every entry's mask lies inside the file and Find
+// returns each entry it holds.
+
+#include "Fuzz.h"
+
+#include <cstring>
+#include <memory>
+
+#include "IconAtlas.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	// The browser maps the file, so the entry table is always aligned
+	std::unique_ptr<uint32_t[]> aligned(new uint32_t[size / 4 + 1]);
+	if (size) memcpy(aligned.get(), data, size);
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(aligned.get());
+
+	IconAtlas::View view;
+	if (!view.Attach(bytes, size)) {
+		FUZZ_CHECK(!view.IsValid() && view.Count() == 0);
+		return 0;
+	}
+
+	unsigned sum = 0;
+	for (size_t i = 0; i < view.Count(); i++) {
+		const IconAtlas::Entry& entry = view.At(i);
+		size_t maskBytes = static_cast<size_t>(entry.size) * entry.size;
+		const uint8_t* pixels = view.Pixels(entry);
+		FUZZ_CHECK(pixels >= bytes && pixels + maskBytes <= bytes + size);
+		for (size_t p = 0; p < maskBytes; p++) sum += pixels[p];
+
+		char name[IconAtlas::NAME_LENGTH + 1] = {};
+		memcpy(name, entry.name, IconAtlas::NAME_LENGTH);
+		FUZZ_CHECK(view.Find(name, entry.dpi) == &entry);
+	}
+	volatile unsigned sink = sum;
+	(void)sink;
+	return 0;
+}
@@ -0,0 +1,21 @@
+// Replaying arbitrary bytes stays inside the input, keeps the model
+// consistent, and stops at the same place when given only the intact prefix.
+
+#include "Fuzz.h"
+
+#include <string>
+
+#include "SessionJournal.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	std::string_view input(reinterpret_cast<const char*>(data), size);
+	SessionJournal::Model model;
+	size_t valid = SessionJournal::Replay(input, model);
+	FUZZ_CHECK(valid <= size);
+	FUZZ_CHECK(model.ids.size() == model.state.tabs.size());
+
+	SessionJournal::Model again;
+	FUZZ_CHECK(SessionJournal::Replay(input.substr(0, valid), again) == valid);
+	FUZZ_CHECK(again.ids == model.ids && again.state.active == model.state.active);
+	return 0;
+}
@@ -0,0 +1,41 @@
+// Differential check against the C library: for any input made of number
+// characters, NumberParser must consume exactly what strtof does and give
+// the same bits. Other bytes end the input, since strtof also takes hex,
+// "inf" and leading whitespace, which NumberParser deliberately does not.
+
+#include "Fuzz.h"
+
+#include <cstring>
+#include <string>
+
+#include "NumberParser.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	std::string text;
+	for (size_t i = 0; i < size && strchr("0123456789.eE+-", data[i]) && data[i]; i++) {
+		text.push_back(static_cast<char>(data[i]));
+	}
+
+	float ours = 0;
+	const char* end = NumberParser::ParseFloat(text.c_str(), ours);
+	char* theirEnd = nullptr;
+	float theirs = strtof(text.c_str(), &theirEnd);
+	if (!end) {
+		FUZZ_CHECK(theirEnd == text.c_str());
+		return 0;
+	}
+	FUZZ_CHECK(end == theirEnd);
+	FUZZ_CHECK(memcmp(&ours, &theirs, sizeof(float)) == 0);
+
+	// A bounded parse of the same characters agrees with the terminated one
+	float bounded = 0;
+	const char* boundedEnd = NumberParser::ParseFloat(text.data(), text.data() + text.size(), bounded);
+	FUZZ_CHECK(boundedEnd == end && memcmp(&bounded, &ours, sizeof(float)) == 0);
+
+	// UTF-16 input gives the same result
+	std::u16string wide(text.begin(), text.end());
+	float fromWide = 0;
+	const char16_t* wideEnd = NumberParser::ParseFloat(wide.c_str(), fromWide);
+	FUZZ_CHECK(wideEnd == wide.c_str() + (end - text.c_str()) && memcmp(&fromWide, &ours, sizeof(float)) == 0);
+	return 0;
+}
@@ -0,0 +1,31 @@
+// Decoding arbitrary bytes never reads past the input, and whatever decodes
+// encodes back to the same size and decodes to the same session.
+
+#include "Fuzz.h"
+
+#include <string>
+
+#include "Session.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	std::string_view input(reinterpret_cast<const char*>(data), size);
+	Session::State state;
+	if (!Session::Decode(input, state)) {
+		FUZZ_CHECK(state.tabs.empty() && state.active == -1);
+		return 0;
+	}
+	FUZZ_CHECK(state.tabs.empty() ? state.active == -1 : state.active >= 0 && state.active < static_cast<int32_t>(state.tabs.size()));
+
+	std::string encoded = Session::Encode(state);
+	FUZZ_CHECK(encoded.size() == size);
+	FUZZ_CHECK(encoded.compare(16, std::string::npos, input.substr(16)) == 0);
+
+	Session::State again;
+	FUZZ_CHECK(Session::Decode(encoded, again));
+	FUZZ_CHECK(again.active == state.active && again.tabs.size() == state.tabs.size());
+	for (size_t i = 0; i < state.tabs.size(); i++) {
+		FUZZ_CHECK(again.tabs[i].url == state.tabs[i].url && again.tabs[i].title == state.tabs[i].title);
+		FUZZ_CHECK(again.tabs[i].scrollY == state.tabs[i].scrollY);
+	}
+	return 0;
+}
@@ -0,0 +1,43 @@
+// Path data from Icons.svg or anywhere else must parse without reading past
+// the input, and the measuring pass must agree with the filling pass.
+
+#include "Fuzz.h"
+
+#include <cmath>
+#include <vector>
+
+#include "SvgPath.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	// ParsePath reads up to the terminator, so work on a terminated copy
+	std::vector<char> text(data, data + size);
+	text.push_back('\0');
+
+	Svg::ParseResult measured = Svg::ParsePath(text.data(), nullptr, nullptr, 0);
+	FUZZ_CHECK(measured.ok || measured.errorOffset <= size);
+
+	std::vector<Svg::Point> points(measured.count);
+	std::vector<uint8_t> types(measured.count);
+	Svg::ParseResult filled = Svg::ParsePath(text.data(), points.data(), types.data(), measured.count);
+	FUZZ_CHECK(filled.ok == measured.ok && filled.count == measured.count && !filled.truncated);
+
+	for (size_t i = 0; i < filled.count; i++) {
+		FUZZ_CHECK(std::isfinite(points[i].x) && std::isfinite(points[i].y));
+	}
+	if (filled.count > 0) {
+		FUZZ_CHECK((types[0] & Svg::PointTypeMask) == Svg::PointTypeStart);
+	}
+
+	// A short buffer gets the same prefix and still reports the full count
+	if (measured.count > 1) {
+		size_t half = measured.count / 2;
+		std::vector<Svg::Point> prefix(half);
+		std::vector<uint8_t> prefixTypes(half);
+		Svg::ParseResult truncated = Svg::ParsePath(text.data(), prefix.data(), prefixTypes.data(), half);
+		FUZZ_CHECK(truncated.truncated && truncated.count == measured.count);
+		for (size_t i = 0; i < half; i++) {
+			FUZZ_CHECK(prefix[i].x == points[i].x && prefix[i].y == points[i].y && prefixTypes[i] == types[i]);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,35 @@
+// Indexing arbitrary markup stays inside the buffer, and every symbol it
+// finds can be looked up and loaded. Geometry may be non-finite for extreme
+// viewBoxes; the rasterizer drops such edges.
+
+#include "Fuzz.h"
+
+#include <cstring>
+#include <memory>
+
+#include "SymbolSheet.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	// Exact-size copy with no terminator; the indexer must honour size
+	std::unique_ptr<char[]> text(new char[size ? size : 1]);
+	if (size) memcpy(text.get(), data, size);
+
+	SymbolSheet sheet;
+	size_t count = sheet.Index(text.get(), size);
+	FUZZ_CHECK(count == sheet.Count());
+
+	for (size_t i = 0; i < count; i++) {
+		const SheetSymbol& symbol = sheet.At(i);
+		if (!symbol.id.empty()) {
+			FUZZ_CHECK(symbol.id.data() >= text.get() && symbol.id.data() + symbol.id.size() <= text.get() + size);
+			int found = sheet.Find(symbol.id);
+			FUZZ_CHECK(found >= 0 && found <= static_cast<int>(i) && sheet.At(found).id == symbol.id);
+		}
+
+		if (const IconPath* path = sheet.GetPath(i)) {
+			FUZZ_CHECK(path->count > 0 && (path->types[0] & Svg::PointTypeMask) == Svg::PointTypeStart);
+			FUZZ_CHECK(sheet.GetPath(i) == path);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,43 @@
+// Anything typed into the URL bar resolves to something navigable: the typed
+// text survives intact in the result and the scheme matches the kind.
+
+#include "Fuzz.h"
+
+#include <string>
+
+#include "UrlInput.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	// Two bytes per character, like the UTF-16 text the edit control returns
+	std::wstring text;
+	for (size_t i = 0; i + 1 < size; i += 2) {
+		text.push_back(static_cast<wchar_t>(data[i] | (data[i + 1] << 8)));
+	}
+
+	UrlInput::Resolved resolved = UrlInput::Resolve(text);
+	std::wstring_view url = resolved.url;
+	switch (resolved.kind) {
+	case UrlInput::Kind::Url:
+		FUZZ_CHECK(url == text);
+		break;
+	case UrlInput::Kind::Local:
+		FUZZ_CHECK(url.substr(0, 7) == L"http://" && url.substr(7) == text);
+		break;
+	case UrlInput::Kind::File:
+		FUZZ_CHECK(url.substr(0, 8) == L"file:///" && url.substr(8) == text);
+		break;
+	case UrlInput::Kind::Web: {
+		// Host names lose surrounding spaces and tabs and may gain www.
+		size_t begin = text.find_first_not_of(L" \t");
+		FUZZ_CHECK(begin != std::wstring::npos);
+		std::wstring host = text.substr(begin, text.find_last_not_of(L" \t") + 1 - begin);
+		FUZZ_CHECK(host.find(L'.') != std::wstring::npos);
+		FUZZ_CHECK(url == L"https://" + host || url == L"https://www." + host);
+		break;
+	}
+	case UrlInput::Kind::Search:
+		FUZZ_CHECK(url == L"https://www.google.com/search?q=" + text);
+		break;
+	}
+	return 0;
+}
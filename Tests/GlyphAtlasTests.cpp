@@ -0,0 +1,120 @@
+#include "Check.h"
+
+#include <string>
+
+#include "BoxGlyphSource.h"
+#include "GlyphAtlas.h"
+#include "TextRunCache.h"
+
+TEST_CASE(GlyphsAreRenderedOnce) {
+	BoxGlyphSource source;
+	GlyphAtlas atlas(source, 64, 64);
+	const AtlasGlyph* a = atlas.Get('a');
+	CHECK(a && a->metrics.width == 5 && a->metrics.advance == BoxGlyphSource::ADVANCE);
+	CHECK(atlas.Get('a') == a);
+	CHECK(source.rendered == 1);
+	CHECK(atlas.Stats().hits == 1 && atlas.Stats().misses == 1);
+
+	// Glyphs the font lacks are remembered too
+	CHECK(!atlas.Get(BoxGlyphSource::MISSING) && !atlas.Get(BoxGlyphSource::MISSING));
+	CHECK(source.rendered == 2);
+
+	// Blank glyphs take no atlas space
+	const AtlasGlyph* space = atlas.Get(' ');
+	CHECK(space && space->metrics.width == 0 && space->metrics.advance == BoxGlyphSource::SPACE_ADVANCE);
+}
+
+TEST_CASE(CoverageIsCopiedWithoutOverlap) {
+	BoxGlyphSource source;
+	GlyphAtlas atlas(source, 64, 64);
+	int painted = 0;
+	for (uint32_t c = 'a'; c <= 'z'; c++) {
+		atlas.Get(c);
+	}
+	for (int i = 0; i < atlas.Width() * atlas.Height(); i++) {
+		painted += atlas.Pixels()[i] == 255;
+	}
+	CHECK(painted == 26 * 5 * 8);  // No two glyphs share a pixel
+
+	const AtlasGlyph* q = atlas.Get('q');
+	CHECK(q && atlas.Pixels()[q->y * atlas.Width() + q->x] == 255);
+	CHECK(atlas.Pixels()[(q->y + 8) * atlas.Width() + q->x] == 0);
+	CHECK(atlas.Generation() == 0);
+}
+
+TEST_CASE(FullAtlasStartsOver) {
+	// Room for 4 glyphs of 6x9 (with padding) in a 24x12 atlas
+	BoxGlyphSource source;
+	GlyphAtlas atlas(source, 24, 12);
+	for (uint32_t c = 'a'; c < 'a' + 4; c++) {
+		CHECK(atlas.Get(c) != nullptr);
+	}
+	CHECK(atlas.Generation() == 0);
+
+	const AtlasGlyph* e = atlas.Get('e');
+	CHECK(e && e->x == 0 && e->y == 0);
+	CHECK(atlas.Generation() == 1 && atlas.Stats().resets == 1);
+
+	// Earlier glyphs were dropped and come back as misses
+	uint64_t misses = atlas.Stats().misses;
+	atlas.Get('a');
+	CHECK(atlas.Stats().misses == misses + 1);
+
+	// A glyph larger than the whole atlas can't be drawn
+	GlyphAtlas tiny(source, 4, 4);
+	CHECK(!tiny.Get('a'));
+}
+
+namespace {
+	struct Text {
+		BoxGlyphSource source;
+		GlyphAtlas atlas{ source, 128, 128 };
+		TextRunCache runs{ atlas, 3 };
+	};
+}
+
+TEST_CASE(RunsAccumulateAdvances) {
+	Text text;
+	const TextRun& run = text.runs.Layout(L"ab c");
+	CHECK(run.simple && run.Count() == 4);
+	CHECK(run.offsets.size() == 5);
+	CHECK(run.offsets[1] == 7 && run.offsets[2] == 14 && run.offsets[3] == 18 && run.Width() == 25);
+	CHECK(text.runs.Layout(L"").Width() == 0);
+}
+
+TEST_CASE(ComplexTextIsNotSimple) {
+	Text text;
+	CHECK(!text.runs.Layout(L"a\x05D0").simple);  // Missing from the font
+	CHECK(!text.runs.Layout(L"e\x0301").simple);  // Combining mark
+	CHECK(!text.runs.Layout(L"a\x200Fz").simple); // Direction mark
+	CHECK(text.runs.Layout(L"plain").simple);
+}
+
+TEST_CASE(FitLeavesRoomForEllipsis) {
+	Text text;
+	int ellipsis = text.runs.EllipsisWidth();
+	CHECK(ellipsis == BoxGlyphSource::ADVANCE);
+
+	const TextRun& run = text.runs.Layout(L"abcdefgh");  // 56 wide
+	CHECK(run.FitCount(56, ellipsis) == 8);
+	CHECK(run.FitCount(55, ellipsis) == 6);  // 6 glyphs + ellipsis = 49
+	CHECK(run.FitCount(10, ellipsis) == 0);
+}
+
+TEST_CASE(RunsAreLeastRecentlyUsed) {
+	Text text;
+	const TextRun* one = &text.runs.Layout(L"one");
+	text.runs.Layout(L"two");
+	text.runs.Layout(L"three");
+	CHECK(&text.runs.Layout(L"one") == one);  // Hit, and now most recent
+	text.runs.Layout(L"four");                // Evicts "two"
+	CHECK(text.runs.Stats().evictions == 1);
+
+	uint64_t misses = text.runs.Stats().misses;
+	text.runs.Layout(L"one");
+	text.runs.Layout(L"three");
+	CHECK(text.runs.Stats().misses == misses);
+	text.runs.Layout(L"two");
+	CHECK(text.runs.Stats().misses == misses + 1);
+	CHECK(text.runs.Stats().hits == 3);
+}
@@ -0,0 +1,128 @@
+#include "Check.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "IconAtlas.h"
+
+namespace {
+
+	struct TestEntry {
+		const char* name;
+		uint16_t dpi;
+		uint16_t size;
+	};
+
+	// Lays out an atlas the way IconAtlasGen does, entries in the given order
+	std::vector<uint8_t> BuildAtlas(std::initializer_list<TestEntry> entries) {
+		size_t offset = sizeof(IconAtlas::Header) + entries.size() * sizeof(IconAtlas::Entry);
+		std::vector<IconAtlas::Entry> table;
+		for (const TestEntry& test : entries) {
+			IconAtlas::Entry entry = {};
+			memcpy(entry.name, test.name, std::min(strlen(test.name), IconAtlas::NAME_LENGTH));
+			entry.dpi = test.dpi;
+			entry.size = test.size;
+			offset = (offset + 3) & ~static_cast<size_t>(3);
+			entry.offset = static_cast<uint32_t>(offset);
+			offset += static_cast<size_t>(test.size) * test.size;
+			table.push_back(entry);
+		}
+
+		std::vector<uint8_t> data(offset, 0);
+		IconAtlas::Header header = { IconAtlas::MAGIC, IconAtlas::VERSION, static_cast<uint32_t>(table.size()), 0 };
+		memcpy(data.data(), &header, sizeof(header));
+		memcpy(data.data() + sizeof(header), table.data(), table.size() * sizeof(IconAtlas::Entry));
+		for (const IconAtlas::Entry& entry : table) {
+			memset(data.data() + entry.offset, entry.dpi & 0xFF, static_cast<size_t>(entry.size) * entry.size);
+		}
+		return data;
+	}
+}
+
+TEST_CASE(FindsEveryEntry) {
+	std::vector<uint8_t> data = BuildAtlas({
+		{ "icon-back", 96, 20 }, { "icon-back", 144, 30 }, { "icon-home", 96, 20 }, { "icon-home", 120, 25 } });
+	IconAtlas::View view;
+	CHECK(view.Attach(data.data(), data.size()));
+	CHECK(view.Count() == 4);
+
+	const IconAtlas::Entry* entry = view.Find("icon-home", 120);
+	CHECK(entry && entry->size == 25 && view.Pixels(*entry)[0] == 120);
+	CHECK(view.Find("icon-back", 144) == &view.At(1));
+	CHECK(!view.Find("icon-home", 144));
+	CHECK(!view.Find("icon-missing", 96));
+	CHECK(!view.Find("", 96));
+}
+
+TEST_CASE(RejectsMalformedFiles) {
+	std::vector<uint8_t> good = BuildAtlas({ { "a", 96, 4 }, { "b", 96, 4 } });
+	IconAtlas::View view;
+	CHECK(view.Attach(good.data(), good.size()));
+
+	CHECK(!view.Attach(nullptr, 0));
+	CHECK(!view.Attach(good.data(), sizeof(IconAtlas::Header) - 1));
+	CHECK(!view.IsValid());
+
+	// Table or masks cut short
+	CHECK(!view.Attach(good.data(), sizeof(IconAtlas::Header) + sizeof(IconAtlas::Entry)));
+	CHECK(!view.Attach(good.data(), good.size() - 1));
+
+	std::vector<uint8_t> badMagic = good;
+	badMagic[0] ^= 1;
+	CHECK(!view.Attach(badMagic.data(), badMagic.size()));
+
+	// Mask offset past the end of the file
+	std::vector<uint8_t> badOffset = good;
+	uint32_t offset = 0xFFFFFFF0;
+	memcpy(badOffset.data() + sizeof(IconAtlas::Header) + offsetof(IconAtlas::Entry, offset), &offset, sizeof(offset));
+	CHECK(!view.Attach(badOffset.data(), badOffset.size()));
+}
+
+TEST_CASE(RejectsUnsortedEntries) {
+	// Find binary searches, so order is part of the format
+	std::vector<uint8_t> unsorted = BuildAtlas({ { "b", 96, 4 }, { "a", 96, 4 } });
+	std::vector<uint8_t> dpiOrder = BuildAtlas({ { "a", 144, 4 }, { "a", 96, 4 } });
+	std::vector<uint8_t> duplicate = BuildAtlas({ { "a", 96, 4 }, { "a", 96, 4 } });
+	IconAtlas::View view;
+	CHECK(!view.Attach(unsorted.data(), unsorted.size()));
+	CHECK(!view.Attach(dpiOrder.data(), dpiOrder.size()));
+	CHECK(!view.Attach(duplicate.data(), duplicate.size()));
+	CHECK(!view.IsValid());
+}
+
+#ifdef DINGUS_GENERATED_ATLAS
+TEST_CASE(GeneratedAtlasHasEveryScale) {
+	// Written by the IconAtlasGen test from Icons.svg
+	FILE* file = fopen(DINGUS_GENERATED_ATLAS, "rb");
+	CHECK(file != nullptr);
+	if (!file) return;
+	std::vector<uint8_t> data;
+	uint8_t buffer[4096];
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		data.insert(data.end(), buffer, buffer + read);
+	}
+	fclose(file);
+
+	IconAtlas::View view;
+	CHECK(view.Attach(data.data(), data.size()));
+	for (const char* id : { "icon-back", "icon-forward", "icon-refresh", "icon-home", "icon-bookmark" }) {
+		for (uint16_t dpi : IconAtlas::DPI_SCALES) {
+			const IconAtlas::Entry* entry = view.Find(id, dpi);
+			CHECK(entry && entry->size == (20 * dpi + 48) / 96);
+			if (!entry) continue;
+
+			// Every icon covers some pixels fully and leaves some empty
+			const uint8_t* pixels = view.Pixels(*entry);
+			size_t full = 0, empty = 0;
+			for (size_t i = 0; i < static_cast<size_t>(entry->size) * entry->size; i++) {
+				full += pixels[i] == 255;
+				empty += pixels[i] == 0;
+			}
+			CHECK(full > 0 && empty > 0);
+		}
+	}
+}
+#endif
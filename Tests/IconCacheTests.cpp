@@ -0,0 +1,69 @@
+#include "Check.h"
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "IconCache.h"
+
+TEST_CASE(EvictsLeastRecentlyUsed) {
+	IconCache<int> cache(2);
+	IconCacheKey a{ 1, 20, 96, 0 }, b{ 2, 20, 96, 0 }, c{ 3, 20, 96, 0 };
+	cache.Insert(a, 1);
+	cache.Insert(b, 2);
+	CHECK(cache.Find(a) && *cache.Find(a) == 1);  // a is now most recent
+
+	cache.Insert(c, 3);
+	CHECK(!cache.Find(b));
+	CHECK(cache.Find(a) && cache.Find(c));
+	CHECK(cache.Size() == 2);
+	CHECK(cache.Stats().evictions == 1);
+}
+
+TEST_CASE(InsertReplacesAndRefreshes) {
+	IconCache<int> cache(2);
+	IconCacheKey a{ 1, 20, 96, 0 }, b{ 2, 20, 96, 0 }, c{ 3, 20, 96, 0 };
+	cache.Insert(a, 1);
+	cache.Insert(b, 2);
+	CHECK(cache.Insert(a, 10) == 10);
+	cache.Insert(c, 3);
+	CHECK(cache.Find(a) && *cache.Find(a) == 10);
+	CHECK(!cache.Find(b));
+	CHECK(cache.Size() == 2);
+}
+
+TEST_CASE(EveryKeyFieldMatters) {
+	IconCache<int> cache(8);
+	IconCacheKey base{ 1, 20, 96, 0x00FF00 };
+	cache.Insert(base, 1);
+	CHECK(!cache.Find({ 2, 20, 96, 0x00FF00 }));
+	CHECK(!cache.Find({ 1, 30, 96, 0x00FF00 }));
+	CHECK(!cache.Find({ 1, 20, 144, 0x00FF00 }));
+	CHECK(!cache.Find({ 1, 20, 96, 0x0000FF }));
+	CHECK(cache.Find(base));
+	CHECK(cache.Stats().hits == 1 && cache.Stats().misses == 4);
+}
+
+TEST_CASE(HashSpreadsSimilarKeys) {
+	// Keys differing in one field must not collide in bulk
+	std::unordered_set<size_t> hashes;
+	IconCacheKeyHash hash;
+	for (int icon = 0; icon < 16; icon++) {
+		for (uint16_t dpi : { 96, 120, 144, 192 }) {
+			for (uint32_t color : { 0x000000u, 0x202020u, 0xFFFFFFu }) {
+				hashes.insert(hash({ icon, 20, dpi, color }));
+			}
+		}
+	}
+	CHECK(hashes.size() == 16 * 4 * 3);
+}
+
+TEST_CASE(MoveOnlyValuesAndClear) {
+	IconCache<std::unique_ptr<int>> cache(0);  // Capacity is at least one
+	CHECK(cache.Capacity() == 1);
+	cache.Insert({ 1, 20, 96, 0 }, std::make_unique<int>(5));
+	std::unique_ptr<int>* value = cache.Find({ 1, 20, 96, 0 });
+	CHECK(value && **value == 5);
+	cache.Clear();
+	CHECK(cache.Size() == 0 && !cache.Find({ 1, 20, 96, 0 }));
+}
@@ -0,0 +1,96 @@
+#include "Check.h"
+
+#include <cmath>
+#include <random>
+
+#include "IconFlatten.h"
+
+namespace {
+
+	Svg::Point Evaluate(Svg::Point p0, Svg::Point p1, Svg::Point p2, Svg::Point p3, float t) {
+		float u = 1 - t;
+		float a = u * u * u, b = 3 * u * u * t, c = 3 * u * t * t, d = t * t * t;
+		return { a * p0.x + b * p1.x + c * p2.x + d * p3.x, a * p0.y + b * p1.y + c * p2.y + d * p3.y };
+	}
+
+	float DistanceToSegment(Svg::Point p, Svg::Point a, Svg::Point b) {
+		float dx = b.x - a.x, dy = b.y - a.y;
+		float length = dx * dx + dy * dy;
+		float t = length > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / length : 0;
+		t = t < 0 ? 0 : (t > 1 ? 1 : t);
+		float ex = a.x + t * dx - p.x, ey = a.y + t * dy - p.y;
+		return std::sqrt(ex * ex + ey * ey);
+	}
+}
+
+TEST_CASE(StraightCubicIsOneSegment) {
+	// Control points evenly spaced on a line have no second difference
+	CHECK(IconFlatten::CubicSegmentCount({ 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 3 }, 0.125f) == 1);
+	CHECK(IconFlatten::CubicSegmentCount({ 5, 5 }, { 5, 5 }, { 5, 5 }, { 5, 5 }, 0.125f) == 1);
+}
+
+TEST_CASE(SegmentsScaleWithSquareRootOfSize) {
+	Svg::Point p[4] = { { 0, 0 }, { 0, 10 }, { 10, 10 }, { 10, 0 } };
+	int base = IconFlatten::CubicSegmentCount(p[0], p[1], p[2], p[3], 0.125f);
+	for (Svg::Point& point : p) {
+		point.x *= 4;
+		point.y *= 4;
+	}
+	int scaled = IconFlatten::CubicSegmentCount(p[0], p[1], p[2], p[3], 0.125f);
+	CHECK(base > 1);
+	CHECK(scaled >= 2 * base - 1 && scaled <= 2 * base + 1);
+
+	// A looser tolerance needs fewer segments
+	CHECK(IconFlatten::CubicSegmentCount(p[0], p[1], p[2], p[3], 2.0f) < scaled);
+}
+
+TEST_CASE(SegmentCountIsBounded) {
+	CHECK(IconFlatten::CubicSegmentCount({ 0, 0 }, { 1e30f, 0 }, { -1e30f, 0 }, { 0, 0 }, 0.125f) == IconFlatten::MAX_SEGMENTS);
+	CHECK(IconFlatten::CubicSegmentCount({ 0, 0 }, { NAN, 0 }, { 0, 0 }, { 1, 1 }, 0.125f) == 1);
+	CHECK(IconFlatten::CubicSegmentCount({ 0, 0 }, { 0, 10 }, { 10, 10 }, { 10, 0 }, 0.0f) ==
+		IconFlatten::CubicSegmentCount({ 0, 0 }, { 0, 10 }, { 10, 10 }, { 10, 0 }, IconFlatten::DEFAULT_TOLERANCE));
+}
+
+TEST_CASE(PolylineStaysWithinTolerance) {
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> coordinate(0.0f, 72.0f);
+	for (int iteration = 0; iteration < 500; iteration++) {
+		Svg::Point p0 = { coordinate(random), coordinate(random) };
+		Svg::Point p1 = { coordinate(random), coordinate(random) };
+		Svg::Point p2 = { coordinate(random), coordinate(random) };
+		Svg::Point p3 = { coordinate(random), coordinate(random) };
+		float tolerance = iteration % 2 ? 0.125f : 0.5f;
+
+		int segments = IconFlatten::CubicSegmentCount(p0, p1, p2, p3, tolerance);
+		float xs[IconFlatten::MAX_SEGMENTS], ys[IconFlatten::MAX_SEGMENTS];
+		IconFlatten::EvaluateCubic(p0, p1, p2, p3, segments, xs, ys);
+
+		// The last point lands exactly on the end of the curve
+		CHECK(xs[segments - 1] == p3.x && ys[segments - 1] == p3.y);
+
+		float worst = 0;
+		for (int s = 0; s < segments; s++) {
+			Svg::Point a = s == 0 ? p0 : Svg::Point{ xs[s - 1], ys[s - 1] };
+			Svg::Point b = { xs[s], ys[s] };
+			for (int k = 0; k <= 16; k++) {
+				float t = (s + k / 16.0f) / segments;
+				float distance = DistanceToSegment(Evaluate(p0, p1, p2, p3, t), a, b);
+				worst = distance > worst ? distance : worst;
+			}
+		}
+		CHECK(worst <= tolerance * 1.01f);
+	}
+}
+
+TEST_CASE(VectorAndScalarEvaluationAgree) {
+	// Counts on either side of the four-wide vector loop
+	Svg::Point p0 = { 1, 2 }, p1 = { 3, 9 }, p2 = { 8, -4 }, p3 = { 12, 5 };
+	for (int segments = 1; segments <= 9; segments++) {
+		float xs[16], ys[16];
+		IconFlatten::EvaluateCubic(p0, p1, p2, p3, segments, xs, ys);
+		for (int i = 0; i < segments; i++) {
+			Svg::Point expected = Evaluate(p0, p1, p2, p3, static_cast<float>(i + 1) / segments);
+			CHECK(std::fabs(xs[i] - expected.x) < 1e-4f && std::fabs(ys[i] - expected.y) < 1e-4f);
+		}
+	}
+}
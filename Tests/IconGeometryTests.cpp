@@ -0,0 +1,98 @@
+#include "Check.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "IconGeometry.h"
+#include "IconRaster.h"
+#include "ToolbarIcons.h"
+
+namespace {
+
+	// One point at a time, which always takes the scalar path
+	void TransformOneByOne(const std::vector<Svg::Point>& points, const IconGeometry::Transform& m,
+		std::vector<int16_t>& xs, std::vector<int16_t>& ys) {
+		xs.resize(points.size());
+		ys.resize(points.size());
+		for (size_t i = 0; i < points.size(); i++) {
+			IconGeometry::TransformPoints(&points[i], 1, m, &xs[i], &ys[i]);
+		}
+	}
+}
+
+TEST_CASE(ScalesToFixedPoint) {
+	Svg::Point points[] = { { 0, 0 }, { 24, 24 }, { 12, 6 }, { 1.5f, 0.25f }, { -2, 3 } };
+	int16_t xs[5], ys[5];
+	IconGeometry::TransformPoints(points, 5, IconGeometry::Transform::Scale(0.5f, 1, 2), xs, ys);
+	CHECK(xs[0] == 64 && ys[0] == 128);
+	CHECK(xs[1] == 13 * 64 && ys[1] == 14 * 64);
+	CHECK(xs[2] == 7 * 64 && ys[2] == 5 * 64);
+	CHECK(xs[3] == 112 && ys[3] == 136);
+	CHECK(xs[4] == 0 && ys[4] == 224);
+
+	// Rotation by 90 degrees: x' = -y, y' = x
+	IconGeometry::Transform rotate = { 0, 1, -1, 0, 0, 0 };
+	IconGeometry::TransformPoints(points + 2, 1, rotate, xs, ys);
+	CHECK(xs[0] == -6 * 64 && ys[0] == 12 * 64);
+}
+
+TEST_CASE(VectorAndScalarPathsAgree) {
+	// Includes NaN, infinities and values past the int16 and int32 ranges,
+	// where the vector conversion used to saturate the wrong way
+	float specials[] = { NAN, INFINITY, -INFINITY, 3e9f, -3e9f, 2147483648.0f, 1e38f, -1e38f,
+		511.99f, -512.01f, 0.5f / 64, 1.5f / 64, -0.5f / 64, 0.0f, -0.0f };
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> ordinary(-600.0f, 600.0f);
+	std::vector<Svg::Point> points;
+	for (int i = 0; i < 4001; i++) {
+		float x = random() % 2 ? specials[random() % std::size(specials)] : ordinary(random);
+		points.push_back({ x, ordinary(random) });
+	}
+
+	for (const IconGeometry::Transform& m : { IconGeometry::Transform{}, IconGeometry::Transform::Scale(1.25f, 3, -2),
+		IconGeometry::Transform{ 0.8f, 0.6f, -0.6f, 0.8f, 10, 10 } }) {
+		std::vector<int16_t> xs(points.size()), ys(points.size()), scalarXs, scalarYs;
+		IconGeometry::TransformPoints(points.data(), static_cast<int>(points.size()), m, xs.data(), ys.data());
+		TransformOneByOne(points, m, scalarXs, scalarYs);
+		CHECK(xs == scalarXs);
+		CHECK(ys == scalarYs);
+	}
+
+	// Out of range saturates to the nearer end; NaN to the top
+	int16_t x, y;
+	Svg::Point huge = { 1e30f, -1e30f };
+	IconGeometry::TransformPoints(&huge, 1, {}, &x, &y);
+	CHECK(x == 32767 && y == -32768);
+	Svg::Point nan = { NAN, 0 };
+	IconGeometry::TransformPoints(&nan, 1, {}, &x, &y);
+	CHECK(x == 32767);
+}
+
+TEST_CASE(ScaledPathRastersLikeFloatPath) {
+	using Icon = ToolbarIcons::Refresh;
+	IconPath path = { Icon::Data.points, Icon::Data.types, static_cast<int>(Icon::Count) };
+	for (int size : { 20, 30, 60 }) {
+		float scale = size / 24.0f;
+		IconGeometry::ScaledIconPath scaled;
+		IconGeometry::BuildScaledPath(path, IconGeometry::Transform::Scale(scale), scaled);
+		CHECK(scaled.Count() == path.count);
+
+		IconRaster::CoverageRasterizer fromFloat, fromFixed;
+		fromFloat.Reset(size, size);
+		fromFixed.Reset(size, size);
+		fromFloat.AddPath(path, scale, 0, 0);
+		fromFixed.AddFixedPath(scaled.xs.data(), scaled.ys.data(), scaled.types.data(), scaled.Count(), IconGeometry::FIXED_SHIFT);
+		std::vector<uint8_t> a(static_cast<size_t>(size) * size), b(a.size());
+		fromFloat.Resolve(a.data(), size);
+		fromFixed.Resolve(b.data(), size);
+
+		// Quantizing to 1/64 px moves edges by at most half of that
+		int worst = 0;
+		for (size_t i = 0; i < a.size(); i++) {
+			int error = std::abs(a[i] - b[i]);
+			worst = error > worst ? error : worst;
+		}
+		CHECK(worst <= 8);
+	}
+}
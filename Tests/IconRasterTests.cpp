@@ -0,0 +1,166 @@
+#include "Check.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "IconRaster.h"
+#include "SvgPath.h"
+
+namespace {
+
+	std::vector<uint8_t> Rasterize(const char* path, int size, float scale = 1.0f, float offset = 0.0f) {
+		Svg::Point points[256];
+		uint8_t types[256];
+		Svg::ParseResult parsed = Svg::ParsePath(path, points, types, 256);
+
+		IconRaster::CoverageRasterizer rasterizer;
+		rasterizer.Reset(size, size);
+		rasterizer.AddPath(points, types, static_cast<int>(parsed.count), scale, offset, offset);
+		std::vector<uint8_t> mask(static_cast<size_t>(size) * size);
+		rasterizer.Resolve(mask.data(), size);
+		return mask;
+	}
+
+	int Sum(const std::vector<uint8_t>& mask) {
+		int sum = 0;
+		for (uint8_t value : mask) sum += value;
+		return sum;
+	}
+}
+
+TEST_CASE(AxisAlignedSquareIsExact) {
+	// Covers pixels 3..6 fully, half of columns/rows 2 and 7, a quarter of the corners
+	std::vector<uint8_t> mask = Rasterize("M2.5 2.5H7.5V7.5H2.5z", 10);
+	CHECK(mask[4 * 10 + 4] == 255);
+	CHECK(mask[4 * 10 + 2] == 128 && mask[2 * 10 + 4] == 128);
+	CHECK(mask[2 * 10 + 2] == 64 && mask[7 * 10 + 7] == 64);
+	CHECK(mask[4 * 10 + 1] == 0 && mask[4 * 10 + 8] == 0);
+}
+
+TEST_CASE(CoverageSumsToArea) {
+	// Triangle of area 50 square pixels
+	std::vector<uint8_t> mask = Rasterize("M1 1L11 1L1 11z", 16);
+	CHECK(std::abs(Sum(mask) - 50 * 255) < 255);
+
+	// Reversed winding covers the same pixels
+	CHECK(Rasterize("M1 1L1 11L11 1z", 16) == mask);
+}
+
+TEST_CASE(NonzeroWinding) {
+	// Overlap with the same direction stays fully covered; opposite direction cuts a hole
+	std::vector<uint8_t> same = Rasterize("M0 0H8V8H0zM2 2H6V6H2z", 8);
+	std::vector<uint8_t> hole = Rasterize("M0 0H8V8H0zM2 2V6H6V2z", 8);
+	CHECK(same[3 * 8 + 3] == 255);
+	CHECK(hole[3 * 8 + 3] == 0);
+	CHECK(hole[0] == 255);
+}
+
+TEST_CASE(OpenSubpathsCloseImplicitly) {
+	CHECK(Rasterize("M1 1L11 1L1 11", 16) == Rasterize("M1 1L11 1L1 11z", 16));
+}
+
+TEST_CASE(ClippingMatchesLargerMask) {
+	// Edges crossing any side of a small mask must give the same coverage as
+	// the same edges well inside a larger one
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> coordinate(-30.0f, 50.0f);
+	int worst = 0;
+	for (int iteration = 0; iteration < 2000; iteration++) {
+		float p[8];
+		for (float& v : p) v = coordinate(random);
+
+		IconRaster::CoverageRasterizer small, large;
+		small.Reset(16, 16);
+		large.Reset(128, 128);
+		for (int k = 0; k < 4; k++) {
+			int n = (k + 1) % 4;
+			small.AddLine(p[2 * k], p[2 * k + 1], p[2 * n], p[2 * n + 1]);
+			large.AddLine(p[2 * k] + 50, p[2 * k + 1] + 50, p[2 * n] + 50, p[2 * n + 1] + 50);
+		}
+		uint8_t a[16 * 16];
+		std::vector<uint8_t> b(128 * 128);
+		small.Resolve(a, 16);
+		large.Resolve(b.data(), 128);
+		for (int y = 0; y < 16; y++) {
+			for (int x = 0; x < 16; x++) {
+				int error = std::abs(a[y * 16 + x] - b[(y + 50) * 128 + x + 50]);
+				worst = error > worst ? error : worst;
+			}
+		}
+	}
+	CHECK(worst <= 1);
+}
+
+TEST_CASE(HugeAndNonFiniteEdges) {
+	// A triangle far larger than the mask covers all of it
+	std::vector<uint8_t> mask = Rasterize("M-1e30-1e30L1e30-1e30L0 1e30z", 12);
+	CHECK(Sum(mask) == 255 * 144);
+
+	// Curves with control points near the float limit stay in bounds
+	Rasterize("M0 0C1e38 0 -1e38 30 10 10z", 24);
+	Rasterize("M0 0C3e38 3e38 -3e38 -3e38 10 10z", 24, 4.0f);
+
+	// Non-finite edges are dropped; the rest of the path still fills
+	IconRaster::CoverageRasterizer rasterizer;
+	rasterizer.Reset(8, 8);
+	rasterizer.AddLine(INFINITY, 0, 4, 8);
+	rasterizer.AddLine(NAN, 0, 4, 8);
+	rasterizer.AddLine(0, -INFINITY, 4, INFINITY);
+	std::vector<uint8_t> empty(64);
+	rasterizer.Resolve(empty.data(), 8);
+	CHECK(Sum(empty) == 0);
+}
+
+TEST_CASE(FixedPathMatchesFloatPath) {
+	Svg::Point points[] = { { 1.25f, 1.5f }, { 9.75f, 2.0f }, { 5.5f, 9.25f } };
+	uint8_t types[] = { Svg::PointTypeStart, Svg::PointTypeLine, Svg::PointTypeLine | Svg::PointTypeCloseSubpath };
+	int16_t xs[3], ys[3];
+	for (int i = 0; i < 3; i++) {
+		xs[i] = static_cast<int16_t>(points[i].x * 16);
+		ys[i] = static_cast<int16_t>(points[i].y * 16);
+	}
+
+	IconRaster::CoverageRasterizer fromFloat, fromFixed;
+	fromFloat.Reset(12, 12);
+	fromFixed.Reset(12, 12);
+	fromFloat.AddPath(points, types, 3, 1.0f, 0.0f, 0.0f);
+	fromFixed.AddFixedPath(xs, ys, types, 3, 4);
+	uint8_t a[144], b[144];
+	fromFloat.Resolve(a, 12);
+	fromFixed.Resolve(b, 12);
+	CHECK(memcmp(a, b, sizeof(a)) == 0);
+}
+
+TEST_CASE(TintAndBlendMatchReference) {
+	std::mt19937 random(7);
+	for (int count : { 1, 3, 4, 7, 16, 33 }) {
+		std::vector<uint8_t> mask(count);
+		std::vector<uint32_t> tinted(count), blended(count), original(count);
+		for (int i = 0; i < count; i++) {
+			mask[i] = static_cast<uint8_t>(random());
+			original[i] = blended[i] = random() | 0xFF000000u;
+		}
+		uint8_t r = static_cast<uint8_t>(random()), g = static_cast<uint8_t>(random()), b = static_cast<uint8_t>(random());
+		IconRaster::TintCoverage(mask.data(), tinted.data(), count, r, g, b);
+		IconRaster::BlendCoverage(mask.data(), blended.data(), count, r, g, b);
+
+		for (int i = 0; i < count; i++) {
+			int a = mask[i];
+			CHECK(static_cast<int>(tinted[i] >> 24) == a);
+			CHECK(static_cast<int>((tinted[i] >> 16) & 0xFF) == (r * a + 127) / 255);
+			CHECK(static_cast<int>(tinted[i] & 0xFF) == (b * a + 127) / 255);
+
+			int shifts[] = { 16, 8, 0 };
+			uint8_t channels[] = { r, g, b };
+			for (int c = 0; c < 3; c++) {
+				int dst = (original[i] >> shifts[c]) & 0xFF;
+				int expected = (channels[c] * a + dst * (255 - a) + 127) / 255;
+				CHECK(std::abs(static_cast<int>((blended[i] >> shifts[c]) & 0xFF) - expected) <= 1);
+			}
+			CHECK((blended[i] >> 24) == 0xFF);
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#include "Check.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "LatencyHistogram.h"
+
+TEST_CASE(BucketsTileTheRange) {
+	bool contiguous = true;
+	for (int i = 0; i + 1 < LatencyHistogram::BUCKET_COUNT; i++) {
+		contiguous = contiguous && LatencyHistogram::BucketHighest(i) + 1 == LatencyHistogram::BucketLowest(i + 1);
+	}
+	CHECK(contiguous);
+	CHECK(LatencyHistogram::BucketIndex(LatencyHistogram::MAX_VALUE) == LatencyHistogram::BUCKET_COUNT - 1);
+
+	for (uint64_t value : std::initializer_list<uint64_t>{ 0, 1, 127, 128, 255, 256, 1000, 123456789, LatencyHistogram::MAX_VALUE }) {
+		int index = LatencyHistogram::BucketIndex(value);
+		CHECK(LatencyHistogram::BucketLowest(index) <= value && value <= LatencyHistogram::BucketHighest(index));
+	}
+
+	// Exact below 128, then within 1/64 of the value
+	CHECK(LatencyHistogram::BucketHighest(LatencyHistogram::BucketIndex(100)) == 100);
+	for (uint64_t value = 128; value < LatencyHistogram::MAX_VALUE / 3; value = value * 3 + 1) {
+		int index = LatencyHistogram::BucketIndex(value);
+		CHECK(LatencyHistogram::BucketHighest(index) - LatencyHistogram::BucketLowest(index) <= value / 64);
+	}
+}
+
+TEST_CASE(SummaryOfKnownValues) {
+	auto histogram = std::make_unique<LatencyHistogram>();
+	LatencyHistogram::Summary empty = histogram->Summarize();
+	CHECK(empty.count == 0 && empty.p99 == 0 && histogram->Percentile(50) == 0);
+
+	for (uint64_t value = 1; value <= 100; value++) {
+		histogram->Record(value);
+	}
+	LatencyHistogram::Summary summary = histogram->Summarize();
+	CHECK(summary.count == 100 && summary.min == 1 && summary.max == 100);
+	CHECK(summary.mean == 50.5);
+	CHECK(summary.p50 == 50 && summary.p90 == 90 && summary.p99 == 99);
+	CHECK(histogram->Percentile(100) == 100 && histogram->Percentile(0) == 1);
+
+	// Clamped to MAX_VALUE, and percentiles never pass the largest value seen
+	histogram->Reset();
+	histogram->Record(UINT64_MAX);
+	histogram->Record(1000);
+	CHECK(histogram->Summarize().max == LatencyHistogram::MAX_VALUE);
+	CHECK(histogram->Percentile(50) >= 1000 && histogram->Percentile(50) <= 1000 + 1000 / 64);
+	CHECK(histogram->Percentile(100) == LatencyHistogram::MAX_VALUE);
+}
+
+TEST_CASE(PercentilesWithinBucketError) {
+	auto histogram = std::make_unique<LatencyHistogram>();
+	std::mt19937_64 random(3);
+	std::lognormal_distribution<double> distribution(12, 1.5);
+	std::vector<uint64_t> values;
+	for (int i = 0; i < 200000; i++) {
+		uint64_t value = static_cast<uint64_t>(distribution(random));
+		values.push_back(value);
+		histogram->Record(value);
+	}
+	std::sort(values.begin(), values.end());
+
+	for (double percentile : { 50.0, 90.0, 99.0, 99.9 }) {
+		uint64_t exact = values[static_cast<size_t>(percentile / 100 * values.size()) - 1];
+		uint64_t reported = histogram->Percentile(percentile);
+		CHECK(reported >= exact && reported - exact <= exact / 64 + 1);
+	}
+}
+
+TEST_CASE(ConcurrentRecording) {
+	auto histogram = std::make_unique<LatencyHistogram>();
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([&] {
+			for (uint64_t i = 0; i < 100000; i++) histogram->Record(i);
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	LatencyHistogram::Summary summary = histogram->Summarize();
+	CHECK(summary.count == 400000 && summary.min == 0 && summary.max == 99999);
+	CHECK(summary.mean == 49999.5);
+}
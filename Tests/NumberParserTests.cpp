@@ -0,0 +1,133 @@
+#include "Check.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "NumberParser.h"
+
+namespace {
+
+	// Parses with both NumberParser and strtof and compares bits and length
+	bool MatchesStrtof(const std::string& text) {
+		float ours = 0;
+		const char* end = NumberParser::ParseFloat(text.c_str(), ours);
+		char* theirEnd = nullptr;
+		float theirs = strtof(text.c_str(), &theirEnd);
+		if (!end) {
+			return theirEnd == text.c_str();
+		}
+		return end == theirEnd && memcmp(&ours, &theirs, sizeof(float)) == 0;
+	}
+
+	template <typename Char>
+	float Parse(const Char* text) {
+		float value = -1;
+		NumberParser::ParseFloat(text, value);
+		return value;
+	}
+}
+
+TEST_CASE(Grammar) {
+	float value;
+	CHECK(NumberParser::ParseFloat(".5.5", value) && value == 0.5f);
+	const char* text = "-1.41-1.41";
+	CHECK(NumberParser::ParseFloat(text, value) == text + 5 && value == -1.41f);
+	text = "1e";
+	CHECK(NumberParser::ParseFloat(text, value) == text + 1 && value == 1);
+	text = "2e+x";
+	CHECK(NumberParser::ParseFloat(text, value) == text + 1);
+	text = "12345";
+	CHECK(NumberParser::ParseFloat(text, text + 3, value) == text + 3 && value == 123);
+
+	CHECK(!NumberParser::ParseFloat("", value));
+	CHECK(!NumberParser::ParseFloat("-.", value));
+	CHECK(!NumberParser::ParseFloat(" 1", value));
+	CHECK(!NumberParser::ParseFloat("inf", value));
+	CHECK(!NumberParser::ParseFloat("nan", value));
+}
+
+TEST_CASE(Limits) {
+	CHECK(Parse("3.4028235e38") == 3.4028235e38f);
+	CHECK(std::isinf(Parse("3.40282357e38")));
+	CHECK(std::isinf(Parse("-1e39")) && Parse("-1e39") < 0);
+	CHECK(Parse("1e-45") == std::nextafter(0.0f, 1.0f));
+	CHECK(Parse("7.1e-46") == std::nextafter(0.0f, 1.0f));
+	CHECK(Parse("7e-46") == 0);
+	CHECK(std::signbit(Parse("-0")));
+	CHECK(Parse("1e-100000") == 0 && std::isinf(Parse("1e100000")));
+}
+
+TEST_CASE(HalfwayCases) {
+	const char* cases[] = {
+		"16777217",     // Between 2^24 and 2^24 + 2, ties to even
+		"16777219",
+		"8388608.5",
+		"8388609.5",
+		"33554435",
+		// Exactly half the smallest subnormal rounds to zero; a hair more does not
+		"7.006492321624085354618647916449580656401309709382578858785341419448955413429303e-46",
+		"7.006492321624085354618647916449580656401309709382578858785341419448955413429304e-46",
+		"1.4012984643248170709237295832899161312802619418765157717570682838897910826858606014866381883621215820312500e-45",
+		"2.50000000000000000000000000000000000000001e-45",
+		"4.7019774032891500318749461488889827112746622270883500860350068251e-38",
+		"123456789012345678901234567890",
+		"9999999999999999999999999e-20",
+	};
+	for (const char* text : cases) {
+		CHECK(MatchesStrtof(text));
+	}
+}
+
+TEST_CASE(RandomFloatsRoundTrip) {
+	// Shortest and longer representations of random floats, and decimal
+	// strings just either side of the midpoint between neighbours
+	std::mt19937 random(9);
+	for (int i = 0; i < 200000; i++) {
+		uint32_t bits = static_cast<uint32_t>(random());
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		if (!std::isfinite(value)) continue;
+
+		char text[128];
+		snprintf(text, sizeof(text), "%.*g", 1 + static_cast<int>(random() % 12), value);
+		CHECK(MatchesStrtof(text));
+
+		double midpoint = (static_cast<double>(value) + std::nextafter(value, INFINITY)) / 2;
+		snprintf(text, sizeof(text), "%.*e", 5 + static_cast<int>(random() % 40), midpoint);
+		CHECK(MatchesStrtof(text));
+	}
+}
+
+TEST_CASE(LongDigitStrings) {
+	std::mt19937 random(3);
+	for (int i = 0; i < 20000; i++) {
+		std::string text;
+		int digits = 1 + static_cast<int>(random() % 40);
+		for (int d = 0; d < digits; d++) {
+			text += static_cast<char>('0' + random() % 10);
+			if (d == digits / 2 && random() % 2) text += '.';
+		}
+		text += 'e';
+		text += std::to_string(static_cast<int>(random() % 100) - 70);
+		CHECK(MatchesStrtof(text));
+	}
+}
+
+TEST_CASE(WideCharacters) {
+	CHECK(Parse(L"-12.5e-1") == -1.25f);
+	CHECK(Parse(u"-12.5e-1") == -1.25f);
+	CHECK(Parse(L"0.1") == Parse("0.1") && Parse(u"0.1") == Parse("0.1"));
+}
+
+TEST_CASE(ConstantEvaluation) {
+	constexpr float value = [] {
+		float f = 0;
+		NumberParser::ParseFloat("3.14159e-2", f);
+		return f;
+	}();
+	static_assert(value == 3.14159e-2f);
+	CHECK(value == 3.14159e-2f);
+}
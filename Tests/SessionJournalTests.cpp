@@ -0,0 +1,352 @@
+#include "Check.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SessionJournal.h"
+
+using namespace SessionJournal;
+
+namespace {
+
+	// In-memory journal that can fail or tear writes. Every state the data
+	// passes through is kept, as a crash could leave any of them on disk.
+	class MemoryStorage : public Storage {
+	public:
+		std::string data;
+		std::vector<std::string> states;
+		int failAppendEvery = 0;   // Appends only half the data, then fails
+		int failReplaceEvery = 0;  // Leaves the old journal in place
+		int failNextAppends = 0;
+		int failNextReplaces = 0;
+
+		bool Append(std::string_view chunk) override {
+			if ((failAppendEvery && ++m_appends % failAppendEvery == 0) || (failNextAppends && failNextAppends--)) {
+				data.append(chunk.substr(0, chunk.size() / 2));
+				states.push_back(data);
+				return false;
+			}
+			data.append(chunk);
+			states.push_back(data);
+			return true;
+		}
+
+		bool Replace(std::string_view chunk) override {
+			if ((failReplaceEvery && ++m_replaces % failReplaceEvery == 0) || (failNextReplaces && failNextReplaces--)) {
+				return false;
+			}
+			data.assign(chunk);
+			states.push_back(data);
+			return true;
+		}
+
+	private:
+		int m_appends = 0;
+		int m_replaces = 0;
+	};
+
+	bool Same(const Model& a, const Model& b) {
+		if (a.ids != b.ids || a.state.active != b.state.active || a.state.tabs.size() != b.state.tabs.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < a.ids.size(); i++) {
+			const Session::Tab& x = a.state.tabs[i];
+			const Session::Tab& y = b.state.tabs[i];
+			if (x.url != y.url || x.title != y.title || x.scrollY != y.scrollY) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// One tab, showing. Like the browser, the sessions below never close
+	// their last tab, so there is always an active one.
+	Model Seed() {
+		Model model;
+		model.ids = { 1 };
+		model.state.tabs.resize(1);
+		model.state.active = 0;
+		return model;
+	}
+
+	// A plausible next record for the session in shadow, applied to it
+	Record RandomRecord(std::mt19937& random, Model& shadow) {
+		Record record;
+		int kind = random() % 7;
+		if (kind == 0 || (kind == 4 && shadow.ids.size() == 1)) {
+			record.type = RecordType::Opened;
+			record.tab = shadow.NextId();
+			record.value = static_cast<int32_t>(random() % (shadow.ids.size() + 2));
+		}
+		else {
+			record.tab = shadow.ids[random() % shadow.ids.size()];
+			switch (kind) {
+			case 1:
+				record.type = RecordType::Navigated;
+				record.text = L"https://example.com/" + std::to_wstring(random() % 1000) + L"\U0001F600";
+				break;
+			case 2:
+				record.type = RecordType::TitleChanged;
+				record.text = L"Title " + std::to_wstring(random());
+				break;
+			case 3:
+				record.type = RecordType::Scrolled;
+				record.value = static_cast<int32_t>(random() % 5000);
+				break;
+			case 4:
+				record.type = RecordType::Closed;
+				break;
+			case 5:
+				record.type = RecordType::Moved;
+				record.value = static_cast<int32_t>(random() % (shadow.ids.size() + 1));
+				break;
+			default:
+				record.type = RecordType::Activated;
+				break;
+			}
+		}
+		shadow.Apply(record);
+		return record;
+	}
+
+	// Waits for the writer to take the first count records, so they go out
+	// in many small batches as in a real session rather than one big one
+	void CatchUp(const Writer& writer, int count) {
+		while (writer.Stats().records < static_cast<uint64_t>(count)) {
+			std::this_thread::yield();
+		}
+	}
+
+	// A journal of count random records after a snapshot of Seed, with the
+	// model and journal length after each frame
+	struct History {
+		std::string journal;
+		std::vector<Model> models;
+		std::vector<size_t> ends;
+	};
+
+	History MakeHistory(std::mt19937& random, int count) {
+		History history;
+		Model shadow = Seed();
+		Record snapshot;
+		snapshot.type = RecordType::Snapshot;
+		snapshot.snapshot = shadow.state;
+		snapshot.snapshotIds = shadow.ids;
+		AppendFrame(history.journal, snapshot);
+		history.models.push_back(shadow);
+		history.ends.push_back(history.journal.size());
+		for (int i = 0; i < count; i++) {
+			AppendFrame(history.journal, RandomRecord(random, shadow));
+			history.models.push_back(shadow);
+			history.ends.push_back(history.journal.size());
+		}
+		return history;
+	}
+
+	// Index of the last frame that ends at or before length
+	size_t LastFrameWithin(const History& history, size_t length) {
+		size_t k = 0;
+		while (k + 1 < history.ends.size() && history.ends[k + 1] <= length) k++;
+		return k;
+	}
+}
+
+TEST_CASE(Crc32MatchesReference) {
+	CHECK(Crc32("123456789", 9) == 0xCBF43926u);
+	CHECK(Crc32("", 0) == 0);
+
+	// Several eight-byte steps plus a tail
+	const char* fox = "The quick brown fox jumps over the lazy dog";
+	CHECK(Crc32(fox, strlen(fox)) == 0x414FA339u);
+}
+
+TEST_CASE(ModelKeepsActiveTab) {
+	Model model;
+	Record record;
+	for (uint32_t id = 1; id <= 3; id++) {
+		record.type = RecordType::Opened;
+		record.tab = id;
+		record.value = 99;  // Clamped to the end
+		model.Apply(record);
+	}
+	record = Record();
+	record.type = RecordType::Activated;
+	record.tab = 2;
+	model.Apply(record);
+	CHECK((model.ids == std::vector<uint32_t>{ 1, 2, 3 }) && model.state.active == 1);
+
+	record.type = RecordType::Moved;
+	record.value = 0;
+	model.Apply(record);
+	CHECK((model.ids == std::vector<uint32_t>{ 2, 1, 3 }) && model.state.active == 0);
+
+	record.type = RecordType::Closed;
+	record.tab = 3;
+	model.Apply(record);
+	record.tab = 2;
+	model.Apply(record);
+	CHECK((model.ids == std::vector<uint32_t>{ 1 }) && model.state.active == 0);
+
+	// Unknown tabs are ignored
+	record.type = RecordType::Navigated;
+	record.tab = 42;
+	record.text = L"x";
+	model.Apply(record);
+	CHECK(model.state.tabs.size() == 1 && model.state.tabs[0].url.empty());
+}
+
+TEST_CASE(TornTailsReplayToLastWholeFrame) {
+	std::mt19937 random(7);
+	History history = MakeHistory(random, 300);
+
+	bool prefixes = true;
+	for (size_t cut = 0; cut <= history.journal.size(); cut++) {
+		Model model;
+		size_t valid = Replay(std::string_view(history.journal).substr(0, cut), model);
+		if (cut < history.ends[0]) {
+			prefixes = prefixes && valid == 0 && Same(model, Model());
+			continue;
+		}
+		size_t k = LastFrameWithin(history, cut);
+		prefixes = prefixes && valid == history.ends[k] && Same(model, history.models[k]);
+	}
+	CHECK(prefixes);
+
+	Model full;
+	CHECK(Replay(history.journal, full) == history.journal.size());
+	CHECK(Same(full, history.models.back()));
+}
+
+TEST_CASE(CorruptTailsStopReplay) {
+	std::mt19937 random(11);
+	History history = MakeHistory(random, 300);
+
+	// Replay never reaches past a flipped bit and never applies a damaged frame
+	bool prefixes = true;
+	for (int trial = 0; trial < 5000; trial++) {
+		std::string damaged = history.journal;
+		size_t byte = random() % damaged.size();
+		damaged[byte] ^= static_cast<char>(1 << (random() % 8));
+
+		Model model;
+		size_t valid = Replay(damaged, model);
+		size_t k = LastFrameWithin(history, valid);
+		prefixes = prefixes && valid <= byte && (valid == 0 || (valid == history.ends[k] && Same(model, history.models[k])));
+	}
+	CHECK(prefixes);
+
+	// A huge length in a header is corrupt, not a reason to wait for more data
+	std::string huge = history.journal.substr(0, history.ends[1]);
+	huge.append("\xff\xff\xff\x7f\0\0\0\0", 8);
+	Model model;
+	CHECK(Replay(huge, model) == history.ends[1]);
+}
+
+TEST_CASE(WriterSurvivesFailingStorage) {
+	// Torn appends and failed replaces: whatever is on disk at any moment
+	// replays to some earlier session, in order, and the final journal to
+	// the latest one
+	std::mt19937 random(3);
+	for (int failEvery : { 0, 3, 7 }) {
+		MemoryStorage storage;
+		storage.failAppendEvery = failEvery;
+		storage.failReplaceEvery = failEvery ? failEvery + 1 : 0;
+
+		Model shadow = Seed();
+		std::vector<Model> models = { shadow };
+		WriterStats stats;
+		{
+			Writer writer(storage, shadow, 2048);
+			for (int i = 1; i <= 1000; i++) {
+				writer.Write(RandomRecord(random, shadow));
+				models.push_back(shadow);
+				if (i % 10 == 0) {
+					CatchUp(writer, i);
+				}
+			}
+			stats = writer.Stats();
+		}
+
+		bool ordered = true;
+		size_t k = 0;
+		for (const std::string& state : storage.states) {
+			Model model;
+			Replay(state, model);
+			while (k < models.size() && !Same(model, models[k])) k++;
+			ordered = ordered && k < models.size();
+		}
+		CHECK(ordered);
+
+		Model model;
+		CHECK(Replay(storage.data, model) == storage.data.size());
+		CHECK(Same(model, shadow));
+		CHECK(stats.records == 1000 && (failEvery == 0) == (stats.failures == 0));
+	}
+}
+
+TEST_CASE(WriterRetriesBeforeStopping) {
+	// The last batch is torn and the compaction after it fails too
+	MemoryStorage storage;
+	Model shadow = Seed();
+	std::mt19937 random(9);
+	{
+		Writer writer(storage, shadow);
+		writer.Write(RandomRecord(random, shadow));
+		CatchUp(writer, 1);
+		storage.failNextAppends = 1;
+		storage.failNextReplaces = 1;
+		writer.Write(RandomRecord(random, shadow));
+		CatchUp(writer, 2);
+	}
+
+	Model model;
+	CHECK(Replay(storage.data, model) == storage.data.size());
+	CHECK(Same(model, shadow));
+}
+
+TEST_CASE(WriterCompacts) {
+	std::mt19937 random(5);
+	MemoryStorage storage;
+
+	// A restored session is written out as the first snapshot
+	Model restored;
+	restored.ids = { 4, 9 };
+	restored.state.tabs = { { L"https://a/", L"A", 1 }, { L"https://b/", L"B", 2 } };
+	restored.state.active = 1;
+	Model shadow = restored;
+	std::string uncompacted;
+	WriterStats stats;
+	{
+		Writer writer(storage, restored, 1024);
+		for (int i = 1; i <= 3000; i++) {
+			Record record = RandomRecord(random, shadow);
+			AppendFrame(uncompacted, record);
+			writer.Write(std::move(record));
+
+			if (i % 20 == 0) {
+				CatchUp(writer, i);
+			}
+		}
+		stats = writer.Stats();
+	}
+
+	CHECK(!storage.states.empty());
+	if (!storage.states.empty()) {
+		Model first;
+		CHECK(Replay(storage.states[0], first) == storage.states[0].size() && Same(first, restored));
+	}
+
+	// The journal is rewritten long before 3000 records pile up
+	size_t largest = 0;
+	for (const std::string& state : storage.states) {
+		largest = state.size() > largest ? state.size() : largest;
+	}
+	CHECK(largest < uncompacted.size() / 4);
+	CHECK(stats.compactions > 1 && stats.failures == 0);
+
+	Model model;
+	CHECK(Replay(storage.data, model) == storage.data.size() && Same(model, shadow));
+}
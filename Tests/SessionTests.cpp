@@ -0,0 +1,100 @@
+#include "Check.h"
+
+#include <string>
+#include <vector>
+
+#include "Session.h"
+
+namespace {
+
+	Session::State Sample() {
+		Session::State state;
+		state.tabs.push_back({ L"https://example.com/", L"Example Domain", 120 });
+		state.tabs.push_back({ L"about:blank", L"", 0 });
+		state.tabs.push_back({ L"https://example.org/\u00e9t\u00e9", L"\u65e5\u672c", -5 });
+		state.active = 1;
+		return state;
+	}
+
+	bool Same(const Session::State& a, const Session::State& b) {
+		if (a.active != b.active || a.tabs.size() != b.tabs.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < a.tabs.size(); i++) {
+			if (a.tabs[i].url != b.tabs[i].url || a.tabs[i].title != b.tabs[i].title || a.tabs[i].scrollY != b.tabs[i].scrollY) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+TEST_CASE(RoundTrips) {
+	Session::State state = Sample();
+	std::string data = Session::Encode(state);
+	Session::State decoded;
+	CHECK(Session::Decode(data, decoded));
+	CHECK(Same(state, decoded));
+
+	Session::State empty;
+	CHECK(Session::Decode(Session::Encode(empty), decoded));
+	CHECK(decoded.tabs.empty() && decoded.active == -1);
+}
+
+TEST_CASE(FormatIsFixed) {
+	// Little-endian, UTF-16 code units whatever the size of wchar_t
+	Session::State state;
+	state.tabs.push_back({ L"a", L"\U0001F600", 2 });
+	state.active = 0;
+	std::string expected("DSES\1\0\0\0\1\0\0\0\0\0\0\0" "\2\0\0\0" "\1\0\0\0a\0" "\2\0\0\0\x3d\xd8\x00\xde", 34);
+	CHECK(Session::Encode(state) == expected);
+
+	Session::State decoded;
+	CHECK(Session::Decode(expected, decoded) && Same(state, decoded));
+}
+
+TEST_CASE(RejectsMalformedData) {
+	std::string data = Session::Encode(Sample());
+	Session::State untouched = Sample();
+	untouched.active = 2;
+	Session::State out = untouched;
+
+	// Every truncation fails and leaves out alone
+	bool allRejected = true;
+	for (size_t size = 0; size < data.size(); size++) {
+		allRejected = allRejected && !Session::Decode(std::string_view(data).substr(0, size), out);
+	}
+	CHECK(allRejected);
+	CHECK(!Session::Decode(data + '\0', out));
+	CHECK(Same(out, untouched));
+
+	std::string badMagic = data;
+	badMagic[0] = 'X';
+	CHECK(!Session::Decode(badMagic, out));
+	std::string badVersion = data;
+	badVersion[4] = 2;
+	CHECK(!Session::Decode(badVersion, out));
+
+	// A huge tab count is rejected before anything is allocated
+	std::string hugeCount = data;
+	hugeCount[8] = hugeCount[9] = hugeCount[10] = hugeCount[11] = '\xff';
+	CHECK(!Session::Decode(hugeCount, out));
+}
+
+TEST_CASE(ActiveTabOutOfRangeFallsBack) {
+	Session::State state = Sample();
+	state.active = 7;
+	Session::State decoded;
+	CHECK(Session::Decode(Session::Encode(state), decoded) && decoded.active == 0);
+	state.active = -3;
+	CHECK(Session::Decode(Session::Encode(state), decoded) && decoded.active == 0);
+}
+
+TEST_CASE(PrefetchNearestFirst) {
+	CHECK((Session::PrefetchOrder(10, 5, 4) == std::vector<int>{ 6, 4, 7, 3 }));
+	CHECK((Session::PrefetchOrder(10, 0, 3) == std::vector<int>{ 1, 2, 3 }));
+	CHECK((Session::PrefetchOrder(4, 3, 10) == std::vector<int>{ 2, 1, 0 }));
+	CHECK((Session::PrefetchOrder(3, 1, 1) == std::vector<int>{ 2 }));
+	CHECK(Session::PrefetchOrder(1, 0, 5).empty());
+	CHECK(Session::PrefetchOrder(10, 5, 0).empty());
+}
@@ -0,0 +1,97 @@
+#include "Check.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SlotMap.h"
+
+TEST_CASE(StaleHandlesAreRejected) {
+	SlotMap<std::string> map;
+	SlotHandle a = map.Insert("a");
+	SlotHandle b = map.Insert("b");
+	CHECK(!a.IsNull() && a != b);
+	CHECK(*map.Get(a) == "a" && *map.Get(b) == "b");
+
+	CHECK(map.Erase(a));
+	CHECK(!map.Erase(a));
+	CHECK(!map.Contains(a) && map.Get(a) == nullptr);
+
+	// The slot is reused under a new generation
+	SlotHandle c = map.Insert("c");
+	CHECK(c.index == a.index && c.generation != a.generation);
+	CHECK(map.Get(a) == nullptr && *map.Get(c) == "c");
+	CHECK(*map.Get(b) == "b" && map.Size() == 2);
+
+	CHECK(map.Get(SlotHandle()) == nullptr);
+	CHECK(map.Get(SlotHandle{ 99, 1 }) == nullptr);
+}
+
+TEST_CASE(MadeUpHandlesAreRejected) {
+	SlotMap<int> map;
+	SlotHandle a = map.Insert(1);
+	map.Insert(2);
+	map.Erase(a);
+
+	// A freed slot's link field must not pass for a live position
+	for (uint32_t generation = 1; generation < 4; generation++) {
+		CHECK(!map.Contains({ a.index, generation }));
+	}
+}
+
+TEST_CASE(ValuesStayPacked) {
+	SlotMap<int> map;
+	std::vector<SlotHandle> handles;
+	for (int i = 0; i < 8; i++) {
+		handles.push_back(map.Insert(i));
+	}
+	map.Erase(handles[0]);
+	map.Erase(handles[5]);
+	CHECK(map.Size() == 6);
+
+	int sum = 0;
+	for (int value : map) sum += value;
+	CHECK(sum == 1 + 2 + 3 + 4 + 6 + 7);
+	for (size_t position = 0; position < map.Size(); position++) {
+		CHECK(map.Get(map.HandleAt(position)) == &map.ValueAt(position));
+	}
+}
+
+TEST_CASE(RandomChurnMatchesReference) {
+	SlotMap<std::string> map;
+	std::map<uint64_t, std::string> reference;
+	std::vector<SlotHandle> live, dead;
+	std::mt19937 random(1);
+	auto key = [](SlotHandle handle) { return static_cast<uint64_t>(handle.index) << 32 | handle.generation; };
+
+	bool consistent = true;
+	for (int step = 0; step < 50000; step++) {
+		if (live.empty() || random() % 3) {
+			SlotHandle handle = map.Insert(std::to_string(step));
+			live.push_back(handle);
+			reference[key(handle)] = std::to_string(step);
+		}
+		else {
+			size_t i = random() % live.size();
+			SlotHandle handle = live[i];
+			live[i] = live.back();
+			live.pop_back();
+			consistent = consistent && map.Erase(handle);
+			dead.push_back(handle);
+			reference.erase(key(handle));
+		}
+
+		if (step % 1000 == 0) {
+			for (SlotHandle handle : live) {
+				const std::string* value = map.Get(handle);
+				consistent = consistent && value && *value == reference[key(handle)];
+			}
+			for (SlotHandle handle : dead) {
+				consistent = consistent && !map.Contains(handle);
+			}
+			consistent = consistent && map.Size() == live.size();
+		}
+	}
+	CHECK(consistent);
+}
@@ -0,0 +1,181 @@
+#include "Check.h"
+
+#include <string>
+#include <vector>
+
+#include "BoxGlyphSource.h"
+#include "ChromePaint.h"
+#include "SoftwareCanvas.h"
+
+namespace {
+
+	constexpr uint32_t WHITE = 0xFFFFFF;
+	constexpr uint32_t RED = 0x0000FF;  // COLORREF
+	constexpr uint32_t BLACK = 0;
+
+	// Canvas pixels are BGRA in memory, so 0xAARRGGBB as integers
+	constexpr uint32_t WHITE_PIXEL = 0xFFFFFFFF;
+	constexpr uint32_t RED_PIXEL = 0xFFFF0000;
+	constexpr uint32_t BLACK_PIXEL = 0xFF000000;
+
+	int CountPixels(const SoftwareCanvas& canvas, uint32_t pixel) {
+		int count = 0;
+		for (int i = 0; i < canvas.Width() * canvas.Height(); i++) {
+			count += canvas.Pixels()[i] == pixel;
+		}
+		return count;
+	}
+
+	// A 4x4 icon with only its top-left pixel set
+	const uint8_t* CornerIcon(int) {
+		static const uint8_t mask[16] = { 255 };
+		return mask;
+	}
+}
+
+TEST_CASE(FillRectClipsAndUsesDibLayout) {
+	SoftwareCanvas canvas(10, 8, 4, nullptr);
+	canvas.FillRect({ -5, -5, 100, 100 }, WHITE);
+	CHECK(CountPixels(canvas, WHITE_PIXEL) == 80);
+
+	canvas.FillRect({ 2, 3, 4, 5 }, RED);
+	CHECK(canvas.Pixel(2, 3) == RED_PIXEL && canvas.Pixel(3, 4) == RED_PIXEL);
+	CHECK(canvas.Pixel(4, 4) == WHITE_PIXEL && canvas.Pixel(2, 5) == WHITE_PIXEL);
+	CHECK(CountPixels(canvas, RED_PIXEL) == 4);
+
+	canvas.FillRect({ 6, 6, 2, 2 }, RED);  // Empty
+	CHECK(CountPixels(canvas, RED_PIXEL) == 4);
+}
+
+TEST_CASE(FrameRoundRectDrawsOutlineOnly) {
+	SoftwareCanvas canvas(40, 20, 4, nullptr);
+	canvas.FillRect({ 0, 0, 40, 20 }, WHITE);
+	canvas.FrameRoundRect({ 5, 5, 35, 15 }, 3, BLACK);
+
+	CHECK(canvas.Pixel(20, 5) == BLACK_PIXEL);   // Top edge
+	CHECK(canvas.Pixel(20, 14) == BLACK_PIXEL);  // Bottom edge
+	CHECK(canvas.Pixel(5, 10) == BLACK_PIXEL && canvas.Pixel(34, 10) == BLACK_PIXEL);
+	CHECK(canvas.Pixel(20, 10) == WHITE_PIXEL);  // Inside
+	CHECK(canvas.Pixel(20, 4) == WHITE_PIXEL && canvas.Pixel(35, 10) == WHITE_PIXEL);
+
+	// The corner is rounded: partly covered, not solid
+	uint32_t corner = canvas.Pixel(5, 5);
+	CHECK(corner != BLACK_PIXEL);
+
+	// Frames partly off the canvas are clipped
+	canvas.FrameRoundRect({ -10, -10, 50, 30 }, 4, BLACK);
+	canvas.FrameRoundRect({ 30, 10, 30, 12 }, 4, BLACK);
+}
+
+TEST_CASE(DrawIconBlendsMask) {
+	SoftwareCanvas canvas(8, 8, 4, CornerIcon);
+	canvas.FillRect({ 0, 0, 8, 8 }, WHITE);
+	canvas.DrawIcon(1, 2, 2, RED);
+	CHECK(canvas.Pixel(2, 2) == RED_PIXEL);
+	CHECK(CountPixels(canvas, WHITE_PIXEL) == 63);
+
+	// Off the edge, and with no icon source
+	canvas.DrawIcon(1, -1, -1, RED);
+	canvas.DrawIcon(1, 7, 7, RED);
+	CHECK(canvas.Pixel(7, 7) == RED_PIXEL);
+	SoftwareCanvas bare(8, 8, 4, nullptr);
+	bare.DrawIcon(1, 0, 0, RED);
+	CHECK(CountPixels(bare, 0) == 64);
+}
+
+TEST_CASE(TextNeedsCache) {
+	BoxGlyphSource source;
+	GlyphAtlas atlas(source, 64, 64);
+	TextRunCache text(atlas, 8);
+
+	SoftwareCanvas canvas(100, 20, 4, nullptr);
+	canvas.FillRect({ 0, 0, 100, 20 }, WHITE);
+	canvas.DrawTextLine(L"abc", { 0, 0, 100, 20 }, BLACK);
+	CHECK(CountPixels(canvas, WHITE_PIXEL) == 2000);
+
+	// Three 5x8 boxes, 7 pixels apart
+	canvas.SetText(&text);
+	canvas.DrawTextLine(L"abc", { 0, 0, 100, 20 }, BLACK);
+	CHECK(CountPixels(canvas, BLACK_PIXEL) == 3 * 5 * 8);
+	CHECK(canvas.Pixel(1, 5) == BLACK_PIXEL && canvas.Pixel(8, 5) == BLACK_PIXEL);
+	CHECK(canvas.Pixel(6, 5) == WHITE_PIXEL);
+}
+
+TEST_CASE(TextIsClippedToRect) {
+	BoxGlyphSource source;
+	GlyphAtlas atlas(source, 64, 64);
+	TextRunCache text(atlas, 8);
+
+	// Nothing is drawn right of the rect, and the canvas edge clips too
+	SoftwareCanvas canvas(30, 20, 4, nullptr);
+	canvas.SetText(&text);
+	canvas.FillRect({ 0, 0, 30, 20 }, WHITE);
+	canvas.DrawTextLine(L"a long label", { -3, 0, 20, 20 }, BLACK);
+	for (int y = 0; y < 20; y++) {
+		for (int x = 20; x < 30; x++) {
+			CHECK(canvas.Pixel(x, y) == WHITE_PIXEL);
+		}
+	}
+	CHECK(CountPixels(canvas, BLACK_PIXEL) > 0);
+}
+
+TEST_CASE(ToolbarPaintsHoveredButton) {
+	ToolbarModel model;
+	model.AddButton(1, { 0, 0, 8, 8 });
+	model.AddButton(2, { 8, 0, 16, 8 });
+	model.SetHovered(1);
+
+	ChromePaint::Theme theme;
+	theme.background = WHITE;
+	theme.icon = BLACK;
+	theme.iconHover = RED;
+
+	// Icons are centered in their buttons; the corner icon lands at (2, 2)
+	SoftwareCanvas canvas(16, 8, 4, CornerIcon);
+	ChromePaint::Toolbar(canvas, model, { 0, 0, 16, 8 }, theme);
+	CHECK(canvas.Pixel(2, 2) == BLACK_PIXEL);
+	CHECK(canvas.Pixel(10, 2) == RED_PIXEL);
+
+	// A clip that misses the second button leaves it alone
+	canvas.FillRect({ 0, 0, 16, 8 }, BLACK);
+	ChromePaint::Toolbar(canvas, model, { 0, 0, 8, 8 }, theme);
+	CHECK(canvas.Pixel(10, 2) == BLACK_PIXEL && canvas.Pixel(12, 6) == BLACK_PIXEL);
+	CHECK(canvas.Pixel(4, 6) == WHITE_PIXEL);
+}
+
+TEST_CASE(TabAndUrlBar) {
+	BoxGlyphSource source;
+	GlyphAtlas atlas(source, 128, 64);
+	TextRunCache text(atlas, 8);
+	UiMetrics metrics;
+
+	ChromePaint::Theme theme;
+	theme.background = WHITE;
+	theme.activeTab = WHITE;
+	theme.inactiveTab = WHITE;
+	theme.accent = RED;
+	theme.border = BLACK;
+	theme.text = BLACK;
+
+	SoftwareCanvas canvas(120, 30, 20, nullptr);
+	canvas.SetText(&text);
+	ChromePaint::Tab(canvas, { 0, 0, 60, 30 }, L"Selected", true, theme, metrics);
+	ChromePaint::Tab(canvas, { 60, 0, 120, 30 }, L"Other", false, theme, metrics);
+	CHECK(canvas.Pixel(30, 29) == RED_PIXEL && canvas.Pixel(30, 28) == RED_PIXEL);
+	CHECK(canvas.Pixel(90, 29) == WHITE_PIXEL);
+	CHECK(canvas.Pixel(119, 15) == BLACK_PIXEL);  // Separator
+	CHECK(canvas.Pixel(119, 1) == WHITE_PIXEL);
+
+	// Text starts after the padding
+	for (int y = 0; y < 28; y++) {
+		CHECK(canvas.Pixel(metrics.tabTextPadding - 1, y) == WHITE_PIXEL);
+	}
+	CHECK(canvas.Pixel(metrics.tabTextPadding + 1, 12) == BLACK_PIXEL);
+
+	SoftwareCanvas bar(200, 30, 20, nullptr);
+	bar.SetText(&text);
+	ChromePaint::UrlBar(bar, { 0, 0, 200, 30 }, L"https://example.com", theme, metrics);
+	CHECK(bar.Pixel(100, 0) == BLACK_PIXEL && bar.Pixel(199, 15) == BLACK_PIXEL);
+	CHECK(bar.Pixel(metrics.urlBarTextPadding + 1, 12) == BLACK_PIXEL);
+	CHECK(bar.Pixel(190, 12) == WHITE_PIXEL);
+}
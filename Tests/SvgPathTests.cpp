@@ -0,0 +1,202 @@
+#include "Check.h"
+
+#include <cmath>
+#include <vector>
+
+#include "SvgPath.h"
+
+namespace {
+
+	struct Parsed {
+		Svg::ParseResult result;
+		std::vector<Svg::Point> points;
+		std::vector<uint8_t> types;
+	};
+
+	// Measures, then fills exactly, as callers of ParsePath do
+	template <typename Char>
+	Parsed Parse(const Char* data) {
+		Parsed parsed;
+		Svg::ParseResult measured = Svg::ParsePath(data, nullptr, nullptr, 0);
+		parsed.points.resize(measured.count);
+		parsed.types.resize(measured.count);
+		parsed.result = Svg::ParsePath(data, parsed.points.data(), parsed.types.data(), measured.count);
+		return parsed;
+	}
+
+	bool Near(Svg::Point point, float x, float y) {
+		return std::fabs(point.x - x) < 1e-4f && std::fabs(point.y - y) < 1e-4f;
+	}
+
+	constexpr uint8_t Close(uint8_t type) {
+		return type | Svg::PointTypeCloseSubpath;
+	}
+}
+
+TEST_CASE(LinesAbsoluteAndRelative) {
+	Parsed p = Parse("M1 2 L3 4 l1 1 H10 h-2 V0 v3 z");
+	CHECK(p.result.ok && !p.result.truncated);
+	CHECK(p.points.size() == 7);
+	if (p.points.size() != 7) return;
+	CHECK(Near(p.points[0], 1, 2) && p.types[0] == Svg::PointTypeStart);
+	CHECK(Near(p.points[1], 3, 4) && p.types[1] == Svg::PointTypeLine);
+	CHECK(Near(p.points[2], 4, 5));
+	CHECK(Near(p.points[3], 10, 5));
+	CHECK(Near(p.points[4], 8, 5));
+	CHECK(Near(p.points[5], 8, 0));
+	CHECK(Near(p.points[6], 8, 3) && p.types[6] == Close(Svg::PointTypeLine));
+}
+
+TEST_CASE(ImplicitRepetition) {
+	// A repeated moveto becomes a lineto; other commands repeat as themselves
+	Parsed p = Parse("m1 1 2 2 3 3 L5 5 6 6");
+	CHECK(p.result.ok);
+	CHECK(p.points.size() == 5);
+	if (p.points.size() != 5) return;
+	CHECK(p.types[0] == Svg::PointTypeStart);
+	CHECK(Near(p.points[1], 3, 3) && p.types[1] == Svg::PointTypeLine);
+	CHECK(Near(p.points[2], 6, 6));
+	CHECK(Near(p.points[4], 6, 6));
+}
+
+TEST_CASE(CompactNumberForms) {
+	Parsed p = Parse("M.5.5L-1.41-1.41l1e1,2E-1");
+	CHECK(p.result.ok);
+	CHECK(p.points.size() == 3);
+	if (p.points.size() != 3) return;
+	CHECK(Near(p.points[0], 0.5f, 0.5f));
+	CHECK(Near(p.points[1], -1.41f, -1.41f));
+	CHECK(Near(p.points[2], 8.59f, -1.21f));
+}
+
+TEST_CASE(ArcFlagsWithoutSeparators) {
+	// "0012 4" is large-arc 0, sweep 0, then x = 12, y = 4
+	Parsed packed = Parse("M0 4a6 6 0 0012 4");
+	Parsed spaced = Parse("M0 4a6 6 0 0 0 12 4");
+	CHECK(packed.result.ok && spaced.result.ok);
+	CHECK(packed.points.size() == spaced.points.size());
+	CHECK(!packed.points.empty() && Near(packed.points.back(), 12, 8));
+}
+
+TEST_CASE(ArcsBecomeQuarterCubics) {
+	// A half circle needs two segments of at most 90 degrees
+	Parsed p = Parse("M0 0A5 5 0 0 1 10 0");
+	CHECK(p.result.ok);
+	CHECK(p.points.size() == 7);
+	if (p.points.size() != 7) return;
+	for (size_t i = 1; i < 7; i++) {
+		CHECK(p.types[i] == Svg::PointTypeBezier);
+	}
+	CHECK(Near(p.points[3], 5, -5));
+	CHECK(Near(p.points[6], 10, 0));
+
+	// Radii too small to span the endpoints are scaled up
+	Parsed small = Parse("M0 0A1 1 0 0 1 10 0");
+	CHECK(small.points.size() == 7 && Near(small.points[3], 5, -5));
+
+	// A zero radius is a straight line
+	Parsed flat = Parse("M0 0A0 5 0 0 1 10 0");
+	CHECK(flat.points.size() == 2 && flat.types[1] == Svg::PointTypeLine);
+}
+
+TEST_CASE(SmoothCurvesReflectControlPoints) {
+	Parsed p = Parse("M0 0C0 10 10 10 10 0S20 -10 20 0");
+	CHECK(p.result.ok && p.points.size() == 7);
+	if (p.points.size() == 7) {
+		CHECK(Near(p.points[4], 10, -10));  // Reflection of (10, 10) about (10, 0)
+	}
+
+	// Without a preceding cubic, S uses the current point
+	Parsed alone = Parse("M0 0S10 10 20 0");
+	CHECK(alone.points.size() == 4 && Near(alone.points[1], 0, 0));
+}
+
+TEST_CASE(QuadraticsAreElevated) {
+	Parsed p = Parse("M0 0Q3 6 6 0T12 0");
+	CHECK(p.result.ok && p.points.size() == 7);
+	if (p.points.size() != 7) return;
+	CHECK(Near(p.points[1], 2, 4));
+	CHECK(Near(p.points[2], 4, 4));
+	CHECK(Near(p.points[3], 6, 0));
+	CHECK(Near(p.points[4], 8, -4));  // T reflects (3, 6) to (9, -6)
+	CHECK(Near(p.points[6], 12, 0));
+}
+
+TEST_CASE(DrawingAfterCloseOpensFigure) {
+	Parsed p = Parse("M1 1L5 1L5 5zL9 9");
+	CHECK(p.result.ok && p.points.size() == 5);
+	if (p.points.size() != 5) return;
+	CHECK(p.types[2] == Close(Svg::PointTypeLine));
+	CHECK(Near(p.points[3], 1, 1) && p.types[3] == Svg::PointTypeStart);
+	CHECK(Near(p.points[4], 9, 9));
+}
+
+TEST_CASE(ErrorsKeepEarlierPoints) {
+	Parsed p = Parse("M1 1L2 2L3 x");
+	CHECK(!p.result.ok);
+	CHECK(p.result.errorOffset == 11);
+	CHECK(p.points.size() == 2);
+
+	CHECK(!Parse("L1 1").result.ok);  // Must start with a moveto
+	CHECK(!Parse("Z").result.ok);
+	CHECK(!Parse("M1").result.ok);
+	CHECK(Parse("").result.ok && Parse("   ").points.empty());
+}
+
+TEST_CASE(RejectsNonFiniteNumbers) {
+	Parsed p = Parse("M0 -1e39L10 10L0 10z");
+	CHECK(!p.result.ok);
+	CHECK(p.result.errorOffset == 3);
+	CHECK(p.points.empty());
+
+	Parsed later = Parse("M0 0L1 1L1e39 0");
+	CHECK(!later.result.ok && later.points.size() == 2);
+	CHECK(Parse("M0 0L3.4e38 1").result.ok);
+}
+
+TEST_CASE(RejectsOverflowingCoordinates) {
+	// Each number fits a float but the relative sum does not
+	Parsed relative = Parse("M0 0h3e38 h3e38");
+	CHECK(!relative.result.ok);
+	CHECK(relative.result.errorOffset == 10);
+	CHECK(relative.points.size() == 2);
+
+	// The whole command goes, including a figure start it opened
+	Parsed reopened = Parse("M3e38 0L1 1zh3e38");
+	CHECK(!reopened.result.ok && reopened.points.size() == 2);
+
+	// Reflected control points and arcs overflow too
+	Parsed reflected = Parse("M3e38 0C0 0 -3e38 0 3e38 0S0 0 0 0");
+	CHECK(!reflected.result.ok && reflected.points.size() == 4);
+	CHECK(!Parse("M3e38 0a1 1 0 0 1 3e38 0").result.ok);
+}
+
+TEST_CASE(TruncationReportsRequiredSize) {
+	Svg::Point points[2];
+	uint8_t types[2];
+	Svg::ParseResult result = Svg::ParsePath("M0 0L1 1L2 2L3 3", points, types, 2);
+	CHECK(result.ok && result.truncated);
+	CHECK(result.count == 4);
+	CHECK(Near(points[1], 1, 1));
+}
+
+TEST_CASE(WideCharacters) {
+	Parsed narrow = Parse("M1 2c1 1 2 2 3 3");
+	Parsed wide = Parse(L"M1 2c1 1 2 2 3 3");
+	Parsed utf16 = Parse(u"M1 2c1 1 2 2 3 3");
+	CHECK(narrow.points.size() == 4 && wide.points.size() == 4 && utf16.points.size() == 4);
+	for (size_t i = 0; i < narrow.points.size() && i < wide.points.size() && i < utf16.points.size(); i++) {
+		CHECK(Near(wide.points[i], narrow.points[i].x, narrow.points[i].y));
+		CHECK(Near(utf16.points[i], narrow.points[i].x, narrow.points[i].y));
+	}
+}
+
+TEST_CASE(CompiledAtBuildTime) {
+	using Triangle = Svg::CompiledPath<"M0 0L10 0L5 8z">;
+	static_assert(Triangle::Count == 3);
+	static_assert(Triangle::Data.points[2].x == 5 && Triangle::Data.points[2].y == 8);
+	static_assert(Triangle::Data.types[2] == Close(Svg::PointTypeLine));
+	static_assert(Svg::CountPathPoints("M0 0A5 5 0 0 1 10 0") == 7);
+	static_assert(!Svg::ParsePath("M0 1e39", static_cast<Svg::Point*>(nullptr), nullptr, 0).ok);
+	CHECK(Triangle::Count == 3);
+}
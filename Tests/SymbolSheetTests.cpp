@@ -0,0 +1,101 @@
+#include "Check.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "SymbolSheet.h"
+
+namespace {
+
+	bool Near(Svg::Point point, float x, float y) {
+		return std::fabs(point.x - x) < 1e-4f && std::fabs(point.y - y) < 1e-4f;
+	}
+
+	// Copies text into a buffer of exactly its size, so reading past the end
+	// is caught by the sanitizer build
+	std::unique_ptr<char[]> ExactCopy(const std::string& text) {
+		std::unique_ptr<char[]> copy(new char[text.size()]);
+		memcpy(copy.get(), text.data(), text.size());
+		return copy;
+	}
+}
+
+TEST_CASE(IndexesSymbolsAndPaths) {
+	std::string svg =
+		"<?xml version=\"1.0\"?><svg>"
+		"<!-- <symbol id=\"commented\"><path d=\"M0 0L1 1\"/></symbol> -->"
+		"<symbol id='a' viewBox='0 0 24 24'><path d='M1 1L2 2'/><path d=\"M3 3L4 4\"/></symbol>"
+		"<symbol id=\"empty\"/>"
+		"<symbol id=\"a\"><path d=\"M9 9L9 10\"/></symbol>"
+		"</svg>";
+	SymbolSheet sheet;
+	CHECK(sheet.Index(svg.data(), svg.size()) == 3);
+	CHECK(sheet.Find("commented") < 0);
+	CHECK(sheet.Find("a") == 0);  // The first definition wins
+	CHECK(sheet.At(0).pathCount == 2);
+	CHECK(sheet.At(1).pathCount == 0);
+	CHECK(!sheet.GetPath("empty"));
+	CHECK(!sheet.GetPath("missing"));
+
+	const IconPath* path = sheet.GetPath("a");
+	CHECK(path && path->count == 4);
+	CHECK(path == sheet.GetPath(size_t(0)));  // Parsed once, then cached
+}
+
+TEST_CASE(EachPathStartsAtTheOrigin) {
+	// A leading relative moveto is absolute, even in a second <path>
+	std::string svg = "<symbol id=\"x\"><path d=\"m2 2h4v4z\"/><path d=\"m10 10h4\"/></symbol>";
+	SymbolSheet sheet;
+	sheet.Index(svg.data(), svg.size());
+	const IconPath* path = sheet.GetPath("x");
+	CHECK(path && path->count == 5);
+	if (!path || path->count != 5) return;
+	CHECK(Near(path->points[0], 2, 2));
+	CHECK(Near(path->points[3], 10, 10) && path->types[3] == Svg::PointTypeStart);
+	CHECK(Near(path->points[4], 14, 10));
+}
+
+TEST_CASE(ViewBoxFitsUniformlyAndCenters) {
+	std::string svg =
+		"<symbol id=\"wide\" viewBox=\"0 0 48 24\"><path d=\"M0 0L48 24\"/></symbol>"
+		"<symbol id=\"tall\" viewBox=\"10,10 12,24\"><path d=\"M10 10L22 34\"/></symbol>"
+		"<symbol id=\"bad\" viewBox=\"0 0 0 24\"><path d=\"M1 1L2 2\"/></symbol>"
+		"<symbol id=\"huge\" viewBox=\"0 0 1e39 24\"><path d=\"M1 1L2 2\"/></symbol>";
+	SymbolSheet sheet;
+	sheet.Index(svg.data(), svg.size());
+
+	const IconPath* wide = sheet.GetPath("wide");
+	CHECK(wide && Near(wide->points[0], 0, 6) && Near(wide->points[1], 24, 18));
+
+	const IconPath* tall = sheet.GetPath("tall");
+	CHECK(tall && Near(tall->points[0], 6, 0) && Near(tall->points[1], 18, 24));
+
+	// Unusable viewBoxes fall back to 0 0 24 24
+	const IconPath* bad = sheet.GetPath("bad");
+	CHECK(bad && Near(bad->points[0], 1, 1));
+	const IconPath* huge = sheet.GetPath("huge");
+	CHECK(huge && Near(huge->points[1], 2, 2));
+}
+
+TEST_CASE(MalformedPathKeepsPointsBeforeTheError) {
+	std::string svg = "<symbol id=\"x\"><path d=\"M1 1L2 2L3\"/><path d=\"L5 5\"/></symbol>";
+	SymbolSheet sheet;
+	sheet.Index(svg.data(), svg.size());
+	const IconPath* path = sheet.GetPath("x");
+	CHECK(path && path->count == 2);
+}
+
+TEST_CASE(TruncatedSheetsStayInBounds) {
+	std::string svg = "<svg><symbol id=\"x\" viewBox=\"0 0 24 24\"><path d=\"M1 1L2 2\"/></symbol></svg>";
+	for (size_t length = 0; length <= svg.size(); length++) {
+		std::string prefix = svg.substr(0, length);
+		std::unique_ptr<char[]> data = ExactCopy(prefix);
+		SymbolSheet sheet;
+		size_t count = sheet.Index(data.get(), length);
+		for (size_t i = 0; i < count; i++) {
+			sheet.GetPath(i);
+		}
+	}
+}
@@ -0,0 +1,132 @@
+#include "Check.h"
+
+#include <random>
+#include <vector>
+
+#include "TabHibernation.h"
+
+namespace {
+
+	// Tab i was last active at i * 100 ms
+	std::vector<TabActivity> Tabs(int count) {
+		std::vector<TabActivity> tabs(count);
+		for (int i = 0; i < count; i++) {
+			tabs[i].lastActive = static_cast<uint64_t>(i) * 100;
+		}
+		return tabs;
+	}
+
+	bool Is(const HibernationAction& action, HibernationAction::Kind kind, int tab) {
+		return action.kind == kind && action.tab == tab;
+	}
+}
+
+TEST_CASE(DiscardsLeastRecentlyUsedOverCount) {
+	HibernationConfig config;
+	config.suspendAfter = 1000;
+	config.maxLiveTabs = 4;
+	HibernationPolicy policy(config);
+
+	std::vector<TabActivity> tabs = Tabs(6);
+	tabs[5].visible = true;
+	tabs[0].keepAwake = true;  // Oldest, but playing audio
+	std::vector<HibernationAction> actions = policy.Evaluate(tabs, 600);
+	CHECK(actions.size() == 2);
+	if (actions.size() == 2) {
+		CHECK(Is(actions[0], HibernationAction::Discard, 1));
+		CHECK(Is(actions[1], HibernationAction::Discard, 2));
+	}
+
+	// Tabs already discarded don't count towards the limit
+	tabs[1].sleep = tabs[2].sleep = TabSleep::Discarded;
+	CHECK(policy.Evaluate(tabs, 600).empty());
+}
+
+TEST_CASE(SuspendsIdleTabs) {
+	HibernationConfig config;
+	config.suspendAfter = 1000;
+	config.maxLiveTabs = 0;
+	HibernationPolicy policy(config);
+
+	std::vector<TabActivity> tabs = Tabs(4);
+	tabs[0].visible = true;
+	tabs[2].sleep = TabSleep::Suspended;
+	std::vector<HibernationAction> actions = policy.Evaluate(tabs, 1250);
+	CHECK(actions.size() == 1 && Is(actions[0], HibernationAction::Suspend, 1));
+
+	// A clock behind lastActive suspends nothing
+	CHECK(policy.Evaluate(tabs, 50).empty());
+}
+
+TEST_CASE(MemoryBudget) {
+	HibernationConfig config;
+	config.suspendAfter = 1000000;
+	config.maxLiveTabs = 0;
+	config.memoryBudget = 1000;
+	HibernationPolicy policy(config);
+
+	std::vector<TabActivity> tabs = Tabs(4);
+	tabs[0].memory = 100;
+	tabs[1].memory = 700;
+	tabs[2].memory = 300;
+	tabs[3].memory = 400;
+	tabs[3].visible = true;
+	std::vector<HibernationAction> actions = policy.Evaluate(tabs, 500);
+	CHECK(actions.size() == 2);
+	if (actions.size() == 2) {
+		CHECK(Is(actions[0], HibernationAction::Discard, 0));
+		CHECK(Is(actions[1], HibernationAction::Discard, 1));
+	}
+
+	// The visible tab alone over budget is left alone
+	tabs[3].memory = 5000;
+	tabs[0].sleep = tabs[1].sleep = tabs[2].sleep = TabSleep::Discarded;
+	CHECK(policy.Evaluate(tabs, 500).empty());
+}
+
+TEST_CASE(SimulatedBrowsingStaysWithinLimits) {
+	HibernationConfig config;
+	config.suspendAfter = 1000;
+	config.maxLiveTabs = 10;
+	config.memoryBudget = 8 * 200;
+	HibernationPolicy policy(config);
+
+	std::mt19937 random(2);
+	std::vector<TabActivity> tabs(60);
+	int current = 0;
+	tabs[current].visible = true;
+	uint64_t now = 0;
+	bool withinLimits = true, validActions = true;
+	for (int step = 0; step < 5000; step++) {
+		now += 100;
+		if (random() % 5 == 0) {
+			tabs[current].visible = false;
+			tabs[current].lastActive = now;
+			current = random() % 4 == 0 ? static_cast<int>(random() % 60) : (current + 1) % 60;
+			tabs[current] = { TabSleep::Awake, now, 0, true, false };
+		}
+		for (TabActivity& tab : tabs) {
+			tab.memory = tab.sleep == TabSleep::Discarded ? 0 : 200;
+		}
+
+		for (const HibernationAction& action : policy.Evaluate(tabs, now)) {
+			TabActivity& tab = tabs[action.tab];
+			validActions = validActions && !tab.visible && tab.sleep != TabSleep::Discarded;
+			if (action.kind == HibernationAction::Suspend) {
+				validActions = validActions && tab.sleep == TabSleep::Awake;
+				tab.sleep = TabSleep::Suspended;
+			}
+			else {
+				tab.sleep = TabSleep::Discarded;
+			}
+		}
+
+		int live = 0;
+		for (const TabActivity& tab : tabs) {
+			live += tab.sleep != TabSleep::Discarded;
+		}
+		withinLimits = withinLimits && live <= 8;
+	}
+	CHECK(validActions);
+	CHECK(withinLimits);
+}
@@ -0,0 +1,179 @@
+#include "Check.h"
+
+#include <cwctype>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "TabSearchIndex.h"
+
+namespace {
+
+	const wchar_t* const WORDS[] = {
+		L"Rust", L"compiler", L"GitHub", L"pull", L"request", L"news", L"weather", L"Berlin", L"recipe",
+		L"pasta", L"video", L"music", L"docs", L"Reference", L"Stack", L"Overflow", L"question", L"python",
+		L"release", L"notes", L"Wiki", L"Linux", L"kernel", L"Über", L"café", L"map"
+	};
+	const wchar_t* const HOSTS[] = {
+		L"github.com", L"news.ycombinator.com", L"en.wikipedia.org", L"stackoverflow.com", L"docs.rs", L"example.org"
+	};
+
+	std::wstring RandomTitle(std::mt19937& random) {
+		std::wstring title;
+		int count = 2 + random() % 6;
+		for (int i = 0; i < count; i++) {
+			if (i) title += L' ';
+			title += WORDS[random() % std::size(WORDS)];
+		}
+		return title + L" " + std::to_wstring(random() % 100000);
+	}
+
+	std::wstring RandomUrl(std::mt19937& random) {
+		return std::wstring(L"https://") + HOSTS[random() % std::size(HOSTS)] + L"/" + WORDS[random() % std::size(WORDS)] +
+			L"/" + std::to_wstring(random() % 1000000);
+	}
+
+	std::wstring Lower(std::wstring text) {
+		for (wchar_t& c : text) c = static_cast<wchar_t>(std::towlower(static_cast<wint_t>(c)));
+		return text;
+	}
+
+	struct Text {
+		std::wstring title;
+		std::wstring url;
+	};
+
+	// Every tab whose title or URL contains all the terms, by scanning. A
+	// query without terms matches nothing.
+	std::set<uint32_t> BruteForce(const std::map<uint32_t, Text>& tabs, const std::wstring& query) {
+		std::vector<std::wstring> terms;
+		std::wstring folded = Lower(query);
+		for (size_t start = 0; start < folded.size();) {
+			size_t end = folded.find(L' ', start);
+			if (end == std::wstring::npos) end = folded.size();
+			if (end > start) terms.push_back(folded.substr(start, end - start));
+			start = end + 1;
+		}
+
+		std::set<uint32_t> matches;
+		if (terms.empty()) {
+			return matches;
+		}
+		for (const auto& [tab, text] : tabs) {
+			bool all = true;
+			for (const std::wstring& term : terms) {
+				all = all && (Lower(text.title).find(term) != std::wstring::npos || Lower(text.url).find(term) != std::wstring::npos);
+			}
+			if (all) matches.insert(tab);
+		}
+		return matches;
+	}
+
+	std::vector<uint32_t> Tabs(const std::vector<TabSearchResult>& results) {
+		std::vector<uint32_t> tabs;
+		for (const TabSearchResult& result : results) tabs.push_back(result.tab);
+		return tabs;
+	}
+}
+
+TEST_CASE(FindsAndRanks) {
+	TabSearchIndex index;
+	index.Update(1, L"Some page about things", L"https://rust-lang.org/");
+	index.Update(2, L"The Rust Book", L"https://doc.rust-lang.org/book");
+	index.Update(3, L"Trusty tools", L"https://example.com/");
+
+	// Title word start, then inside a title word, then only the URL
+	CHECK((Tabs(index.Search(L"rust", 10)) == std::vector<uint32_t>{ 2, 3, 1 }));
+	CHECK((Tabs(index.Search(L"RUST book", 10)) == std::vector<uint32_t>{ 2 }));
+	CHECK((Tabs(index.Search(L"rust", 1)) == std::vector<uint32_t>{ 2 }));
+	CHECK(index.Search(L"python", 10).empty());
+
+	// Queries shorter than a trigram
+	std::vector<uint32_t> single = Tabs(index.Search(L"t", 10));
+	CHECK(single.size() == 3 && single.back() == 1);
+	CHECK((Tabs(index.Search(L"bo", 10)) == std::vector<uint32_t>{ 2, 1 }));
+	CHECK(index.Search(L"  ", 10).empty());
+}
+
+TEST_CASE(UpdateReplacesText) {
+	TabSearchIndex index;
+	index.Update(7, L"Weather in Berlin", L"https://example.org/weather");
+	CHECK(index.Search(L"berlin", 10).size() == 1);
+
+	index.Update(7, L"Pasta recipe", L"https://example.org/pasta");
+	CHECK(index.Search(L"berlin", 10).empty() && index.Search(L"weather", 10).empty());
+	CHECK((Tabs(index.Search(L"pasta", 10)) == std::vector<uint32_t>{ 7 }));
+	CHECK(index.Size() == 1);
+
+	// Same text again changes nothing
+	size_t postings = index.PostingCount();
+	index.Update(7, L"Pasta recipe", L"https://example.org/pasta");
+	CHECK(index.PostingCount() == postings);
+}
+
+TEST_CASE(RemoveDropsPostings) {
+	TabSearchIndex index;
+	index.Update(1, L"GitHub pull request", L"https://github.com/");
+	index.Update(2, L"Linux kernel notes", L"https://docs.rs/");
+	index.Remove(1);
+	index.Remove(1);
+	index.Remove(99);
+	CHECK(index.Size() == 1);
+	CHECK(index.Search(L"github", 10).empty());
+	CHECK((Tabs(index.Search(L"kernel", 10)) == std::vector<uint32_t>{ 2 }));
+
+	index.Remove(2);
+	CHECK(index.Size() == 0 && index.PostingCount() == 0);
+	CHECK(index.Search(L"k", 10).empty());
+}
+
+TEST_CASE(MatchesBruteForce) {
+	std::mt19937 random(11);
+	TabSearchIndex index;
+	std::map<uint32_t, Text> tabs;
+	const std::wstring queries[] = {
+		L"gith", L"ru", L"PULL req", L"wiki linux", L"café", L"über", L"zzz", L"a", L"o 1", L"docs.rs/py", L"  ", L"https"
+	};
+
+	bool same = true, ordered = true, limited = true;
+	for (int step = 0; step < 3000; step++) {
+		uint32_t tab = random() % 300;
+		if (random() % 4) {
+			Text text = { RandomTitle(random), RandomUrl(random) };
+			index.Update(tab, text.title, text.url);
+			tabs[tab] = text;
+		}
+		else {
+			index.Remove(tab);
+			tabs.erase(tab);
+		}
+
+		if (step % 100 != 0) continue;
+		for (const std::wstring& query : queries) {
+			std::vector<TabSearchResult> all = index.Search(query, 10000);
+			std::vector<uint32_t> found = Tabs(all);
+			same = same && std::set<uint32_t>(found.begin(), found.end()) == BruteForce(tabs, query) && found.size() == std::set<uint32_t>(found.begin(), found.end()).size();
+			for (size_t i = 1; i < all.size(); i++) {
+				ordered = ordered && all[i - 1].score >= all[i].score;
+			}
+
+			// A limit returns the head of the full ranking
+			std::vector<TabSearchResult> top = index.Search(query, 5);
+			limited = limited && top.size() == (all.size() < 5 ? all.size() : 5);
+			for (size_t i = 0; i < top.size() && i < all.size(); i++) {
+				limited = limited && top[i].tab == all[i].tab && top[i].score == all[i].score;
+			}
+		}
+	}
+	CHECK(same);
+	CHECK(ordered);
+	CHECK(limited);
+	CHECK(index.Size() == tabs.size());
+
+	for (const auto& [tab, text] : tabs) {
+		index.Remove(tab);
+	}
+	CHECK(index.PostingCount() == 0);
+}
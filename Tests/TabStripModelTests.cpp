@@ -0,0 +1,140 @@
+#include "Check.h"
+
+#include <random>
+#include <vector>
+
+#include "TabStripModel.h"
+
+namespace {
+
+	// Reference strip: tab ids and widths in order
+	struct Tab {
+		int id;
+		int width;
+	};
+
+	bool Matches(const TabStripModel& model, const std::vector<Tab>& reference) {
+		if (model.Count() != static_cast<int>(reference.size())) {
+			return false;
+		}
+		int offset = 0;
+		for (int i = 0; i < static_cast<int>(reference.size()); i++) {
+			const Tab& tab = reference[i];
+			if (model.Offset(i) != offset || model.Width(i) != tab.width) return false;
+			if (model.IdAt(i) != tab.id || model.Position(tab.id) != i) return false;
+			if (tab.width > 0 && (model.HitTest(offset) != i || model.HitTest(offset + tab.width - 1) != i)) return false;
+			offset += tab.width;
+		}
+		return model.TotalWidth() == offset && model.HitTest(offset) == -1 && model.HitTest(-1) == -1;
+	}
+
+	TabStripModel Uniform(int count, int width) {
+		TabStripModel model;
+		for (int i = 0; i < count; i++) {
+			model.Insert(i, width);
+		}
+		return model;
+	}
+}
+
+TEST_CASE(OffsetsAndHitTesting) {
+	TabStripModel model;
+	model.Insert(0, 100);
+	model.Insert(1, 50);
+	model.Insert(1, 30);  // 100, 30, 50
+	CHECK(model.Count() == 3 && model.TotalWidth() == 180);
+	CHECK(model.Offset(0) == 0 && model.Offset(1) == 100 && model.Offset(2) == 130);
+	CHECK(model.Offset(3) == 180);
+	CHECK(model.HitTest(99) == 0 && model.HitTest(100) == 1 && model.HitTest(129) == 1 && model.HitTest(130) == 2);
+	CHECK(model.HitTest(180) == -1 && model.HitTest(-1) == -1);
+
+	model.SetWidth(1, 10);
+	CHECK(model.Offset(2) == 110 && model.HitTest(115) == 2);
+	model.Erase(0);
+	CHECK(model.Width(0) == 10 && model.Offset(1) == 10 && model.TotalWidth() == 60);
+
+	// Out of range positions are ignored
+	model.Erase(5);
+	model.SetWidth(-1, 99);
+	CHECK(model.Count() == 2 && model.Width(7) == 0 && model.IdAt(2) == -1);
+}
+
+TEST_CASE(IdsFollowTabs) {
+	TabStripModel model;
+	int a = model.Insert(0, 10);
+	int b = model.Insert(1, 10);
+	int c = model.Insert(0, 10);  // c, a, b
+	CHECK(model.Position(c) == 0 && model.Position(a) == 1 && model.Position(b) == 2);
+
+	model.Erase(1);
+	CHECK(model.Position(c) == 0 && model.Position(b) == 1);
+	int d = model.Insert(2, 10);
+	CHECK(d == a);  // Reused
+	CHECK(model.IdAt(2) == d && model.Position(d) == 2);
+}
+
+TEST_CASE(MatchesReferenceUnderRandomEdits) {
+	std::mt19937 random(3);
+	TabStripModel model;
+	std::vector<Tab> reference;
+	bool matches = true;
+	for (int step = 0; step < 20000; step++) {
+		int op = static_cast<int>(random() % 4);
+		if (op <= 1 || reference.empty()) {
+			int position = static_cast<int>(random() % (reference.size() + 1));
+			int width = 1 + static_cast<int>(random() % 200);
+			int id = model.Insert(position, width);
+			reference.insert(reference.begin() + position, { id, width });
+		}
+		else if (op == 2) {
+			int position = static_cast<int>(random() % reference.size());
+			model.Erase(position);
+			reference.erase(reference.begin() + position);
+		}
+		else {
+			int position = static_cast<int>(random() % reference.size());
+			int width = static_cast<int>(random() % 200);  // Zero-width tabs too
+			model.SetWidth(position, width);
+			reference[position].width = width;
+		}
+		if (step % 250 == 0) {
+			matches = matches && Matches(model, reference);
+		}
+	}
+	CHECK(matches && Matches(model, reference));
+
+	model.ResetWidths(40);
+	for (Tab& tab : reference) tab.width = 40;
+	CHECK(Matches(model, reference));
+}
+
+TEST_CASE(Scrolling) {
+	TabStripModel model = Uniform(100, 50);
+	CHECK(model.TotalWidth() == 5000);
+	CHECK(model.ScrollIntoView(99, 400) && model.Scroll() == 4600);
+	CHECK(model.ScrollIntoView(3, 400) && model.Scroll() == 150);
+	CHECK(!model.ScrollIntoView(4, 400));
+	model.SetScroll(99999, 400);
+	CHECK(model.Scroll() == 4600);
+	model.SetScroll(-5, 400);
+	CHECK(model.Scroll() == 0);
+
+	// A view wider than the strip pins scroll to zero
+	TabStripModel few = Uniform(3, 50);
+	CHECK(!few.SetScroll(20, 400) && few.Scroll() == 0);
+}
+
+TEST_CASE(ManyTabs) {
+	// Positions from ids stay right when tabs at the front come and go
+	TabStripModel model;
+	std::vector<int> ids;
+	for (int i = 0; i < 10000; i++) {
+		ids.push_back(model.Insert(i, 216));
+	}
+	for (int i = 0; i < 100; i++) {
+		model.Erase(0);
+	}
+	CHECK(model.Position(ids[100]) == 0 && model.Position(ids[9999]) == 9899);
+	CHECK(model.Offset(9899) == 9899 * 216);
+	CHECK(model.HitTest(9899 * 216 + 5) == 9899);
+}
@@ -0,0 +1,24 @@
+#include "Check.h"
+
+#include <cstring>
+
+int main(int argc, char** argv) {
+	int run = 0;
+	for (const Check::Case& test : Check::Cases()) {
+		bool selected = argc < 2;
+		for (int i = 1; i < argc && !selected; i++) {
+			selected = strcmp(argv[i], test.name) == 0;
+		}
+		if (!selected) {
+			continue;
+		}
+
+		int failuresBefore = Check::Failures();
+		test.run();
+		printf("%s %s\n", Check::Failures() == failuresBefore ? "[  OK  ]" : "[ FAIL ]", test.name);
+		run++;
+	}
+
+	printf("%d cases, %d failed checks\n", run, Check::Failures());
+	return Check::Failures() == 0 && run > 0 ? 0 : 1;
+}
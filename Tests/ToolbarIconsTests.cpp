@@ -0,0 +1,64 @@
+#include "Check.h"
+
+#include <cmath>
+#include <string>
+
+#include "SymbolSheet.h"
+#include "ToolbarIcons.h"
+
+namespace {
+
+	template <typename Icon>
+	IconPath Compiled() {
+		return { Icon::Data.points, Icon::Data.types, static_cast<int>(Icon::Count) };
+	}
+
+	// Arcs are converted with the constexpr math at build time and with the
+	// C library at run time, so points may differ in the last bits
+	bool SameGeometry(const IconPath& a, const IconPath& b) {
+		if (a.count != b.count) {
+			return false;
+		}
+		for (int i = 0; i < a.count; i++) {
+			if (a.types[i] != b.types[i] || std::fabs(a.points[i].x - b.points[i].x) > 1e-3f ||
+				std::fabs(a.points[i].y - b.points[i].y) > 1e-3f) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+TEST_CASE(CompiledIconsAreWellFormed) {
+	for (IconPath icon : { Compiled<ToolbarIcons::Back>(), Compiled<ToolbarIcons::Forward>(),
+		Compiled<ToolbarIcons::Refresh>(), Compiled<ToolbarIcons::Home>(), Compiled<ToolbarIcons::Bookmark>() }) {
+		CHECK(icon.count > 0);
+		CHECK(icon.count > 0 && icon.types[0] == Svg::PointTypeStart);
+		for (int i = 0; i < icon.count; i++) {
+			CHECK(icon.points[i].x >= 0 && icon.points[i].x <= 24);
+			CHECK(icon.points[i].y >= 0 && icon.points[i].y <= 24);
+		}
+	}
+}
+
+TEST_CASE(CompiledIconsMatchSymbolSheet) {
+	std::string svg = Check::ReadSourceFile("DingusBrowser/Icons.svg");
+	CHECK(!svg.empty());
+	SymbolSheet sheet;
+	sheet.Index(svg.data(), svg.size());
+
+	struct {
+		const char* id;
+		IconPath compiled;
+	} icons[] = {
+		{ "icon-back", Compiled<ToolbarIcons::Back>() },
+		{ "icon-forward", Compiled<ToolbarIcons::Forward>() },
+		{ "icon-refresh", Compiled<ToolbarIcons::Refresh>() },
+		{ "icon-home", Compiled<ToolbarIcons::Home>() },
+		{ "icon-bookmark", Compiled<ToolbarIcons::Bookmark>() },
+	};
+	for (const auto& icon : icons) {
+		const IconPath* fromSheet = sheet.GetPath(icon.id);
+		CHECK(fromSheet && SameGeometry(*fromSheet, icon.compiled));
+	}
+}
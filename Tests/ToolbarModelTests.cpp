@@ -0,0 +1,96 @@
+#include "Check.h"
+
+#include <vector>
+
+#include "ToolbarModel.h"
+
+namespace {
+
+	// Four 28 pixel buttons with 2 pixel gaps, as the toolbar lays them out
+	ToolbarModel MakeToolbar() {
+		ToolbarModel model;
+		for (int i = 0; i < 4; i++) {
+			model.AddButton(1001 + i, { i * 30, 0, i * 30 + 28, 30 });
+		}
+		return model;
+	}
+
+	std::vector<ToolbarRect> Flush(ToolbarModel& model) {
+		std::vector<ToolbarRect> damage;
+		model.FlushDamage([&](const ToolbarRect& rect) { damage.push_back(rect); });
+		return damage;
+	}
+}
+
+TEST_CASE(HitTest) {
+	ToolbarModel model = MakeToolbar();
+	CHECK(model.HitTest(0, 0) == 0);
+	CHECK(model.HitTest(27, 29) == 0);
+	CHECK(model.HitTest(28, 10) == -1);  // Gap
+	CHECK(model.HitTest(30, 10) == 1);
+	CHECK(model.HitTest(100, 10) == 3);
+	CHECK(model.HitTest(10, 30) == -1);
+	CHECK(model.HitTest(120, 10) == -1);
+}
+
+TEST_CASE(HoverDamagesOnlyChangedButtons) {
+	ToolbarModel model = MakeToolbar();
+	CHECK(model.SetHovered(1));
+	std::vector<ToolbarRect> damage = Flush(model);
+	CHECK(damage.size() == 1 && damage[0].left == 30);
+
+	// Moving within the same button changes nothing
+	CHECK(!model.SetHovered(model.HitTest(40, 5)));
+	CHECK(Flush(model).empty());
+
+	// Moving across damages the button left and the one entered
+	CHECK(model.SetHovered(2));
+	damage = Flush(model);
+	CHECK(damage.size() == 2 && damage[0].left == 30 && damage[1].left == 60);
+
+	CHECK(model.SetHovered(-1));
+	CHECK(Flush(model).size() == 1);
+	CHECK(!model.SetHovered(7));  // Out of range means none
+}
+
+TEST_CASE(SweepAcrossBar) {
+	// A pointer sweeping the bar enters and leaves each button once
+	ToolbarModel model = MakeToolbar();
+	int invalidations = 0;
+	for (int x = 0; x < 130; x++) {
+		if (model.SetHovered(model.HitTest(x, 10))) {
+			invalidations += static_cast<int>(Flush(model).size());
+		}
+	}
+	model.SetHovered(-1);
+	invalidations += static_cast<int>(Flush(model).size());
+	CHECK(invalidations == 8);
+	CHECK(model.GetStats().hoverChanges == 8);
+	CHECK(model.GetStats().damagedButtons == 8);
+}
+
+TEST_CASE(DamageIsCoalesced) {
+	ToolbarModel model = MakeToolbar();
+	model.Invalidate(2);
+	model.SetHovered(2);
+	model.InvalidateAll();
+	CHECK(Flush(model).size() == 4);
+	CHECK(model.GetStats().damagedButtons == 4);
+	CHECK(Flush(model).empty());
+}
+
+TEST_CASE(ResetForgetsLayout) {
+	// What SyncToolbarModel does after the toolbar is resized
+	ToolbarModel model = MakeToolbar();
+	model.SetHovered(3);
+	Flush(model);
+	int hovered = model.Hovered();
+	model.Reset();
+	CHECK(model.Count() == 0 && model.Hovered() == -1 && Flush(model).empty());
+
+	model.AddButton(1001, { 0, 0, 28, 30 });
+	model.AddButton(1002, { 30, 0, 58, 30 });
+	CHECK(!model.SetHovered(hovered));  // The hovered button was clipped away
+	CHECK(model.Hovered() == -1);
+	CHECK(model.At(1).commandId == 1002);
+}
@@ -0,0 +1,49 @@
+#include "Check.h"
+
+#include "UiMetrics.h"
+
+TEST_CASE(ScalesAndRounds) {
+	UiMetrics base;
+	UiMetrics same = ScaleUiMetrics(base, 96);
+	CHECK(same.toolbarHeight == 30 && same.iconSize == 20 && same.fontHeight == -14);
+
+	// 125%: 2.5 rounds up, negative font heights scale by magnitude
+	UiMetrics large = ScaleUiMetrics(base, 120);
+	CHECK(large.dpi == 120);
+	CHECK(large.toolbarHeight == 38 && large.iconSize == 25 && large.padding == 10);
+	CHECK(large.fontHeight == -18 && large.tabUnderline == 3);
+
+	UiMetrics doubled = ScaleUiMetrics(base, 192);
+	CHECK(doubled.maxTabTitleWidth == 400 && doubled.tabSeparatorInset == 8 && doubled.urlBarRadius == 8);
+}
+
+TEST_CASE(NonZeroSizesKeepAPixel) {
+	UiMetrics base;
+	base.tabUnderline = 1;
+	base.urlBarRadius = 0;
+	UiMetrics tiny = ScaleUiMetrics(base, 24);
+	CHECK(tiny.tabUnderline == 1 && tiny.urlBarRadius == 0);
+	CHECK(tiny.fontHeight == -4 && tiny.padding == 2);
+
+	// Tables scale from their own DPI
+	UiMetrics from144 = ScaleUiMetrics(ScaleUiMetrics(base, 144), 96);
+	CHECK(from144.toolbarHeight == 30 && from144.iconSize == 20);
+}
+
+TEST_CASE(CacheBuildsEachDpiOnce) {
+	UiMetricsCache cache;
+	const UiMetrics& at144 = cache.Get(144);
+	CHECK(at144.dpi == 144 && at144.toolbarHeight == 45);
+	CHECK(&cache.Get(144) == &at144);
+	CHECK(cache.Count() == 1);
+
+	// References stay valid as more tables are added
+	for (int dpi = 97; dpi < 200; dpi++) {
+		cache.Get(dpi);
+	}
+	CHECK(&cache.Get(144) == &at144 && at144.toolbarHeight == 45);
+	CHECK(cache.Count() == 103);
+
+	// An unknown DPI falls back to the base table
+	CHECK(cache.Get(0).dpi == 96 && cache.Get(-1).toolbarHeight == 30);
+}
@@ -0,0 +1,39 @@
+#include "Check.h"
+
+#include "UrlInput.h"
+
+namespace {
+
+	bool Resolves(const wchar_t* text, UrlInput::Kind kind, const wchar_t* url) {
+		UrlInput::Resolved resolved = UrlInput::Resolve(text);
+		return resolved.kind == kind && resolved.url == url;
+	}
+}
+
+TEST_CASE(SchemesPassThrough) {
+	CHECK(Resolves(L"https://example.com/a b", UrlInput::Kind::Url, L"https://example.com/a b"));
+	CHECK(Resolves(L"ftp://host", UrlInput::Kind::Url, L"ftp://host"));
+	CHECK(Resolves(L"  http://x.y", UrlInput::Kind::Url, L"  http://x.y"));
+}
+
+TEST_CASE(LocalHostsGetHttp) {
+	CHECK(Resolves(L"localhost:8080/x", UrlInput::Kind::Local, L"http://localhost:8080/x"));
+	CHECK(Resolves(L"127.0.0.1", UrlInput::Kind::Local, L"http://127.0.0.1"));
+}
+
+TEST_CASE(PathsGetFileScheme) {
+	CHECK(Resolves(L"/tmp/page.html", UrlInput::Kind::File, L"file:////tmp/page.html"));
+	CHECK(Resolves(L"C:\\page.html", UrlInput::Kind::File, L"file:///C:\\page.html"));
+}
+
+TEST_CASE(HostsGetHttps) {
+	CHECK(Resolves(L"www.example.com", UrlInput::Kind::Web, L"https://www.example.com"));
+	CHECK(Resolves(L"example.com", UrlInput::Kind::Web, L"https://www.example.com"));
+	CHECK(Resolves(L" \texample.com\t ", UrlInput::Kind::Web, L"https://www.example.com"));
+}
+
+TEST_CASE(EverythingElseSearches) {
+	CHECK(Resolves(L"weather", UrlInput::Kind::Search, L"https://www.google.com/search?q=weather"));
+	CHECK(Resolves(L" two words ", UrlInput::Kind::Search, L"https://www.google.com/search?q= two words "));
+	CHECK(Resolves(L"", UrlInput::Kind::Search, L"https://www.google.com/search?q="));
+}
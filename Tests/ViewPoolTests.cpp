@@ -0,0 +1,113 @@
+#include "Check.h"
+
+#include <vector>
+
+#include "FakeViewEngine.h"
+#include "ViewPool.h"
+
+TEST_CASE(WarmViewIsHandedOutAtOnce) {
+	FakeViewEngine engine;
+	ViewPool<int> pool(engine, 1);
+	pool.Refill();
+	CHECK(pool.PendingCount() == 1);
+	engine.Step(5);
+	CHECK(pool.ReadyCount() == 1 && pool.PendingCount() == 0);
+
+	int view = 0;
+	pool.Acquire([&](bool succeeded, int v) { view = succeeded ? v : -1; });
+	CHECK(view == 1);
+	CHECK(pool.Stats().warmHits == 1);
+
+	// The pool tops itself back up in the background
+	CHECK(pool.PendingCount() == 1);
+	engine.Step(5);
+	CHECK(pool.ReadyCount() == 1);
+}
+
+TEST_CASE(ColdAcquireWaitsForTheFirstView) {
+	FakeViewEngine engine;
+	ViewPool<int> pool(engine, 1);
+	pool.Refill();
+	engine.Step(2);
+
+	// The view already on its way serves the waiter, not a new one
+	int at = -1;
+	pool.Acquire([&](bool succeeded, int) { at = succeeded ? engine.Now() : -1; });
+	CHECK(at == -1 && pool.WaiterCount() == 1 && pool.PendingCount() == 2);
+	engine.Step(3);
+	CHECK(at == 5);
+	CHECK(pool.Stats().warmHits == 0);
+}
+
+TEST_CASE(BurstsAreServedInOrder) {
+	FakeViewEngine engine;
+	ViewPool<int> pool(engine, 2);
+	std::vector<int> served;
+	for (int i = 0; i < 5; i++) {
+		pool.Acquire([&served, i](bool succeeded, int) { if (succeeded) served.push_back(i); });
+	}
+	CHECK(pool.PendingCount() == 7);
+	engine.Step(5);
+	CHECK((served == std::vector<int>{ 0, 1, 2, 3, 4 }));
+	CHECK(pool.ReadyCount() == 2 && pool.WaiterCount() == 0);
+	CHECK(pool.Stats().created == 7 && pool.Stats().acquires == 5);
+}
+
+TEST_CASE(RecycleKeepsOrDestroys) {
+	FakeViewEngine engine;
+	engine.synchronous = true;
+	ViewPool<int> pool(engine, 1);
+
+	int view = 0;
+	pool.Acquire([&](bool, int v) { view = v; });
+	CHECK(pool.ReadyCount() == 1 && engine.live == 2);
+
+	// The pool is already full, so the unused view is destroyed
+	pool.Recycle(view);
+	CHECK(pool.ReadyCount() == 1 && engine.live == 1);
+
+	pool.Acquire([&](bool, int v) { view = v; });
+	pool.Acquire([&](bool, int) {});
+	CHECK(engine.live == 3);
+}
+
+TEST_CASE(FailuresFailTheOldestWaiter) {
+	FakeViewEngine engine;
+	engine.failing = true;
+	ViewPool<int> pool(engine, 0);
+	int first = 0, second = 0;
+	pool.Acquire([&](bool succeeded, int) { first = succeeded ? 1 : -1; });
+	pool.Acquire([&](bool succeeded, int) { second = succeeded ? 1 : -1; });
+	engine.Step(5);
+	CHECK(first == -1 && second == -1);
+	CHECK(pool.Stats().failures == 2 && pool.PendingCount() == 0);
+
+	// No retry until the next Acquire
+	engine.Step(20);
+	CHECK(pool.PendingCount() == 0);
+	engine.failing = false;
+	pool.Acquire([&](bool succeeded, int) { first = succeeded ? 1 : -1; });
+	engine.Step(5);
+	CHECK(first == 1);
+}
+
+TEST_CASE(ClearDestroysEverything) {
+	FakeViewEngine engine;
+	{
+		ViewPool<int> pool(engine, 2);
+		pool.Refill();
+		engine.Step(5);
+		pool.Acquire([](bool, int) {});  // Starts a refill
+		int waited = 0;
+		pool.Acquire([&](bool, int) { waited++; });
+		CHECK(waited == 1);
+
+		pool.Clear();
+		CHECK(pool.ReadyCount() == 0 && pool.WaiterCount() == 0);
+		engine.Step(5);  // Late arrivals are destroyed
+		CHECK(engine.live == 2);  // Only the two handed out
+		pool.Refill();
+		CHECK(pool.PendingCount() == 0);
+	}
+	CHECK(engine.live == 2);
+}